@@ -169,6 +169,8 @@ mkldnn_status_t MKLDNN_API mkldnn_primitive_desc_destroy(
  *  - query an operation primitive descriptor for the number of inputs and
  *    outputs (#mkldnn_query_num_of_inputs_s32 and
  *    #mkldnn_query_num_of_outputs_s32 respectively)
+ *  - query an operation primitive descriptor for the analytic cost of one
+ *    execution (#mkldnn_query_flops_f64 and #mkldnn_query_bytes_f64)
  *
  * @sa mkldnn_query_t for more options
  */
@@ -246,6 +248,20 @@ mkldnn_status_t MKLDNN_API mkldnn_primitive_get_output(
         const_mkldnn_primitive_t primitive, size_t index,
         const_mkldnn_primitive_t *output);
 
+/** Executes a @p primitive synchronously on the calling thread, with the
+ * memory primitives of the @p nargs @p args reading and writing the bound
+ * data handles instead of their own.
+ *
+ * Neither the primitive nor the memory primitives are modified, so the same
+ * primitive may be executed concurrently from several threads on different
+ * buffers. The padding of the bound buffers (see
+ * @ref understanding_memory_formats) must be zero, as for a zero-initialized
+ * buffer or one written by a primitive, and is kept zero. The memory
+ * primitives that are not bound use their own data handles. */
+mkldnn_status_t MKLDNN_API mkldnn_primitive_execute(
+        mkldnn_primitive_t primitive, int nargs,
+        const mkldnn_exec_arg_t *args);
+
 /** Deletes a @p primitive. */
 mkldnn_status_t MKLDNN_API mkldnn_primitive_destroy(
         mkldnn_primitive_t primitive);
@@ -540,6 +556,15 @@ mkldnn_status_t MKLDNN_API mkldnn_memory_desc_init(
         mkldnn_memory_desc_t *memory_desc, int ndims, const mkldnn_dims_t dims,
         mkldnn_data_type_t data_type, mkldnn_memory_format_t format);
 
+/** Initializes a @p memory_desc memory descriptor of block-CSR weights
+ * (#mkldnn_bcsr_fmt) with blocks of @p oc_block x @p k_block elements.
+ * mkldnn_memory_desc_init() with #mkldnn_bcsr_fmt uses 1 x 1 blocks, which
+ * suit unstructured pruning; larger blocks pay off when the pruning zeroes
+ * whole blocks. Only #mkldnn_f32 is supported. */
+mkldnn_status_t MKLDNN_API mkldnn_bcsr_memory_desc_init(
+        mkldnn_memory_desc_t *memory_desc, int ndims, const mkldnn_dims_t dims,
+        mkldnn_data_type_t data_type, int oc_block, int k_block);
+
 /** Creates a @p memory_primitive_desc memory primitive descriptor using @p
  * memory_desc and @p engine. @p memory_desc cannot be uncertain, that is,
  * initialized with #mkldnn_any. */
@@ -637,6 +662,12 @@ mkldnn_status_t MKLDNN_API mkldnn_reorder_primitive_desc_create_v2(
  *
  * Order of outputs:
  *  - output (#mkldnn_query_output_pd, 0)
+ *
+ * The slot of input @p i in the output can be queried with
+ * (#mkldnn_query_src_image_pd, @p i). A memory primitive created with this
+ * descriptor on top of the output data handle lets a producer write input
+ * @p i directly into the output. The concat primitive does not copy such
+ * inputs, so if every input is produced this way its execution is a no-op.
  */
 mkldnn_status_t MKLDNN_API mkldnn_concat_primitive_desc_create(
         mkldnn_primitive_desc_t *concat_primitive_desc,
@@ -692,6 +723,9 @@ mkldnn_status_t MKLDNN_API mkldnn_concat_inplace_by_output_primitive_desc_create
  *
  * Order of outputs:
  *  - output (#mkldnn_query_output_pd, 0)
+ *
+ * The output may be the memory of input 0 if both have the same memory
+ * descriptor (in-place accumulation). Integer outputs are saturated.
  */
 mkldnn_status_t MKLDNN_API mkldnn_sum_primitive_desc_create(
         mkldnn_primitive_desc_t *sum_primitive_desc,
@@ -1418,6 +1452,32 @@ mkldnn_status_t MKLDNN_API mkldnn_batch_normalization_backward_desc_init(
         const mkldnn_memory_desc_t *data_desc,
         float epsilon, unsigned flags);
 
+/** Folds an inference batch normalization described by @p bnrm_desc into the
+ * @p weights and @p bias of the convolution or inner product that produces
+ * its src, so that the batch normalization primitive can be dropped.
+ *
+ * For each output channel oc the weights are scaled in-place by
+ * \f$s[oc] = \gamma[oc] / \sqrt{\sigma[oc] + eps}\f$ and the bias is
+ * replaced by \f$(bias[oc] - \mu[oc]) s[oc] + \beta[oc]\f$, where
+ * \f$\gamma, \beta\f$ are taken from @p scaleshift (may be NULL if
+ * #mkldnn_use_scaleshift is not set).
+ *
+ * @p bnrm_desc must be a #mkldnn_forward_inference descriptor with
+ * #mkldnn_use_global_stats set and #mkldnn_fuse_bn_relu not set. @p weights
+ * may be in any blocked f32 format, with or without groups (grouped weights
+ * have one more dimension than the data of @p bnrm_desc); its outermost
+ * dimension (or outermost two for grouped weights) must give the number of
+ * channels. @p bias, @p mean and @p variance are f32 memories in the
+ * #mkldnn_x format.
+ *
+ * @note Call this once, before the first execution of the convolution or
+ *       inner product; @p weights and @p bias are modified in-place. */
+mkldnn_status_t MKLDNN_API mkldnn_batch_normalization_fold(
+        const mkldnn_batch_normalization_desc_t *bnrm_desc,
+        mkldnn_primitive_t weights, mkldnn_primitive_t bias,
+        const_mkldnn_primitive_t mean, const_mkldnn_primitive_t variance,
+        const_mkldnn_primitive_t scaleshift);
+
 /** @} */
 
 /** @addtogroup c_api_inner_product Inner product
@@ -1704,6 +1764,63 @@ mkldnn_status_t MKLDNN_API mkldnn_stream_destroy(mkldnn_stream_t stream);
  *     Dumping information might affect performance */
 mkldnn_status_t MKLDNN_API mkldnn_verbose_set(int level);
 
+/** Sets the placement of the large buffers the library allocates (memory
+ * primitives created through the C++ API or mkldnn_malloc(), scratchpads
+ * and gemm workspaces): the huge page policy @p hugepages and the NUMA
+ * policy @p numa (for #mkldnn_numa_bind, on node @p node). Buffers
+ * allocated before the call keep their placement. The defaults come from
+ * the environment variables MKLDNN_HUGEPAGES (`none`, `thp` or `hugetlb`)
+ * and MKLDNN_NUMA (`default`, `interleave` or a node number).
+ *
+ * @note
+ *     Not thread safe: set the policy before creating primitives.
+ *     The policies are advice: they are ignored where the system does not
+ *     support them. */
+mkldnn_status_t MKLDNN_API mkldnn_memory_policy_set(
+        mkldnn_hugepages_policy_t hugepages, mkldnn_numa_policy_t numa,
+        int node);
+
+/** Allocates @p size bytes aligned on @p alignment (a power of 2) following
+ * the memory policy. Returns @c NULL on failure. The buffer must be
+ * released with mkldnn_free(). */
+void MKLDNN_API *mkldnn_malloc(size_t size, size_t alignment);
+
+/** Releases a buffer allocated with mkldnn_malloc(). */
+void MKLDNN_API mkldnn_free(void *ptr);
+
+/** @} */
+
+/** @addtogroup c_api_profiling Profiling
+ * A programmatic alternative to MKLDNN_VERBOSE: every primitive creation and
+ * execution produces a #mkldnn_profiling_record_t that is stored in a ring
+ * buffer and/or passed to a user callback. When profiling is disabled (the
+ * default) the only overhead is a flag check.
+ * @{ */
+
+/** Enables (if @p enable is non-zero) or disables profiling. Enabling
+ * profiling (re)allocates a ring buffer of @p capacity records (a default
+ * capacity is used if @p capacity is 0) which keeps the most recent
+ * records. Disabling profiling keeps the buffered records. */
+mkldnn_status_t MKLDNN_API mkldnn_profiling_enable(int enable,
+        size_t capacity);
+
+/** Sets a @p callback (with its @p user_data) to be called for every record
+ * while profiling is enabled. Passing @c NULL removes the callback. The
+ * callback may be called concurrently from several threads. */
+mkldnn_status_t MKLDNN_API mkldnn_profiling_set_callback(
+        mkldnn_profiling_callback_t callback, void *user_data);
+
+/** Moves up to @p *count oldest records from the ring buffer to @p records
+ * and sets @p *count to the number of moved records. If @p records is
+ * @c NULL, only returns the number of buffered records in @p *count. */
+mkldnn_status_t MKLDNN_API mkldnn_profiling_get_records(
+        mkldnn_profiling_record_t *records, size_t *count);
+
+/** Writes the buffered records to the file @p path in the Chrome trace event
+ * JSON format (viewable in chrome://tracing). The buffer is not cleared. */
+mkldnn_status_t MKLDNN_API mkldnn_profiling_dump_chrome_trace(
+        const char *path);
+
 /** @} */
 
 /** @addtogroup c_api_blas BLAS functions
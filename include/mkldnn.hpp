@@ -155,9 +155,25 @@ public:
         inline operator primitive() const;
     };
 
+    /// A data handle bound to a memory primitive for one execute() call.
+    struct arg {
+        /// The underlying C API structure.
+        mkldnn_exec_arg_t data;
+        /// Binds @p ahandle to the memory primitive @p amemory.
+        arg(const primitive &amemory, void *ahandle) {
+            data.memory = amemory.get();
+            data.handle = ahandle;
+        }
+    };
+
     /// Returns the descriptor of the underlying C API primitive
     inline const_mkldnn_primitive_desc_t get_primitive_desc() const;
     // TODO: use the C++ API wrapper structure.
+
+    /// Executes the primitive synchronously on the calling thread, the
+    /// memory primitives of @p args using the bound data handles. See
+    /// #mkldnn_primitive_execute().
+    inline void execute(const std::vector<arg> &args = {}) const;
 };
 
 inline mkldnn_primitive_kind_t convert_to_c(primitive::kind akind) {
@@ -222,6 +238,15 @@ const_mkldnn_primitive_desc_t primitive::get_primitive_desc() const {
             "could not get primitive descriptor by primitive");
     return pd;
 }
+
+inline void primitive::execute(const std::vector<arg> &args) const {
+    std::vector<mkldnn_exec_arg_t> c_args;
+    c_args.reserve(args.size());
+    for (const auto &a: args) c_args.push_back(a.data);
+    error::wrap_c_api(mkldnn_primitive_execute(get(), (int)c_args.size(),
+                c_args.empty() ? nullptr : &c_args[0]),
+            "could not execute a primitive");
+}
 /// @}
 
 /// @addtogroup cpp_api_enums Common data types and enumerations
@@ -331,6 +356,9 @@ enum query {
 
     impl_info_str = mkldnn_query_impl_info_str,
 
+    flops_f64 = mkldnn_query_flops_f64,
+    bytes_f64 = mkldnn_query_bytes_f64,
+
     memory_d = mkldnn_query_memory_d,
     convolution_d = mkldnn_query_convolution_d,
     deconvolution_d = mkldnn_query_deconvolution_d,
@@ -353,6 +381,7 @@ enum query {
     dst_pd = mkldnn_query_dst_pd,
     diff_dst_pd = mkldnn_query_diff_dst_pd,
     workspace_pd = mkldnn_query_workspace_pd,
+    src_image_pd = mkldnn_query_src_image_pd,
 };
 
 inline mkldnn_query_t convert_to_c(query aquery) {
@@ -594,6 +623,7 @@ struct memory: public primitive  {
         s16 = mkldnn_s16,
         s8 = mkldnn_s8,
         u8 = mkldnn_u8,
+        bf16 = mkldnn_bf16,
     };
 
     /// Memory format specification. See #mkldnn_memory_format_t
@@ -690,6 +720,7 @@ struct memory: public primitive  {
         ldgoi_p = mkldnn_ldgoi_p,
         ldgo = mkldnn_ldgo,
         wino_fmt = mkldnn_wino_fmt,
+        bcsr_fmt = mkldnn_bcsr_fmt,
         format_last = mkldnn_format_last,
     };
 
@@ -718,6 +749,22 @@ struct memory: public primitive  {
         ///
         /// @param adata A C API #mkldnn_memory_desc_t structure.
         desc(const mkldnn_memory_desc_t &adata): data(adata) {}
+
+        /// Constructs a descriptor of block-CSR weights with blocks of
+        /// @p oc_block x @p k_block elements.
+        ///
+        /// @sa mkldnn_bcsr_memory_desc_init
+        static desc bcsr(dims adims, data_type adata_type, int oc_block,
+                int k_block) {
+            validate_dims(adims);
+            mkldnn_memory_desc_t md;
+            error::wrap_c_api(
+                    mkldnn_bcsr_memory_desc_init(&md, (int)adims.size(),
+                        adims.size() == 0 ? nullptr : &adims[0],
+                        convert_to_c(adata_type), oc_block, k_block),
+                    "could not initialize a block-CSR memory descriptor");
+            return desc(md);
+        }
     };
 
     /// A memory primitive descriptor.
@@ -781,23 +828,12 @@ struct memory: public primitive  {
         };
         auto _free = [](char* p) { ::free((void*)p); };
 #else
+        /* mkldnn_malloc() follows the library memory policy
+         * (see mkldnn_memory_policy_set()) */
         auto _malloc = [](size_t size, int alignment) {
-            void *ptr;
-#ifdef _WIN32
-            ptr = _aligned_malloc(size, alignment);
-            int rc = ((ptr)? 0 : errno);
-#else
-            int rc = ::posix_memalign(&ptr, alignment, size);
-#endif /* _WIN32 */
-            return (rc == 0) ? (char*)ptr : nullptr;
-        };
-        auto _free = [](char* p) {
-#ifdef _WIN32
-            _aligned_free((void*)p);
-#else
-            ::free((void*)p);
-#endif /* _WIN32 */
+            return static_cast<char *>(mkldnn_malloc(size, alignment));
         };
+        auto _free = [](char *p) { mkldnn_free((void *)p); };
 #endif // _SX
         _handle.reset(_malloc(adesc.get_size(), 4096), _free);
         set_data_handle(_handle.get());
@@ -1097,6 +1133,21 @@ struct concat : public primitive {
             return adesc;
         }
 
+        /// Returns the slot of input @p index in the destination. A memory
+        /// created with it on top of the destination data handle can be
+        /// written by a producer directly; concat does not copy it.
+        memory::primitive_desc src_image_primitive_desc(int index) const {
+            memory::primitive_desc adesc;
+            mkldnn_primitive_desc_t cdesc;
+            const_mkldnn_primitive_desc_t const_cdesc =
+                mkldnn_primitive_desc_query_pd(get(),
+                               mkldnn::convert_to_c(src_image_pd), index);
+            error::wrap_c_api(mkldnn_primitive_desc_clone(&cdesc, const_cdesc),
+                    "could not clone a src image primitive descriptor");
+            adesc.reset(cdesc);
+            return adesc;
+        }
+
         engine get_engine() { return engine::query(*this); }
     };
 
@@ -3157,6 +3208,26 @@ struct batch_normalization_forward : public primitive {
             "could not create a batch normalization forward primitive");
         reset(result);
     }
+
+    /// Folds an inference batch normalization into the weights and bias of
+    /// the preceding convolution or inner product (in-place).
+    /// @sa mkldnn_batch_normalization_fold
+    static void fold(const desc &adesc, memory &weights, memory &bias,
+            const memory &mean, const memory &variance) {
+        error::wrap_c_api(mkldnn_batch_normalization_fold(&adesc.data,
+                    weights.get(), bias.get(), mean.get(), variance.get(),
+                    nullptr),
+                "could not fold batch normalization into weights");
+    }
+
+    static void fold(const desc &adesc, memory &weights, memory &bias,
+            const memory &mean, const memory &variance,
+            const memory &scaleshift) {
+        error::wrap_c_api(mkldnn_batch_normalization_fold(&adesc.data,
+                    weights.get(), bias.get(), mean.get(), variance.get(),
+                    scaleshift.get()),
+                "could not fold batch normalization into weights");
+    }
 };
 
 struct batch_normalization_backward : public primitive {
@@ -74,6 +74,9 @@ typedef enum {
     mkldnn_s8 = 5,
     /** 8-bit unsigned integer. */
     mkldnn_u8 = 6,
+    /** 16-bit bfloat16: the upper half of an f32, used for storage only
+     * (computations accumulate in f32). */
+    mkldnn_bf16 = 7,
 } mkldnn_data_type_t;
 
 //@{
@@ -371,6 +374,9 @@ typedef enum {
     mkldnn_ldgo,
     /** General tensor format for integer 8bit winograd convolution. */
     mkldnn_wino_fmt,
+    /** Block-CSR (compressed sparse row) weights tensor, see
+     * #mkldnn_bcsr_desc_t. */
+    mkldnn_bcsr_fmt,
     /** Just a sentinel, not real memory format. Must be changed after new
      * format is added. */
     mkldnn_format_last,
@@ -625,6 +631,28 @@ typedef struct {
     size_t size;
 } mkldnn_wino_desc_t;
 
+/** Description of a block-CSR weights tensor (#mkldnn_bcsr_fmt) for pruned
+ * models.
+ *
+ * The weights are seen as an @c oc x @c k matrix, @c oc being the first
+ * dimension and @c k the product of the others (ic * kh * kw for a
+ * convolution), cut into @c oc_block x @c k_block blocks. Only the blocks
+ * with a non-zero element are stored. The buffer holds, in this order:
+ * - int32_t row_ptr[nrb + 1]: the blocks of block row @c r are
+ *   [row_ptr[r], row_ptr[r + 1]);
+ * - int32_t col_idx[nrb * nkb]: the block column of each stored block;
+ * - float values[nrb * nkb][k_block][oc_block], 64-byte aligned;
+ * where nrb = div_up(oc, oc_block) and nkb = div_up(k, k_block). The arrays
+ * are sized for a dense matrix, so that @c size does not depend on the
+ * data. The buffer is filled by a reorder from a plain weights tensor. */
+typedef struct {
+    int oc;
+    int k;
+    int oc_block;
+    int k_block;
+    size_t size;
+} mkldnn_bcsr_desc_t;
+
 /** @addtogroup c_api_types_op_descs Operation descriptors
  *  @{*/
 
@@ -656,6 +684,8 @@ typedef struct {
         mkldnn_blocking_desc_t blocking;
         /** Tensor of weights for integer 8bit winograd convolution. */
         mkldnn_wino_desc_t wino_desc;
+        /** Tensor of weights in the block-CSR format. */
+        mkldnn_bcsr_desc_t bcsr_desc;
         /* ... other descriptions possible */
     } layout_desc;
 } mkldnn_memory_desc_t;
@@ -1104,6 +1134,15 @@ typedef struct {
     size_t output_index;
 } mkldnn_primitive_at_t;
 
+/** A data handle bound to a memory primitive for a single
+ * mkldnn_primitive_execute() call. */
+typedef struct {
+    /** Memory primitive the handle is bound to. */
+    const_mkldnn_primitive_t memory;
+    /** Data handle used instead of the one of @p memory. */
+    void *handle;
+} mkldnn_exec_arg_t;
+
 /** @} */
 
 /** @addtogroup c_api_types_query Queries
@@ -1167,6 +1206,13 @@ typedef enum {
 
     mkldnn_query_impl_info_str, /**< implementation name */
 
+    mkldnn_query_flops_f64, /**< number of arithmetic operations performed
+                              by one execution (0 if unknown or if the
+                              primitive only moves data) */
+    mkldnn_query_bytes_f64, /**< number of bytes read and written by one
+                              execution -- the sizes of all inputs and
+                              outputs memory (bytes) */
+
     /* memory and op descriptor section */
     mkldnn_query_some_d = 64, /**< stub */
     mkldnn_query_memory_d, /**< memory descriptor for memory and view */
@@ -1193,6 +1239,7 @@ typedef enum {
     mkldnn_query_dst_pd, /**< destination memory primitive desc */
     mkldnn_query_diff_dst_pd, /**< destination grad. memory primitive desc */
     mkldnn_query_workspace_pd, /**< workspace memory primitive desc */
+    mkldnn_query_src_image_pd, /**< slot of a concat input in the output */
 
 } mkldnn_query_t;
 
@@ -1219,6 +1266,80 @@ typedef struct mkldnn_stream *mkldnn_stream_t;
 /** A constant execution stream handle. */
 typedef const struct mkldnn_stream *const_mkldnn_stream_t;
 
+/** @} */
+
+/** @addtogroup c_api_types_profiling Profiling
+ * @{ */
+
+/** Maximal length of the primitive information string in a profiling record
+ * (including the terminating zero). */
+#define MKLDNN_PROFILING_INFO_LEN 1024
+
+/** @brief Kinds of profiling events. */
+typedef enum {
+    /** Primitive creation. */
+    mkldnn_profiling_create,
+    /** Primitive execution. */
+    mkldnn_profiling_exec,
+} mkldnn_profiling_event_kind_t;
+
+/** A profiling record describing one creation or execution of a primitive. */
+typedef struct {
+    /** Kind of the event. */
+    mkldnn_profiling_event_kind_t event_kind;
+    /** Kind of the primitive. */
+    mkldnn_primitive_kind_t primitive_kind;
+    /** Implementation name. */
+    char impl_name[64];
+    /** Primitive information, the same string MKLDNN_VERBOSE prints:
+     * primitive kind, implementation, propagation kind, formats, auxiliary
+     * information and problem description. */
+    char info[MKLDNN_PROFILING_INFO_LEN];
+    /** Start of the event (milliseconds, arbitrary origin). */
+    double start_ms;
+    /** Duration of the event (milliseconds). */
+    double duration_ms;
+    /** Total size of the input and output memories (bytes). */
+    double bytes;
+    /** Number of floating point (or integer) operations, 0 if unknown. */
+    double flops;
+    /** Maximal number of threads available to the primitive. */
+    int nthr;
+} mkldnn_profiling_record_t;
+
+/** A function called for every profiling record. The record is valid only
+ * during the call. */
+typedef void (*mkldnn_profiling_callback_t)(
+        const mkldnn_profiling_record_t *record, void *user_data);
+
+/** @} */
+
+/** @addtogroup c_api_types_memory_policy Memory policy
+ * @{ */
+
+/** @brief Huge page policies of the large buffers allocated by the library. */
+typedef enum {
+    /** Regular pages (whatever the system default is). */
+    mkldnn_hugepages_none,
+    /** Transparent huge pages, requested with madvise(MADV_HUGEPAGE). */
+    mkldnn_hugepages_thp,
+    /** Explicit huge pages from the hugetlb pool (falls back to
+     * #mkldnn_hugepages_thp when the pool is empty). */
+    mkldnn_hugepages_hugetlb,
+} mkldnn_hugepages_policy_t;
+
+/** @brief NUMA placement policies of the large buffers allocated by the
+ * library. */
+typedef enum {
+    /** First touch: a page lands on the node of the thread writing it
+     * first. */
+    mkldnn_numa_default,
+    /** Pages interleaved round-robin over all the allowed nodes. */
+    mkldnn_numa_interleave,
+    /** Pages bound to a single node. */
+    mkldnn_numa_bind,
+} mkldnn_numa_policy_t;
+
 /** @} */
 /** @} */
 /** @} */
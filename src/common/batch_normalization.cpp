@@ -15,9 +15,14 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <math.h>
 #include "mkldnn.h"
 
 #include "c_types_map.hpp"
+#include "memory_desc_wrapper.hpp"
+#include "memory_pd.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
@@ -48,20 +53,23 @@ status_t bnrm_desc_init(batch_normalization_desc_t *bnrm_desc,
     if ( one_of(bd.prop_kind,backward_data, backward) )
         bd.diff_data_desc = *diff_data_desc;
 
+    /* bf16 is a storage type: the per-channel parameters stay in f32 */
+    const data_type_t param_dt = data_desc->data_type == data_type::bf16
+        ? data_type::f32 : data_desc->data_type;
+
     dims_t scaleshift_dims = { 2, data_desc->dims[1] };
     mkldnn_memory_desc_init(&bd.data_scaleshift_desc, 2, scaleshift_dims,
-            data_desc->data_type, mkldnn_nc);
+            param_dt, mkldnn_nc);
     bd.diff_data_scaleshift_desc = zero_md();
     if (bd.prop_kind == backward) {
         mkldnn_memory_desc_init(&bd.diff_data_scaleshift_desc, 2,
-                scaleshift_dims, data_desc->data_type, mkldnn_nc);
+                scaleshift_dims, param_dt, mkldnn_nc);
     }
 
     dims_t stats_dims = { data_desc->dims[1] };
-    mkldnn_memory_desc_init(&bd.mean_desc, 1, stats_dims,
-            data_desc->data_type, mkldnn_x);
-    mkldnn_memory_desc_init(&bd.variance_desc, 1, stats_dims,
-            data_desc->data_type, mkldnn_x);
+    mkldnn_memory_desc_init(&bd.mean_desc, 1, stats_dims, param_dt, mkldnn_x);
+    mkldnn_memory_desc_init(&bd.variance_desc, 1, stats_dims, param_dt,
+            mkldnn_x);
 
     bd.batch_norm_epsilon = epsilon;
 
@@ -104,4 +112,81 @@ status_t mkldnn_batch_normalization_backward_desc_init(
             epsilon, flags);
 }
 
+status_t mkldnn_batch_normalization_fold(
+        const batch_normalization_desc_t *bnrm_desc, primitive_t *weights,
+        primitive_t *bias, const primitive_t *mean,
+        const primitive_t *variance, const primitive_t *scaleshift) {
+    if (any_null(bnrm_desc, weights, bias, mean, variance))
+        return invalid_arguments;
+
+    const unsigned flags = bnrm_desc->flags;
+    const bool use_scaleshift = flags & mkldnn_use_scaleshift;
+    bool args_ok = true
+        && bnrm_desc->prop_kind == forward_inference
+        && (flags & mkldnn_use_global_stats)
+        && !(flags & mkldnn_fuse_bn_relu)
+        && implication(use_scaleshift, scaleshift != nullptr);
+    if (!args_ok) return invalid_arguments;
+
+    auto is_f32_memory = [](const primitive_t *p) {
+        if (p->kind() != primitive_kind::memory) return false;
+        const memory_desc_wrapper md((const memory_pd_t *)p->pd());
+        return md.data_type() == data_type::f32 && md.is_blocking_desc();
+    };
+    args_ok = is_f32_memory(weights) && is_f32_memory(bias)
+        && is_f32_memory(mean) && is_f32_memory(variance)
+        && (!use_scaleshift || is_f32_memory(scaleshift));
+    if (!args_ok) return invalid_arguments;
+
+    const memory_desc_wrapper w_d((const memory_pd_t *)weights->pd());
+    const memory_desc_wrapper b_d((const memory_pd_t *)bias->pd());
+    const memory_desc_wrapper m_d((const memory_pd_t *)mean->pd());
+    const memory_desc_wrapper v_d((const memory_pd_t *)variance->pd());
+    const memory_desc_wrapper ss_d(use_scaleshift
+            ? (const memory_pd_t *)scaleshift->pd() : nullptr);
+
+    /* weights are [OC][...] or, with one more dimension than the data,
+     * [G][OC/G][...]: in both cases the logical offset divided by the
+     * per-channel size gives the output channel */
+    const int C = bnrm_desc->data_desc.dims[1];
+    const bool with_groups = w_d.ndims() == bnrm_desc->data_desc.ndims + 1;
+    bool dims_ok = true
+        && w_d.ndims() >= 2
+        && (with_groups
+                ? w_d.dims()[0] * w_d.dims()[1] == C
+                : w_d.dims()[0] == C)
+        && everyone_is(1, b_d.ndims(), m_d.ndims(), v_d.ndims())
+        && everyone_is(C, b_d.dims()[0], m_d.dims()[0], v_d.dims()[0])
+        && (!use_scaleshift || (true
+                && ss_d.ndims() == 2
+                && ss_d.dims()[0] == 2 && ss_d.dims()[1] == C));
+    if (!dims_ok) return invalid_arguments;
+
+    float *w = nullptr, *b = nullptr;
+    const float *m = nullptr, *v = nullptr, *ss = nullptr;
+    weights->get_data_handle((void **)&w);
+    bias->get_data_handle((void **)&b);
+    mean->get_data_handle((void **)&m);
+    variance->get_data_handle((void **)&v);
+    if (use_scaleshift)
+        scaleshift->get_data_handle((void **)&ss);
+    if (any_null(w, b, m, v) || (use_scaleshift && ss == nullptr))
+        return invalid_arguments;
+
+    const float eps = bnrm_desc->batch_norm_epsilon;
+    const size_t oc_size = w_d.nelems() / C;
+    parallel_nd(C, oc_size, [&](int oc, size_t i) {
+        const float sm = 1.f / sqrtf(v[v_d.off(oc)] + eps);
+        const float s = use_scaleshift ? ss[ss_d.off(0, oc)] * sm : sm;
+        w[w_d.off_l(oc * oc_size + i)] *= s;
+        if (i == 0) {
+            const float sv = use_scaleshift ? ss[ss_d.off(1, oc)] : 0.f;
+            float &b_oc = b[b_d.off(oc)];
+            b_oc = (b_oc - m[m_d.off(oc)]) * s + sv;
+        }
+    });
+
+    return success;
+}
+
 // vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
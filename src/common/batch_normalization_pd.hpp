@@ -149,6 +149,12 @@ struct batch_normalization_fwd_pd_t: public batch_normalization_pd_t {
     virtual int n_outputs() const override
     { return 1 + (fuse_bn_relu() + 2 * (!stats_is_src())) * is_training(); }
 
+    virtual double flops() const override {
+        /* normalization (+ statistics if they are computed) */
+        return memory_desc_wrapper(desc_.data_desc).nelems()
+            * (stats_is_src() ? 2 : 5);
+    }
+
     int ws_idx() const { return !stats_is_src() ? 3 : 1; }
 };
 
@@ -186,6 +192,9 @@ struct batch_normalization_bwd_pd_t: public batch_normalization_pd_t {
     virtual int n_outputs() const override
     { return 1 + (desc_.prop_kind == prop_kind::backward); }
 
+    virtual double flops() const override
+    { return 8. * memory_desc_wrapper(desc_.data_desc).nelems(); }
+
     int ws_idx() const { return use_scaleshift() ? 5 : 4; }
 };
 
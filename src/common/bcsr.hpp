@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef BCSR_HPP
+#define BCSR_HPP
+
+#include <stdint.h>
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** The arrays of a block-CSR weights buffer (memory_format::bcsr_fmt), see
+ * mkldnn_bcsr_desc_t. The offsets are in bytes from the beginning of the
+ * buffer; block \c b has its values at values() + b * blk_sz(), the
+ * oc_block elements of each of its k_block columns being contiguous. */
+struct bcsr_layout_t {
+    bcsr_layout_t(const bcsr_data_t &d)
+        : oc(d.oc), k(d.k), oc_block(d.oc_block), k_block(d.k_block)
+        , nrb(utils::div_up(d.oc, d.oc_block))
+        , nkb(utils::div_up(d.k, d.k_block))
+    {
+        row_ptr_off = 0;
+        col_idx_off = row_ptr_off + sizeof(int32_t) * (nrb + 1);
+        values_off = utils::rnd_up(
+                col_idx_off + sizeof(int32_t) * nrb * nkb, 64);
+        size = values_off + sizeof(float) * nrb * nkb * blk_sz();
+    }
+
+    int blk_sz() const { return oc_block * k_block; }
+
+    const int32_t *row_ptr(const char *base) const
+    { return (const int32_t *)(base + row_ptr_off); }
+    const int32_t *col_idx(const char *base) const
+    { return (const int32_t *)(base + col_idx_off); }
+    const float *values(const char *base) const
+    { return (const float *)(base + values_off); }
+    int32_t *row_ptr(char *base) const { return (int32_t *)(base + row_ptr_off); }
+    int32_t *col_idx(char *base) const { return (int32_t *)(base + col_idx_off); }
+    float *values(char *base) const { return (float *)(base + values_off); }
+
+    int oc, k, oc_block, k_block;
+    int nrb, nkb;
+    size_t row_ptr_off, col_idx_off, values_off, size;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
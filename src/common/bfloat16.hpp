@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef BFLOAT16_HPP
+#define BFLOAT16_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+#include "nstl.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** bfloat16 storage: the upper 16 bits of an IEEE f32.
+ *
+ * The type is only meant for storage: every computation converts to float
+ * (implicitly) and the result is rounded back to nearest even when stored,
+ * so that kernels accumulate in f32. */
+struct bfloat16_t {
+    uint16_t raw_bits_;
+
+    bfloat16_t() = default;
+    bfloat16_t(float f) { *this = f; }
+
+    bfloat16_t &operator=(float f) {
+        uint32_t u;
+        memcpy(&u, &f, sizeof(u));
+        if ((u & 0x7fffffffu) > 0x7f800000u) {
+            /* NaN: keep it a (quiet) NaN after the truncation */
+            raw_bits_ = (uint16_t)((u >> 16) | 0x40u);
+        } else {
+            /* round to nearest even; overflows to inf as it should */
+            u += 0x7fffu + ((u >> 16) & 1u);
+            raw_bits_ = (uint16_t)(u >> 16);
+        }
+        return *this;
+    }
+
+    operator float() const {
+        const uint32_t u = (uint32_t)raw_bits_ << 16;
+        float f;
+        memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+
+    bfloat16_t &operator+=(float a) { return *this = float(*this) + a; }
+
+    static bfloat16_t from_bits(uint16_t bits) {
+        bfloat16_t b;
+        b.raw_bits_ = bits;
+        return b;
+    }
+};
+
+static_assert(sizeof(bfloat16_t) == 2, "bfloat16_t must be 2 bytes");
+
+namespace nstl {
+template<> struct numeric_limits<bfloat16_t> {
+    static bfloat16_t lowest() { return bfloat16_t::from_bits(0xff7f); }
+    static bfloat16_t max() { return bfloat16_t::from_bits(0x7f7f); }
+};
+}
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -94,6 +94,7 @@ namespace data_type {
     const data_type_t s16 = mkldnn_s16;
     const data_type_t s8 = mkldnn_s8;
     const data_type_t u8 = mkldnn_u8;
+    const data_type_t bf16 = mkldnn_bf16;
 }
 
 using round_mode_t = mkldnn_round_mode_t;
@@ -193,6 +194,7 @@ namespace memory_format {
     const memory_format_t ldgoi_p = mkldnn_ldgoi_p;
     const memory_format_t ldgo = mkldnn_ldgo;
     const memory_format_t wino_fmt = mkldnn_wino_fmt;
+    const memory_format_t bcsr_fmt = mkldnn_bcsr_fmt;
 }
 
 using padding_kind_t = mkldnn_padding_kind_t;
@@ -242,6 +244,9 @@ namespace query {
 
     const query_t impl_info_str = mkldnn_query_impl_info_str;
 
+    const query_t flops_f64 = mkldnn_query_flops_f64;
+    const query_t bytes_f64 = mkldnn_query_bytes_f64;
+
     const query_t some_d = mkldnn_query_some_d;
     const query_t memory_d = mkldnn_query_memory_d;
     const query_t convolution_d = mkldnn_query_convolution_d;
@@ -266,10 +271,12 @@ namespace query {
     const query_t diff_dst_pd = mkldnn_query_diff_dst_pd;
 
     const query_t workspace_pd = mkldnn_query_workspace_pd;
+    const query_t src_image_pd = mkldnn_query_src_image_pd;
 }
 
 using blocking_desc_t = mkldnn_blocking_desc_t;
 using wino_data_t = mkldnn_wino_desc_t;
+using bcsr_data_t = mkldnn_bcsr_desc_t;
 using memory_desc_t = mkldnn_memory_desc_t;
 using convolution_desc_t = mkldnn_convolution_desc_t;
 using deconvolution_desc_t = mkldnn_deconvolution_desc_t;
@@ -333,6 +340,7 @@ using primitive_attr_t = mkldnn_primitive_attr;
 using post_ops_t = mkldnn_post_ops;
 using primitive_t = mkldnn_primitive;
 using primitive_at_t = mkldnn_primitive_at_t;
+using exec_arg_t = mkldnn_exec_arg_t;
 
 using stream_kind_t = mkldnn_stream_kind_t;
 namespace stream_kind {
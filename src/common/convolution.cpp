@@ -45,7 +45,10 @@ status_t conv_desc_init(convolution_desc_t *conv_desc,
         && !any_null(conv_desc, src_desc, weights_desc, dst_desc, strides,
                 padding_l)
         && one_of(alg_kind, convolution_direct, convolution_winograd)
-        && one_of(padding_kind, padding_kind::padding_zero);
+        && one_of(padding_kind, padding_kind::padding_zero)
+        /* block-CSR weights are for inference only */
+        && implication(weights_desc->format == memory_format::bcsr_fmt,
+                one_of(prop_kind, forward_training, forward_inference));
 #ifndef NDEBUG
     if (!args_ok) {printf("Oops [%s:%d] !args_ok\n", __FILE__, __LINE__); fflush(stdout);}
     //else          {printf(" OK  [%s:%d]  args_ok\n", __FILE__, __LINE__); fflush(stdout);}
@@ -71,6 +71,11 @@ struct _convolution_fwd_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return 2 + with_bias(); }
     virtual int n_outputs() const override { return 1; }
 
+    virtual double flops() const override {
+        return 2. * MB() * OC() * IC() / G() * OD() * OH() * OW()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -193,6 +198,11 @@ struct convolution_bwd_data_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return 2 + with_bias(); }
     virtual int n_outputs() const override { return 1; }
 
+    virtual double flops() const override {
+        return 2. * MB() * OC() * IC() / G() * OD() * OH() * OW()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -302,6 +312,11 @@ struct convolution_bwd_weights_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return 2; }
     virtual int n_outputs() const override { return 1 + with_bias(); }
 
+    virtual double flops() const override {
+        return 2. * MB() * OC() * IC() / G() * OD() * OH() * OW()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
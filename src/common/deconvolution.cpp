@@ -39,7 +39,8 @@ status_t deconv_desc_init(deconvolution_desc_t *deconv_desc,
             && !any_null(deconv_desc, src_desc, weights_desc, dst_desc, strides,
                            padding_l)
             && one_of(alg_kind, deconvolution_direct, deconvolution_winograd)
-            && one_of(padding_kind, padding_kind::padding_zero);
+            && one_of(padding_kind, padding_kind::padding_zero)
+            && weights_desc->format != bcsr_fmt;
     if (!args_ok)
         return invalid_arguments;
 
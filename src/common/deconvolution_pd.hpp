@@ -59,6 +59,11 @@ struct deconvolution_fwd_pd_t : public primitive_desc_t {
 
     virtual int n_inputs() const override { return 2 + with_bias(); }
     virtual int n_outputs() const override { return 1; }
+
+    virtual double flops() const override {
+        return 2. * MB() * OC() * IC() / G() * ID() * IH() * IW()
+            * KD() * KH() * KW();
+    }
     /* Memory format Query */
     virtual status_t query(query_t what, int idx, void *result) const override {
         switch (what) {
@@ -158,6 +163,11 @@ struct deconvolution_bwd_data_pd_t : public primitive_desc_t {
     virtual int n_inputs() const override { return 2; }
     virtual int n_outputs() const override { return 1; }
 
+    virtual double flops() const override {
+        return 2. * MB() * OC() * IC() / G() * ID() * IH() * IW()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override {
         switch (what) {
         case query::deconvolution_d:
@@ -214,7 +224,7 @@ struct deconvolution_bwd_data_pd_t : public primitive_desc_t {
     inline bool with_groups() const {
         return desc_.weights_desc.ndims == desc_.diff_src_desc.ndims + 1;
     }
-    inline int ndims() const { return desc_.src_desc.ndims; }
+    inline int ndims() const { return desc_.diff_src_desc.ndims; }
 
 protected:
     deconvolution_desc_t desc_;
@@ -259,6 +269,11 @@ struct deconvolution_bwd_weights_pd_t : public primitive_desc_t {
     virtual int n_inputs() const override { return 2; }
     virtual int n_outputs() const override { return 1 + with_bias(); }
 
+    virtual double flops() const override {
+        return 2. * MB() * OC() * IC() / G() * ID() * IH() * IW()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override {
         switch (what) {
         case query::deconvolution_d:
@@ -51,6 +51,9 @@ struct eltwise_fwd_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return 1; }
     virtual int n_outputs() const override { return 1; }
 
+    virtual double flops() const override
+    { return memory_desc_wrapper(desc_.data_desc).nelems(); }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -114,6 +117,9 @@ struct eltwise_bwd_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return 2; }
     virtual int n_outputs() const override { return 1; }
 
+    virtual double flops() const override
+    { return memory_desc_wrapper(desc_.data_desc).nelems(); }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
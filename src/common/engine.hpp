@@ -24,6 +24,12 @@
 #include "primitive.hpp"
 #include "utils.hpp"
 
+namespace mkldnn {
+namespace impl {
+struct pd_cache_t;
+}
+}
+
 /** \brief An abstraction of an execution unit with shared resources
  *
  * Responsibilities:
@@ -141,6 +147,17 @@ struct mkldnn_engine: public mkldnn::impl::c_compatible {
      * NULL-terminated list */
     virtual const primitive_desc_create_f* get_implementation_list() const;
 
+    /** return the list of implementations of primitive kind @p kind. engine
+     * guarantees to return a NULL-terminated list, which may contain
+     * implementations of other kinds too (the default is the full list) */
+    virtual const primitive_desc_create_f* get_kind_implementation_list(
+            mkldnn::impl::primitive_kind_t kind) const
+    { return get_implementation_list(); }
+
+    /** return the cache of primitive descriptors created on this engine, or
+     * nullptr if the engine does not cache them */
+    virtual mkldnn::impl::pd_cache_t *pd_cache() { return nullptr; }
+
 protected:
     mkldnn::impl::engine_kind_t kind_;
 };
@@ -0,0 +1,64 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef EXEC_ARGS_HPP
+#define EXEC_ARGS_HPP
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** The data handles bound to memory primitives by the
+ * mkldnn_primitive_execute() call in progress on the calling thread.
+ *
+ * The bindings live in a thread local, so neither the primitive nor the
+ * memory primitives are modified and concurrent calls from other threads
+ * see their own bindings. The memory primitives resolve their data through
+ * handle() when the primitives look them up (input_memory(), memory()),
+ * which happens on the calling thread before any parallel region. Scopes
+ * nest: an inner binding hides the outer one for its duration. */
+struct exec_args_t {
+    exec_args_t(int nargs, const exec_arg_t *args)
+        : nargs_(nargs), args_(args), prev_(current_) { current_ = this; }
+    ~exec_args_t() { current_ = prev_; }
+
+    /** returns the handle bound to @p memory, or nullptr if none */
+    static void *handle(const primitive_t *memory) {
+        for (const exec_args_t *a = current_; a; a = a->prev_)
+            for (int i = 0; i < a->nargs_; ++i)
+                if (a->args_[i].memory == memory) return a->args_[i].handle;
+        return nullptr;
+    }
+
+private:
+    int nargs_;
+    const exec_arg_t *args_;
+    const exec_args_t *prev_;
+
+    THREAD_LOCAL static const exec_args_t *current_;
+
+    exec_args_t(const exec_args_t &) = delete;
+    exec_args_t &operator=(const exec_args_t &) = delete;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef IDIV_HPP
+#define IDIV_HPP
+
+#include <assert.h>
+
+#include "nstl.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** \file
+ * Integer division rounding toward -infinity (C++ truncates toward 0, which
+ * is wrong for the negative numerators of padded window bounds), and the
+ * valid tap ranges of a window dimension built on top of it. The branchless
+ * forms come from tests/dev/idiv-dev.hpp. */
+
+/** \c n / \c d rounded toward -infinity. \pre d > 0 (unchecked) */
+inline constexpr int div_floor(int const n, int const d) {
+    return (n / d) - (n % d < 0 ? 1 : 0);
+}
+
+/** \c n / \c d rounded toward +infinity. \pre d > 0 (unchecked) */
+inline constexpr int div_ceil(int const n, int const d) {
+    return -div_floor(-n, d);
+}
+
+/** Euclidean remainder: \c r in [0, d) with n == d * div_floor(n, d) + r.
+ * \pre d > 0 (unchecked) */
+inline constexpr int rem_floor(int const n, int const d) {
+    return n % d + (d & (n % d < 0 ? ~0 : 0));
+}
+
+static_assert(div_floor( 4, 3) ==  1, "div_floor");
+static_assert(div_floor( 0, 3) ==  0, "div_floor");
+static_assert(div_floor(-1, 3) == -1, "div_floor");
+static_assert(div_floor(-3, 3) == -1, "div_floor");
+static_assert(div_floor(-4, 3) == -2, "div_floor");
+static_assert(div_ceil ( 4, 3) ==  2, "div_ceil");
+static_assert(div_ceil ( 3, 3) ==  1, "div_ceil");
+static_assert(div_ceil (-1, 3) ==  0, "div_ceil");
+static_assert(div_ceil (-4, 3) == -1, "div_ceil");
+static_assert(rem_floor( 4, 3) ==  1, "rem_floor");
+static_assert(rem_floor(-1, 3) ==  2, "rem_floor");
+static_assert(rem_floor(-3, 3) ==  0, "rem_floor");
+
+/** Window taps, see window_taps_t: the outputs whose tap \c k reads
+ * inside [0, I) are [window_o_beg(k, ...), window_o_end(k, ...)), empty
+ * when the end is not past the beginning. */
+inline int window_o_beg(int k, int S, int P, int DD) {
+    return nstl::max(0, div_ceil(P - k * DD, S));
+}
+inline int window_o_end(int k, int O, int I, int S, int P, int DD) {
+    return nstl::min(O, div_ceil(I + P - k * DD, S));
+}
+
+/** Valid taps of one spatial dimension of a convolution or pooling window.
+ *
+ * Output \c o reads input i = o * S - P + k * DD through tap k in [0, K),
+ * where DD = 1 + dilation, and only the taps with i in [0, I) count. The
+ * tables are built once so that the loops over taps need neither bounds
+ * checks nor divisions:
+ * - by output (forward): the taps of \c o are [k_beg(o), k_end(o));
+ * - by tap (col2im): the outputs of \c k are [o_beg(k), o_end(k));
+ * - by input (backward data): the taps reaching \c i are
+ *   k = bk_beg(i) + t * bk_step(), from o = bo_beg(i) - t * bo_step(), for
+ *   t in [0, bn(i)). The divisibility of i + P - k * DD by S makes them an
+ *   arithmetic progression. */
+struct window_taps_t {
+    window_taps_t(int O, int I, int K, int S, int P, int DD)
+        : k_beg_(O), k_end_(O), o_beg_(K), o_end_(K)
+        , bk_beg_(I), bo_beg_(I), bn_(I)
+    {
+        assert(S > 0 && DD > 0);
+        for (int o = 0; o < O; ++o) {
+            k_beg_[o] = nstl::max(0, div_ceil(P - o * S, DD));
+            k_end_[o] = nstl::max(k_beg_[o],
+                    nstl::min(K, div_ceil(I + P - o * S, DD)));
+        }
+        for (int k = 0; k < K; ++k) {
+            o_beg_[k] = window_o_beg(k, S, P, DD);
+            o_end_[k] = nstl::max(o_beg_[k],
+                    window_o_end(k, O, I, S, P, DD));
+        }
+
+        int g = S, r = DD;
+        while (r) { const int t = g % r; g = r; r = t; }
+        bk_step_ = S / g;
+        bo_step_ = DD / g;
+        for (int i = 0; i < I; ++i) {
+            bk_beg_[i] = bo_beg_[i] = bn_[i] = 0;
+            for (int k = 0; k < K; ++k) {
+                const int n = i + P - k * DD;
+                if (rem_floor(n, S) != 0 || n < 0 || n / S >= O) continue;
+                if (bn_[i] == 0) {
+                    bk_beg_[i] = k;
+                    bo_beg_[i] = n / S;
+                }
+                assert(k == bk_beg_[i] + bn_[i] * bk_step_);
+                ++bn_[i];
+            }
+        }
+    }
+
+    int k_beg(int o) const { return k_beg_[o]; }
+    int k_end(int o) const { return k_end_[o]; }
+    int o_beg(int k) const { return o_beg_[k]; }
+    int o_end(int k) const { return o_end_[k]; }
+
+    int bk_beg(int i) const { return bk_beg_[i]; }
+    int bo_beg(int i) const { return bo_beg_[i]; }
+    int bn(int i) const { return bn_[i]; }
+    int bk_step() const { return bk_step_; }
+    int bo_step() const { return bo_step_; }
+
+private:
+    nstl::vector<int> k_beg_, k_end_, o_beg_, o_end_;
+    nstl::vector<int> bk_beg_, bo_beg_, bn_;
+    int bk_step_, bo_step_;
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -32,7 +32,10 @@ namespace {
 status_t ip_desc_init(inner_product_desc_t *ip_desc, prop_kind_t prop_kind,
         const memory_desc_t *src_desc, const memory_desc_t *weights_desc,
         const memory_desc_t *bias_desc, const memory_desc_t *dst_desc) {
-    bool args_ok = !any_null(ip_desc, src_desc, weights_desc, dst_desc);
+    bool args_ok = !any_null(ip_desc, src_desc, weights_desc, dst_desc)
+        /* block-CSR weights are for inference only */
+        && implication(weights_desc->format == memory_format::bcsr_fmt,
+                one_of(prop_kind, forward_training, forward_inference));
     if (!args_ok){
         printf(" ip_desc_init: null args!"); fflush(stdout);
         return invalid_arguments;
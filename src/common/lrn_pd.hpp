@@ -54,6 +54,13 @@ struct lrn_fwd_pd_t: public primitive_desc_t {
     virtual int n_outputs() const override
     { return 1 + (workspace_pd() != nullptr); }
 
+    virtual double flops() const override {
+        const int ls = desc_.local_size;
+        const double window = desc_.alg_kind == alg_kind::lrn_across_channels
+            ? ls : ls * ls;
+        return memory_desc_wrapper(desc_.data_desc).nelems() * (window + 3);
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -109,6 +116,14 @@ struct lrn_bwd_pd_t: public primitive_desc_t {
     virtual int n_outputs() const override
     { return 1; }
 
+    virtual double flops() const override {
+        const int ls = desc_.local_size;
+        const double window = desc_.alg_kind == alg_kind::lrn_across_channels
+            ? ls : ls * ls;
+        return 2. * memory_desc_wrapper(desc_.data_desc).nelems()
+            * (window + 3);
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -0,0 +1,201 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#if defined(__linux__) && !defined(__ve)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MEM_POLICY_MMAP
+#endif
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "mem_policy.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+#include "ws_pool.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::utils;
+
+namespace mkldnn {
+namespace impl {
+
+namespace {
+
+/* the policy allocations are mapped one by one and munmap() needs their
+ * length. The registry is leaked on purpose: a global scratchpad may still
+ * be released after the static destructors ran */
+struct mapped_t {
+    std::mutex mutex;
+    std::map<void *, size_t> len;
+};
+
+mapped_t &mapped() {
+    static mapped_t *m = new mapped_t;
+    return *m;
+}
+
+std::atomic<size_t> n_mapped(0);
+
+mem_policy_t policy_from_env() {
+    mem_policy_t p = { mkldnn_hugepages_none, mkldnn_numa_default, 0 };
+    const int len = 16;
+    char val[len] = {0};
+    if (mkldnn_getenv(val, "MKLDNN_HUGEPAGES", len) > 0) {
+        if (!strcmp(val, "thp")) p.hugepages = mkldnn_hugepages_thp;
+        else if (!strcmp(val, "hugetlb")) p.hugepages = mkldnn_hugepages_hugetlb;
+    }
+    if (mkldnn_getenv(val, "MKLDNN_NUMA", len) > 0) {
+        if (!strcmp(val, "interleave")) {
+            p.numa = mkldnn_numa_interleave;
+        } else if (val[0] >= '0' && val[0] <= '9') {
+            p.numa = mkldnn_numa_bind;
+            p.node = atoi(val);
+        }
+    }
+    return p;
+}
+
+}
+
+mem_policy_t &mem_policy() {
+    static mem_policy_t policy = policy_from_env();
+    return policy;
+}
+
+void *mem_policy_malloc(size_t size, size_t alignment) {
+#ifdef MEM_POLICY_MMAP
+    const mem_policy_t &p = mem_policy();
+    if (size < mem_policy_t::min_size || (p.hugepages == mkldnn_hugepages_none
+                && p.numa == mkldnn_numa_default))
+        return nullptr;
+
+    const size_t page_4k = 4096, page_2m = 2 * 1024 * 1024;
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    char *ptr = nullptr;
+    size_t len = 0;
+
+    if (p.hugepages == mkldnn_hugepages_hugetlb && alignment <= page_2m) {
+        len = rnd_up(size, page_2m);
+        void *m = mmap(nullptr, len, prot, flags | MAP_HUGETLB, -1, 0);
+        if (m != MAP_FAILED) ptr = (char *)m;
+    }
+
+    if (ptr == nullptr) {
+        /* over-allocate by the alignment and trim the head and the tail */
+        const size_t align = nstl::max(alignment,
+                p.hugepages == mkldnn_hugepages_none ? page_4k : page_2m);
+        len = rnd_up(size, page_4k);
+        void *m = mmap(nullptr, len + align, prot, flags, -1, 0);
+        if (m == MAP_FAILED) return nullptr;
+        char *base = (char *)m;
+        ptr = (char *)rnd_up((size_t)base, align);
+        if (ptr > base) munmap(base, ptr - base);
+        if (ptr + len < base + len + align)
+            munmap(ptr + len, base + len + align - (ptr + len));
+        if (p.hugepages != mkldnn_hugepages_none)
+            madvise(ptr, len, MADV_HUGEPAGE);
+    }
+
+#ifdef SYS_mbind
+    if (p.numa != mkldnn_numa_default) {
+        /* MPOL_INTERLEAVE and MPOL_BIND of <numaif.h>, which is not always
+         * installed. The kernel clips the mask to the allowed nodes */
+        enum { mpol_bind = 2, mpol_interleave = 3 };
+        unsigned long mask = p.numa == mkldnn_numa_interleave
+            ? ~0UL : 1UL << p.node;
+        syscall(SYS_mbind, ptr, len,
+                p.numa == mkldnn_numa_interleave ? mpol_interleave : mpol_bind,
+                &mask, sizeof(mask) * 8, 0);
+    }
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(mapped().mutex);
+        mapped().len[ptr] = len;
+    }
+    ++n_mapped;
+    return ptr;
+#else
+    UNUSED(size);
+    UNUSED(alignment);
+    return nullptr;
+#endif
+}
+
+bool mem_policy_free(void *p) {
+#ifdef MEM_POLICY_MMAP
+    if (p == nullptr || n_mapped == 0) return false;
+    size_t len = 0;
+    {
+        std::lock_guard<std::mutex> lock(mapped().mutex);
+        auto it = mapped().len.find(p);
+        if (it == mapped().len.end()) return false;
+        len = it->second;
+        mapped().len.erase(it);
+    }
+    --n_mapped;
+    munmap(p, len);
+    return true;
+#else
+    UNUSED(p);
+    return false;
+#endif
+}
+
+}
+}
+
+mkldnn_status_t mkldnn_memory_policy_set(mkldnn_hugepages_policy_t hugepages,
+        mkldnn_numa_policy_t numa, int node) {
+    const int max_node = (int)sizeof(unsigned long) * 8;
+    bool args_ok = true
+        && one_of(hugepages, mkldnn_hugepages_none, mkldnn_hugepages_thp,
+                mkldnn_hugepages_hugetlb)
+        && one_of(numa, mkldnn_numa_default, mkldnn_numa_interleave,
+                mkldnn_numa_bind)
+        && implication(numa == mkldnn_numa_bind, node >= 0 && node < max_node);
+    if (!args_ok) return invalid_arguments;
+
+    mem_policy_t &p = mem_policy();
+    p.hugepages = hugepages;
+    p.numa = numa;
+    p.node = numa == mkldnn_numa_bind ? node : 0;
+    /* the idle pooled workspaces have the old placement */
+    ws_pool().trim();
+    return success;
+}
+
+void *mkldnn_malloc(size_t size, size_t alignment) {
+    return mkldnn::impl::malloc(size, (int)alignment);
+}
+
+void mkldnn_free(void *ptr) {
+    mkldnn::impl::free(ptr);
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
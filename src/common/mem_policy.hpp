@@ -0,0 +1,56 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef MEM_POLICY_HPP
+#define MEM_POLICY_HPP
+
+#include <stddef.h>
+
+#include "mkldnn_types.h"
+
+namespace mkldnn {
+namespace impl {
+
+/** The library wide placement of the large buffers, see
+ * mkldnn_memory_policy_set(). The default comes from MKLDNN_HUGEPAGES and
+ * MKLDNN_NUMA. */
+struct mem_policy_t {
+    /** smaller buffers share their pages with the rest of the heap: they are
+     * left to malloc */
+    static constexpr size_t min_size = 2 * 1024 * 1024;
+
+    mkldnn_hugepages_policy_t hugepages;
+    mkldnn_numa_policy_t numa;
+    int node;
+};
+
+mem_policy_t &mem_policy();
+
+/** Allocates \p size bytes aligned on \p alignment with their own mapping
+ * and the huge page and NUMA advice of mem_policy(). Returns nullptr when
+ * the buffer is too small, the policy is the default one or the system
+ * lacks the support: the caller then falls back to a plain allocation. */
+void *mem_policy_malloc(size_t size, size_t alignment);
+
+/** Releases \p p and returns true if it comes from mem_policy_malloc(). */
+bool mem_policy_free(void *p);
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -49,7 +49,7 @@ bool memory_desc_sanity_check(int ndims,const dims_t dims,
 #define AND_(...) SCHKVV(ok,__VA_ARGS__)
     AND_(dims != nullptr);
     AND_(0 < ndims && ndims <= TENSOR_MAX_DIMS);
-    AND_(one_of(data_type, f32, s32, s16, s8, u8));
+    AND_(one_of(data_type, f32, s32, s16, s8, u8, bf16));
     AND_(format != memory_format::undef);
     if(ok) for (int d = 0; ok && d < ndims; ++d)
         AND_(dims[d] >= 0) || printf(" (dims[%d] = %d) < 0", d, dims[d]);
@@ -113,7 +113,9 @@ status_t mkldnn_memory_desc_init(memory_desc_t *memory_desc, int ndims,
 #endif
     if (!args_ok) return invalid_arguments;
 
-    memory_desc_t md;
+    /* zero the unused tails, so that equal descriptors are equal bytewise
+     * (e.g. in the primitive descriptor cache keys) */
+    memory_desc_t md = memory_desc_t();
     md.ndims = ndims;
     array_copy(md.dims, dims, ndims);
     md.primitive_kind = primitive_kind::memory;
@@ -130,6 +132,9 @@ status_t mkldnn_memory_desc_init(memory_desc_t *memory_desc, int ndims,
     } else if (types::format_normalize(format) == blocked) {
         status = memory_desc_wrapper::compute_blocking(md);
         AND_(status==success && "compute_blocking failed" );
+    } else if (format == bcsr_fmt) {
+        status = memory_desc_wrapper::compute_bcsr(md, 1, 1);
+        AND_(status==success && "compute_bcsr failed" );
     } else {
 #ifndef NDEBUG
         printf("memory_desc_init: unhandled format %s\n",mkldnn_fmt2str(format));
@@ -145,6 +150,19 @@ status_t mkldnn_memory_desc_init(memory_desc_t *memory_desc, int ndims,
 #undef AND_
 }
 
+status_t mkldnn_bcsr_memory_desc_init(memory_desc_t *memory_desc, int ndims,
+        const dims_t dims, data_type_t data_type, int oc_block, int k_block) {
+    if (any_null(memory_desc)) return invalid_arguments;
+    memory_desc_t md;
+    status_t status = mkldnn_memory_desc_init(&md, ndims, dims, data_type,
+            bcsr_fmt);
+    if (status != success) return status;
+    status = memory_desc_wrapper::compute_bcsr(md, oc_block, k_block);
+    if (status == success)
+        *memory_desc = md;
+    return status;
+}
+
 status_t mkldnn_memory_primitive_desc_create(primitive_desc_t **memory_pd,
         const memory_desc_t *memory_desc, engine_t *engine) {
     bool args_ok = !any_null(memory_pd, memory_desc, engine)
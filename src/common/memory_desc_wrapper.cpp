@@ -17,6 +17,7 @@
 #include <assert.h>
 #include "mkldnn_types.h"
 
+#include "bcsr.hpp"
 #include "c_types_map.hpp"
 #include "memory_desc_wrapper.hpp"
 #include "memory_pd.hpp"
@@ -778,6 +779,24 @@ status_t memory_desc_wrapper::compute_blocking(memory_desc_t &memory_desc)
     return invalid_arguments;
 }
 
+status_t memory_desc_wrapper::compute_bcsr(memory_desc_t &memory_desc,
+        int oc_block, int k_block)
+{
+    const int ndims = memory_desc.ndims;
+    if (ndims < 2 || memory_desc.format != bcsr_fmt
+            || memory_desc.data_type != data_type::f32
+            || oc_block <= 0 || k_block <= 0)
+        return invalid_arguments;
+
+    bcsr_data_t &bd = memory_desc.layout_desc.bcsr_desc;
+    bd.oc = memory_desc.dims[0];
+    bd.k = array_product(&memory_desc.dims[1], ndims - 1);
+    bd.oc_block = oc_block;
+    bd.k_block = k_block;
+    bd.size = bcsr_layout_t(bd).size;
+    return success;
+}
+
 }
 }
 
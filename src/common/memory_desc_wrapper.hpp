@@ -46,12 +46,16 @@ struct memory_desc_wrapper: public c_compatible {
     memory_format_t format() const { return _md->format; }
     bool is_blocking_desc() const {
         return (format() != memory_format::wino_fmt
+                && format() != memory_format::bcsr_fmt
                 && format() != memory_format::any
                 && format() != memory_format::undef);
     }
     bool is_wino_desc() const {
         return (format() == memory_format::wino_fmt);
     }
+    bool is_bcsr_desc() const {
+        return (format() == memory_format::bcsr_fmt);
+    }
     const blocking_desc_t &blocking_desc() const {
         assert(is_blocking_desc());
         return _md->layout_desc.blocking;
@@ -60,6 +64,10 @@ struct memory_desc_wrapper: public c_compatible {
         assert(is_wino_desc());
         return _md->layout_desc.wino_desc;
     }
+    const bcsr_data_t &bcsr_desc() const {
+        assert(is_bcsr_desc());
+        return _md->layout_desc.bcsr_desc;
+    }
 
     /* some useful function */
 
@@ -91,11 +99,14 @@ struct memory_desc_wrapper: public c_compatible {
         assert((false
                     || types::format_normalize(format()) == blocked
                     || types::is_format_double_blocked(format())
-                    || format() == wino_fmt)
+                    || format() == wino_fmt
+                    || format() == bcsr_fmt)
                 && "unknown format");
 
         if (format() == wino_fmt) {
             return wino_desc().size;
+        } else if (format() == bcsr_fmt) {
+            return bcsr_desc().size;
         } else {
             if (blocking_desc().offset_padding != 0) return 0;
 
@@ -262,6 +273,10 @@ struct memory_desc_wrapper: public c_compatible {
     /* TODO: replace with non-static, once _md becomes non-const ref */
 
     static status_t compute_blocking(memory_desc_t &memory_desc);
+    /** fills the bcsr_desc of \param memory_desc (format bcsr_fmt), with
+     * blocks of \param oc_block x \param k_block */
+    static status_t compute_bcsr(memory_desc_t &memory_desc, int oc_block,
+            int k_block);
 
 private:
     /* TODO: put logical_offset in utils */
@@ -304,12 +319,16 @@ inline bool memory_desc_wrapper::operator==(const memory_desc_wrapper &rhs)
             && utils::array_cmp(dims(), rhs.dims(), ndims())
             && data_type() == rhs.data_type()
             && ((is_blocking_desc() && rhs.is_blocking_desc())
-                       || (is_wino_desc() && rhs.is_wino_desc()))
+                       || (is_wino_desc() && rhs.is_wino_desc())
+                       || (is_bcsr_desc() && rhs.is_bcsr_desc()))
             && (is_blocking_desc() ? blocking_desc_is_equal(blocking_desc(),
                                              rhs.blocking_desc(), ndims()) :
                                      true)
             && (is_wino_desc() ? wino_desc_is_equal(
                                          wino_desc(), rhs.wino_desc()) :
+                                 true)
+            && (is_bcsr_desc() ? bcsr_desc_is_equal(
+                                         bcsr_desc(), rhs.bcsr_desc()) :
                                  true);
 }
 
@@ -319,7 +338,8 @@ inline bool memory_desc_wrapper::similar_to(const memory_desc_wrapper &rhs,
     using namespace utils;
     if (utils::one_of(format(), memory_format::undef, memory_format::any))
         return false;
-    if (is_wino_desc() || rhs.is_wino_desc())
+    if (is_wino_desc() || rhs.is_wino_desc()
+            || is_bcsr_desc() || rhs.is_bcsr_desc())
         return false;
 
     const int ds = dim_start;
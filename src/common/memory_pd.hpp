@@ -119,6 +119,20 @@ struct concat_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return n_; }
     virtual int n_outputs() const override { return 1; }
     virtual int concat_dim() const { return concat_dim_; }
+
+    /** the slot of the @p index-th input in the destination */
+    virtual const memory_pd_t *src_image_pd(int index = 0) const
+    { return nullptr; }
+
+    virtual status_t query(query_t what, int idx, void *result) const override
+    {
+        if (what != query::src_image_pd)
+            return primitive_desc_t::query(what, idx, result);
+        const memory_pd_t *pd = src_image_pd(idx);
+        if (pd == nullptr) return status::not_required;
+        *(const primitive_desc_t **)result = pd;
+        return status::success;
+    }
 protected:
     int n_, concat_dim_;
 };
@@ -138,6 +152,10 @@ struct sum_pd_t: public primitive_desc_t {
     { return index == 0 ? dst_pd() : nullptr; }
     virtual int n_inputs() const override { return n_; }
     virtual int n_outputs() const override { return 1; }
+    virtual double flops() const override {
+        /* scale and accumulate every input */
+        return (2. * n_ - 1) * memory_desc_wrapper(dst_pd()->desc()).nelems();
+    }
 protected:
     int n_;
 };
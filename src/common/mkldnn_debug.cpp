@@ -52,6 +52,7 @@ const char *mkldnn_dt2str(mkldnn_data_type_t v) {
     if (v == mkldnn_s16) return "s16";
     if (v == mkldnn_s8) return "s8";
     if (v == mkldnn_u8) return "u8";
+    if (v == mkldnn_bf16) return "bf16";
     LASSERT(!"unknown dt");
     return "unknown dt";
 }
@@ -143,6 +144,7 @@ const char *mkldnn_fmt2str(mkldnn_memory_format_t v) {
     if (v == mkldnn_ldgoi_p) return "ldgoi_p";
     if (v == mkldnn_ldgo) return "ldgo";
     if (v == mkldnn_wino_fmt) return "wino_fmt";
+    if (v == mkldnn_bcsr_fmt) return "bcsr_fmt";
     if (v == mkldnn_format_last) return "format_last";
     // alias for nChw8c : if (v == mkldnn_oIhw8i) return "oIhw8i";
     // alias for nChw16c : if (v == mkldnn_oIhw16i) return "oIhw16i";
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef OFFSET_CALC_HPP
+#define OFFSET_CALC_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "memory_desc_wrapper.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** memory_desc_wrapper with an off() for the per element loops of the
+ * reference kernels.
+ *
+ * The offset of a blocking layout is a sum of per dimension terms
+ * (p / blk) * stride + in_blk(p % blk), the double-blocked weights formats
+ * included: their fix-ups only change in_blk(). The constructor takes the
+ * outer strides and tabulates in_blk() once (from off_v() itself, so both
+ * always agree); with the power-of-2 blocks of the library formats an
+ * offset is then a shift, a mask, a table load and a multiply-add per
+ * dimension instead of a division and a modulo. Anything else (larger or
+ * odd blocks, offset_padding_to_data) falls back to off_v(). */
+struct offset_calc_t: public memory_desc_wrapper {
+    enum { max_blk = 16 };
+
+    offset_calc_t(const memory_desc_wrapper &md)
+        : memory_desc_wrapper(md), fallback_(false), base_(0)
+    {
+        if (md._md == nullptr || !md.is_blocking_desc()) {
+            fallback_ = true;
+            return;
+        }
+
+        const blocking_desc_t &blk = md.blocking_desc();
+        dims_t pos;
+        utils::array_set(pos, 0, TENSOR_MAX_DIMS);
+        base_ = md.off_v(pos);
+
+        for (int d = 0; d < ndims(); ++d) {
+            const int b = blk.block_dims[d];
+            fallback_ = fallback_ || b > max_blk || (b & (b - 1)) != 0
+                || blk.offset_padding_to_data[d] != 0;
+        }
+        if (fallback_) return;
+
+        for (int d = 0; d < ndims(); ++d) {
+            const int b = blk.block_dims[d];
+            int shift = 0;
+            while ((1 << shift) < b) ++shift;
+            shift_[d] = shift;
+            mask_[d] = b - 1;
+            stride_[d] = blk.strides[0][d];
+            for (int i = 0; i < b; ++i) {
+                pos[d] = i;
+                in_blk_[d][i] = (int)(md.off_v(pos) - base_);
+            }
+            pos[d] = 0;
+        }
+    }
+
+    /** returns physical offset by logical one. logical offset is represented by
+     * a tuple of indices (\c xn, ..., \c x1, \c x0) */
+    template <typename... Args> inline size_t off(Args... args) const {
+        assert(sizeof...(args) == (size_t)ndims());
+        const int pos[] = { (int)args... };
+        if (fallback_) {
+            dims_t p;
+            utils::array_set(p, 0, TENSOR_MAX_DIMS);
+            for (int d = 0; d < (int)sizeof...(args); ++d) p[d] = pos[d];
+            return off_v(p);
+        }
+        ptrdiff_t phys_offset = base_;
+        for (int d = 0; d < (int)sizeof...(args); ++d)
+            phys_offset += (ptrdiff_t)(pos[d] >> shift_[d]) * stride_[d]
+                + in_blk_[d][pos[d] & mask_[d]];
+        return (size_t)phys_offset;
+    }
+
+    /** the part of the offset contributed by coordinate \p p of dimension
+     * \p d: off(..., p, ...) == off(..., 0, ...) + dim_off(d, p) */
+    inline ptrdiff_t dim_off(int d, int p) const {
+        if (fallback_) {
+            dims_t pos;
+            utils::array_set(pos, 0, TENSOR_MAX_DIMS);
+            pos[d] = p;
+            return (ptrdiff_t)off_v(pos) - base_;
+        }
+        return (ptrdiff_t)(p >> shift_[d]) * stride_[d]
+            + in_blk_[d][p & mask_[d]];
+    }
+
+private:
+    bool fallback_;
+    ptrdiff_t base_;
+    int shift_[TENSOR_MAX_DIMS];
+    int mask_[TENSOR_MAX_DIMS];
+    ptrdiff_t stride_[TENSOR_MAX_DIMS];
+    int in_blk_[TENSOR_MAX_DIMS][max_blk];
+};
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
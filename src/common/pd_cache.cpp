@@ -0,0 +1,175 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+
+#include "memory_desc_wrapper.hpp"
+#include "mkldnn_traits.hpp"
+#include "pd_cache.hpp"
+#include "primitive_attr.hpp"
+#include "primitive_desc.hpp"
+#include "verbose.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+pd_cache_t::~pd_cache_t() {
+    for (auto &e: lru_)
+        delete e.second;
+}
+
+size_t pd_cache_t::capacity_from_env() {
+    const int len = 16;
+    char val[len] = {0};
+    if (mkldnn_getenv(val, "MKLDNN_PD_CACHE_CAPACITY", len) > 0)
+        return (size_t)atol(val);
+    return default_capacity;
+}
+
+primitive_desc_t *pd_cache_t::get(const key_t &key) {
+    if (!enabled()) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    primitive_desc_t *pd = it->second->second;
+    if (mkldnn_verbose()->level >= 2) {
+        printf("mkldnn_verbose,pd_cache,hit,%s,hits:%zu,misses:%zu\n",
+                pd->info(), hits_, misses_);
+        fflush(0);
+    }
+    return pd->clone();
+}
+
+void pd_cache_t::put(const key_t &key, const primitive_desc_t *pd) {
+    if (!enabled()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (map_.find(key) != map_.end())
+        return; /* another thread was faster */
+
+    primitive_desc_t *pd_copy = pd->clone();
+    if (pd_copy == nullptr) return;
+
+    lru_.push_front(std::make_pair(key, pd_copy));
+    map_[key] = lru_.begin();
+    if (mkldnn_verbose()->level >= 2) {
+        printf("mkldnn_verbose,pd_cache,miss,%s,hits:%zu,misses:%zu\n",
+                pd->info(), hits_, misses_);
+        fflush(0);
+    }
+
+    if (lru_.size() > capacity_) {
+        auto &last = lru_.back();
+        map_.erase(last.first);
+        delete last.second;
+        lru_.pop_back();
+    }
+}
+
+size_t pd_cache_t::size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+void pd_cache_key_append(pd_cache_t::key_t &key, const void *data,
+        size_t size) {
+    key.append(reinterpret_cast<const char *>(data), size);
+}
+
+void pd_cache_key_append_md(pd_cache_t::key_t &key, const memory_desc_t &md) {
+    /* only the meaningful fields: unused tails of the arrays are not
+     * guaranteed to be initialized */
+    const int ndims = md.ndims;
+    pd_cache_key_append(key, ndims);
+    pd_cache_key_append(key, md.dims, ndims * sizeof(md.dims[0]));
+    pd_cache_key_append(key, md.data_type);
+    pd_cache_key_append(key, md.format);
+
+    memory_desc_wrapper mdw(md);
+    if (mdw.is_wino_desc()) {
+        pd_cache_key_append(key, md.layout_desc.wino_desc);
+    } else if (mdw.is_bcsr_desc()) {
+        pd_cache_key_append(key, md.layout_desc.bcsr_desc);
+    } else if (mdw.is_blocking_desc()) {
+        const blocking_desc_t &blk = md.layout_desc.blocking;
+        for (int d = 0; d < ndims; ++d) {
+            pd_cache_key_append(key, blk.block_dims[d]);
+            pd_cache_key_append(key, blk.strides[0][d]);
+            pd_cache_key_append(key, blk.strides[1][d]);
+            pd_cache_key_append(key, blk.padding_dims[d]);
+            pd_cache_key_append(key, blk.offset_padding_to_data[d]);
+        }
+        pd_cache_key_append(key, blk.offset_padding);
+    }
+}
+
+void pd_cache_key_append_attr(pd_cache_t::key_t &key,
+        const primitive_attr_t *attr) {
+    pd_cache_key_append(key, attr->round_mode_);
+
+    const scales_t &os = attr->output_scales_;
+    pd_cache_key_append(key, os.count_);
+    pd_cache_key_append(key, os.mask_);
+    pd_cache_key_append(key, os.scales_, os.count_ * sizeof(os.scales_[0]));
+
+    const post_ops_t &po = attr->post_ops_;
+    pd_cache_key_append(key, po.len_);
+    for (int i = 0; i < po.len_; ++i) {
+        const auto &e = po.entry_[i];
+        pd_cache_key_append(key, e.kind);
+        if (e.kind == primitive_kind::sum) {
+            pd_cache_key_append(key, e.sum.scale);
+        } else if (e.kind == primitive_kind::eltwise) {
+            pd_cache_key_append(key, e.eltwise.alg);
+            pd_cache_key_append(key, e.eltwise.scale);
+            pd_cache_key_append(key, e.eltwise.alpha);
+            pd_cache_key_append(key, e.eltwise.beta);
+        }
+    }
+}
+
+bool pd_cache_key_append_op_desc(pd_cache_t::key_t &key,
+        const op_desc_t *op_desc) {
+    using namespace primitive_kind;
+    size_t size = 0;
+    switch (op_desc->kind) {
+#   define CASE(pkind) \
+    case pkind: size = sizeof(pkind_traits<pkind>::desc_type); break
+    CASE(convolution);
+    CASE(deconvolution);
+    CASE(eltwise);
+    CASE(softmax);
+    CASE(pooling);
+    CASE(lrn);
+    CASE(batch_normalization);
+    CASE(inner_product);
+    CASE(convolution_relu);
+    CASE(rnn);
+#   undef CASE
+    default: return false;
+    }
+    pd_cache_key_append(key, op_desc, size);
+    return true;
+}
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
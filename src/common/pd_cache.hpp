@@ -0,0 +1,100 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PD_CACHE_HPP
+#define PD_CACHE_HPP
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Thread-safe, size-bounded LRU cache of primitive descriptors.
+ *
+ * Keys are opaque byte strings built (with the pd_cache_key_* helpers) from
+ * everything the primitive descriptor creation depends on. The cache owns
+ * its entries: put() stores a clone, get() returns a clone that the caller
+ * owns. A cache of capacity 0 is disabled.
+ *
+ * The capacity is taken from the MKLDNN_PD_CACHE_CAPACITY environment
+ * variable (default: pd_cache_t::default_capacity). With MKLDNN_VERBOSE=2
+ * every hit and every newly cached entry is reported together with the
+ * hit/miss counters. */
+struct pd_cache_t: public c_compatible {
+    typedef std::string key_t;
+
+    enum { default_capacity = 1024 };
+
+    pd_cache_t(): pd_cache_t(capacity_from_env()) {}
+    pd_cache_t(size_t capacity): capacity_(capacity), hits_(0), misses_(0) {}
+    ~pd_cache_t();
+
+    size_t capacity() const { return capacity_; }
+    bool enabled() const { return capacity_ != 0; }
+
+    /** returns a clone of the cached primitive descriptor or nullptr */
+    primitive_desc_t *get(const key_t &key);
+    /** caches a clone of @p pd, evicting the least recently used entry if
+     * the cache is full */
+    void put(const key_t &key, const primitive_desc_t *pd);
+
+    size_t size();
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+private:
+    static size_t capacity_from_env();
+
+    typedef std::list<std::pair<key_t, primitive_desc_t *>> lru_list_t;
+
+    size_t capacity_;
+    size_t hits_, misses_;
+    lru_list_t lru_; /* most recently used first */
+    std::unordered_map<key_t, lru_list_t::iterator> map_;
+    std::mutex mutex_;
+
+    pd_cache_t(const pd_cache_t &) = delete;
+    pd_cache_t &operator=(const pd_cache_t &) = delete;
+};
+
+/* key builders */
+void pd_cache_key_append(pd_cache_t::key_t &key, const void *data,
+        size_t size);
+void pd_cache_key_append_md(pd_cache_t::key_t &key, const memory_desc_t &md);
+void pd_cache_key_append_attr(pd_cache_t::key_t &key,
+        const primitive_attr_t *attr);
+/** appends the op descriptor bytes; returns false for op descriptors of
+ * unknown size, which should not be cached */
+bool pd_cache_key_append_op_desc(pd_cache_t::key_t &key,
+        const op_desc_t *op_desc);
+
+template <typename T>
+inline void pd_cache_key_append(pd_cache_t::key_t &key, const T &val)
+{ pd_cache_key_append(key, &val, sizeof(val)); }
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -55,6 +55,11 @@ struct pooling_fwd_pd_t: public primitive_desc_t {
     virtual int n_outputs() const override
     { return 1 + (workspace_pd() != nullptr); }
 
+    virtual double flops() const override {
+        return (double)memory_desc_wrapper(desc_.dst_desc).nelems()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -141,6 +146,11 @@ struct pooling_bwd_pd_t: public primitive_desc_t {
     { return 1 + (workspace_pd() != nullptr); }
     virtual int n_outputs() const override { return 1; }
 
+    virtual double flops() const override {
+        return (double)memory_desc_wrapper(desc_.diff_dst_desc).nelems()
+            * KD() * KH() * KW();
+    }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
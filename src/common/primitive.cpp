@@ -20,6 +20,8 @@
 #include "primitive_desc.hpp"
 #include "primitive.hpp"
 #include "engine.hpp"
+#include "event.hpp"
+#include "exec_args.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
@@ -27,6 +29,8 @@ using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
 using namespace mkldnn::impl::primitive_kind;
 
+THREAD_LOCAL const exec_args_t *exec_args_t::current_ = nullptr;
+
 status_t mkldnn_primitive_desc_destroy(primitive_desc_t *primitive_desc) {
     if (primitive_desc) delete primitive_desc;
     return success;
@@ -80,6 +84,33 @@ status_t mkldnn_primitive_get_output(const primitive_t *primitive,
     return success;
 }
 
+status_t mkldnn_primitive_execute(primitive_t *primitive, int nargs,
+        const exec_arg_t *args) {
+    if (primitive == nullptr || nargs < 0 || (nargs > 0 && args == nullptr))
+        return invalid_arguments;
+    if (utils::one_of(primitive->kind(), memory, view))
+        return invalid_arguments;
+    for (int i = 0; i < nargs; ++i) {
+        const auto m = args[i].memory;
+        const bool ok = true
+            && m != nullptr
+            && args[i].handle != nullptr
+            && m->kind() == memory
+            && m->engine() == primitive->engine();
+        if (!ok)
+            return invalid_arguments;
+    }
+
+    exec_args_t bindings(nargs, args);
+    event_t e;
+    nstl::vector<event_t *> prerequisites;
+    status_t status = primitive->engine()->submit(primitive, &e,
+            prerequisites);
+    if (status != success)
+        return status;
+    return e.get_state() == event_t::ready ? success : runtime_error;
+}
+
 status_t mkldnn_primitive_destroy(primitive_t *primitive) {
     if (primitive != nullptr)
         delete primitive;
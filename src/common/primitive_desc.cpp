@@ -25,6 +25,15 @@
 using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
 
+double primitive_desc_t::bytes() const {
+    double b = 0;
+    for (int i = 0; i < n_inputs(); ++i)
+        if (input_pd(i)) b += input_pd(i)->get_size();
+    for (int i = 0; i < n_outputs(); ++i)
+        if (output_pd(i)) b += output_pd(i)->get_size();
+    return b;
+}
+
 status_t primitive_desc_t::query(query_t what, int idx, void *result) const {
     auto safe_ret_pd = [&](const memory_pd_t *_) {
         if (_ == nullptr) return not_required;
@@ -53,6 +62,9 @@ status_t primitive_desc_t::query(query_t what, int idx, void *result) const {
 
         case query::impl_info_str: *(const char **)result = name(); break;
 
+        case query::flops_f64: *(double *)result = flops(); break;
+        case query::bytes_f64: *(double *)result = bytes(); break;
+
         default: return unimplemented;
     }
     return success;
@@ -23,6 +23,7 @@
 #include "nstl.hpp"
 #include "type_helpers.hpp"
 #include "primitive_attr.hpp"
+#include "profiling.hpp"
 #include "verbose.hpp"
 
 struct mkldnn_primitive_desc: public mkldnn::impl::c_compatible {
@@ -66,6 +67,13 @@ struct mkldnn_primitive_desc: public mkldnn::impl::c_compatible {
     virtual int n_inputs() const { return 0; }
     virtual int n_outputs() const { return 0; }
 
+    /** analytic number of arithmetic operations performed by one execution
+     * (0 if unknown or if the primitive only moves data) */
+    virtual double flops() const { return 0; }
+    /** number of bytes read and written by one execution: the sizes of all
+     * the input and output memories */
+    double bytes() const;
+
     virtual mkldnn::impl::status_t query(mkldnn::impl::query_t what, int idx,
             void *result) const;
 
@@ -122,6 +130,8 @@ protected:
             printf("mkldnn_verbose,create,%s,%g\n", this->info(), ms); \
             fflush(0); \
         } \
+        if (profiling_enabled()) \
+            profiling_record(mkldnn_profiling_create, this, ms); \
         return ret; \
     } \
     virtual const char *name() const override { return impl_name; }
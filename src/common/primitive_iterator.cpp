@@ -17,7 +17,9 @@
 #include <assert.h>
 
 #include "mkldnn.h"
+#include "pd_cache.hpp"
 #include "primitive_iterator.hpp"
+#include "tuning.hpp"
 
 using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
@@ -91,6 +93,32 @@ status_t mkldnn_primitive_desc_create_v2(primitive_desc_t **primitive_desc,
         engine_t *engine, const primitive_desc_t *hint_fwd_pd) {
     const op_desc_t *op_desc = (const op_desc_t *)c_op_desc;
 
+    /* primitive descriptors created with a forward hint may refer to it, so
+     * only the ones without a hint are cached */
+    pd_cache_t *cache = engine->pd_cache();
+    pd_cache_t::key_t key;
+    bool use_cache = true
+        && cache && cache->enabled()
+        && hint_fwd_pd == nullptr
+        && pd_cache_key_append_op_desc(key, op_desc);
+    if (use_cache) {
+        const primitive_attr_t dummy_attr;
+        pd_cache_key_append_attr(key, attr ? attr : &dummy_attr);
+        auto cached_pd = cache->get(key);
+        if (cached_pd) {
+            *primitive_desc = cached_pd;
+            return success;
+        }
+    }
+
+    if (tuning_enabled()) {
+        status_t status = tuned_primitive_desc_create(primitive_desc,
+                op_desc, attr, engine, hint_fwd_pd);
+        if (status == success && use_cache)
+            cache->put(key, *primitive_desc);
+        return status;
+    }
+
     mkldnn_primitive_desc_iterator it(engine, op_desc, attr, hint_fwd_pd);
     ++it;
     if (it == it.end()){
@@ -101,7 +129,10 @@ status_t mkldnn_primitive_desc_create_v2(primitive_desc_t **primitive_desc,
         return unimplemented;
     }
 
-    return safe_ptr_assign<primitive_desc_t>(*primitive_desc, *it);
+    status_t status = safe_ptr_assign<primitive_desc_t>(*primitive_desc, *it);
+    if (status == success && use_cache)
+        cache->put(key, *primitive_desc);
+    return status;
 }
 
 status_t mkldnn_primitive_desc_create(primitive_desc_t **primitive_desc,
@@ -30,7 +30,12 @@ struct mkldnn_primitive_desc_iterator: public mkldnn::impl::c_compatible {
             const mkldnn::impl::primitive_attr_t *attr, const mkldnn::impl::primitive_desc_t *hint_fwd_pd)
         : idx_(-1), engine_(engine), pd_(nullptr), op_desc_(op_desc)
         , attr_(attr ? *attr : mkldnn::impl::primitive_attr_t()), hint_fwd_pd_(hint_fwd_pd)
-        , impl_list_(engine_->get_implementation_list()), last_idx_(0)
+        , impl_list_(engine_->get_kind_implementation_list(
+                    /* the kind is the first field of any op descriptor, which
+                     * may be smaller than op_desc_t */
+                    *reinterpret_cast<const mkldnn::impl::primitive_kind_t *>(
+                        op_desc)))
+        , last_idx_(0)
     {
         while (impl_list_[last_idx_] != nullptr) ++last_idx_;
     }
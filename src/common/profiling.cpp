@@ -0,0 +1,183 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+
+#include <mutex>
+#include <vector>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive_desc.hpp"
+#include "profiling.hpp"
+#include "verbose.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+std::atomic<bool> profiling_on(false);
+
+namespace {
+
+enum { default_capacity = 4096 };
+
+struct profiler_t {
+    profiler_t(): head_(0), count_(0), callback_(nullptr),
+        user_data_(nullptr) {}
+
+    std::mutex mutex_;
+    std::vector<mkldnn_profiling_record_t> ring_;
+    size_t head_; /* the oldest record */
+    size_t count_;
+    mkldnn_profiling_callback_t callback_;
+    void *user_data_;
+
+    void push(const mkldnn_profiling_record_t &r) {
+        if (ring_.empty()) return;
+        const size_t cap = ring_.size();
+        ring_[(head_ + count_) % cap] = r;
+        if (count_ < cap) ++count_;
+        else head_ = (head_ + 1) % cap;
+    }
+
+    const mkldnn_profiling_record_t &at(size_t i) const
+    { return ring_[(head_ + i) % ring_.size()]; }
+};
+
+profiler_t &profiler() {
+    static profiler_t p;
+    return p;
+}
+
+void print_json_str(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+}
+
+void profiling_record(mkldnn_profiling_event_kind_t kind,
+        const primitive_desc_t *pd, double duration_ms) {
+    mkldnn_profiling_record_t r;
+    r.event_kind = kind;
+    r.primitive_kind = pd->kind();
+    snprintf(r.impl_name, sizeof(r.impl_name), "%s", pd->name());
+    snprintf(r.info, sizeof(r.info), "%s", pd->info());
+    r.start_ms = get_msec() - duration_ms;
+    r.duration_ms = duration_ms;
+    r.bytes = pd->bytes();
+    r.flops = pd->flops();
+    r.nthr = omp_get_max_threads();
+
+    profiler_t &p = profiler();
+    mkldnn_profiling_callback_t callback;
+    void *user_data;
+    {
+        std::lock_guard<std::mutex> lock(p.mutex_);
+        p.push(r);
+        callback = p.callback_;
+        user_data = p.user_data_;
+    }
+    if (callback) callback(&r, user_data);
+}
+
+}
+}
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+
+mkldnn_status_t mkldnn_profiling_enable(int enable, size_t capacity) {
+    profiler_t &p = profiler();
+    if (enable) {
+        if (capacity == 0) capacity = default_capacity;
+        std::lock_guard<std::mutex> lock(p.mutex_);
+        if (p.ring_.size() != capacity) {
+            p.ring_.clear();
+            p.ring_.resize(capacity);
+            p.head_ = p.count_ = 0;
+        }
+    }
+    profiling_on.store(enable != 0);
+    return success;
+}
+
+mkldnn_status_t mkldnn_profiling_set_callback(
+        mkldnn_profiling_callback_t callback, void *user_data) {
+    profiler_t &p = profiler();
+    std::lock_guard<std::mutex> lock(p.mutex_);
+    p.callback_ = callback;
+    p.user_data_ = user_data;
+    return success;
+}
+
+mkldnn_status_t mkldnn_profiling_get_records(
+        mkldnn_profiling_record_t *records, size_t *count) {
+    if (count == nullptr) return invalid_arguments;
+    profiler_t &p = profiler();
+    std::lock_guard<std::mutex> lock(p.mutex_);
+    if (records == nullptr) {
+        *count = p.count_;
+        return success;
+    }
+    const size_t n = *count < p.count_ ? *count : p.count_;
+    for (size_t i = 0; i < n; ++i)
+        records[i] = p.at(i);
+    if (n != 0) {
+        p.head_ = (p.head_ + n) % p.ring_.size();
+        p.count_ -= n;
+    }
+    *count = n;
+    return success;
+}
+
+mkldnn_status_t mkldnn_profiling_dump_chrome_trace(const char *path) {
+    if (path == nullptr) return invalid_arguments;
+    FILE *f = fopen(path, "w");
+    if (f == nullptr) return runtime_error;
+
+    profiler_t &p = profiler();
+    std::lock_guard<std::mutex> lock(p.mutex_);
+    fprintf(f, "{\"traceEvents\":[");
+    for (size_t i = 0; i < p.count_; ++i) {
+        const mkldnn_profiling_record_t &r = p.at(i);
+        const bool is_exec = r.event_kind == mkldnn_profiling_exec;
+        /* complete events; timestamps are in microseconds */
+        fprintf(f, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                "\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{"
+                "\"impl\":", i ? "," : "",
+                mkldnn_prim_kind2str(r.primitive_kind),
+                is_exec ? "exec" : "create", 1e3 * r.start_ms,
+                1e3 * r.duration_ms, is_exec ? 0 : 1);
+        print_json_str(f, r.impl_name);
+        fprintf(f, ",\"info\":");
+        print_json_str(f, r.info);
+        fprintf(f, ",\"bytes\":%.0f,\"flops\":%.0f,\"nthr\":%d}}",
+                r.bytes, r.flops, r.nthr);
+    }
+    fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    const bool ok = !ferror(f);
+    fclose(f);
+    return ok ? success : runtime_error;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,48 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PROFILING_HPP
+#define PROFILING_HPP
+
+#include <atomic>
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Profiling records (see mkldnn_profiling_* in mkldnn.h).
+ *
+ * Call sites check profiling_enabled() first, so that disabled profiling
+ * costs a single relaxed load. */
+extern std::atomic<bool> profiling_on;
+
+inline bool profiling_enabled()
+{ return profiling_on.load(std::memory_order_relaxed); }
+
+/** records an event of @p kind of the primitive described by @p pd which
+ * took @p duration_ms and has just finished */
+void profiling_record(mkldnn_profiling_event_kind_t kind,
+        const primitive_desc_t *pd, double duration_ms);
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -20,6 +20,7 @@
 #include "c_types_map.hpp"
 #include "engine.hpp"
 #include "memory_pd.hpp"
+#include "pd_cache.hpp"
 #include "primitive_desc.hpp"
 #include "reorder_pd.hpp"
 #include "type_helpers.hpp"
@@ -60,9 +61,29 @@ status_t mkldnn_reorder_primitive_desc_create_v2(
     if (attr == NULL)
         attr = &dummy_attr;
 
+    /* reorders between the same memory descriptors are typically created
+     * many times (e.g. for every weights update or model load) */
+    pd_cache_t *cache = e->pd_cache();
+    pd_cache_t::key_t key;
+    if (cache && cache->enabled()) {
+        pd_cache_key_append(key, primitive_kind::reorder);
+        pd_cache_key_append(key, input->engine());
+        pd_cache_key_append(key, output->engine());
+        pd_cache_key_append_md(key, *i_mpd->desc());
+        pd_cache_key_append_md(key, *o_mpd->desc());
+        pd_cache_key_append_attr(key, attr);
+        auto cached_pd = cache->get(key);
+        if (cached_pd) {
+            *r_pd = static_cast<reorder_pd_t *>(cached_pd);
+            return success;
+        }
+    }
+
     for (auto r = e->get_reorder_implementation_list(); *r; ++r) {
         if ((*r)(r_pd, i_mpd, o_mpd, attr) == success) {
             (*r_pd)->init_info();
+            if (cache && cache->enabled())
+                cache->put(key, *r_pd);
             return success;
         }
     }
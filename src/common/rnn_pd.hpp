@@ -220,6 +220,9 @@ struct rnn_fwd_pd_t : public rnn_pd_t {
         return 1 + with_dst_iter() + is_training();
     }
 
+    virtual double flops() const override
+    { return 2. * L() * D() * T() * MB() * G() * DIC() * (SLC() + SIC()); }
+
     int ws_idx() const { return 1 + with_dst_iter(); }
 };
 
@@ -269,6 +272,9 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
         return 3 + with_src_iter() + with_bias();
     }
 
+    virtual double flops() const override
+    { return 4. * L() * D() * T() * MB() * G() * DIC() * (SLC() + SIC()); }
+
     int ws_idx() const {
         return 5 + with_src_iter() + with_bias() + 2 * with_dst_iter();
     }
@@ -14,91 +14,82 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <new>
+
 #include "mkldnn_thread.hpp"
 #include "utils.hpp"
 
 #include "scratchpad.hpp"
+#include "ws_pool.hpp"
 
 namespace mkldnn {
 namespace impl {
 
-/* Allocating memory buffers on a page boundary to reduce TLB/page misses */
-const size_t page_size = 2097152;
-
-/*
-  Implementation of the scratchpad_t interface that is compatible with
-  a concurrent execution
-*/
-struct concurent_scratchpad_t : public scratchpad_t {
-    concurent_scratchpad_t(size_t size) {
-        size_ = size;
-        scratchpad_ = (char *) malloc(size, page_size);
-        assert(scratchpad_ != nullptr);
-    }
+namespace {
 
-    ~concurent_scratchpad_t() {
-        free(scratchpad_);
-    }
+/* the buffers borrowed by the calls in progress on this thread */
+struct borrowed_t { const scratchpad_t *owner; char *ptr; borrowed_t *next; };
+THREAD_LOCAL borrowed_t *borrowed_ = nullptr;
+THREAD_LOCAL int scope_depth_ = 0;
 
-    virtual char *get() const {
-        return scratchpad_;
-    }
-
-private:
-    char *scratchpad_;
-    size_t size_;
-};
+}
 
 /*
-  Implementation of the scratchpad_t interface that uses a global
-  scratchpad
+  Implementation of the scratchpad_t interface with per call buffers, that is
+  compatible with a concurrent execution
 */
-
-struct global_scratchpad_t : public scratchpad_t {
-    global_scratchpad_t(size_t size) {
-        if (size > size_) {
-            if (scratchpad_ != nullptr) free(scratchpad_);
-            size_ = size;
-            scratchpad_ = (char *) malloc(size, page_size);
-            assert(scratchpad_ != nullptr);
-        }
-        reference_count_++;
-    }
-
-    ~global_scratchpad_t() {
-        reference_count_--;
-        if (reference_count_ == 0) {
-            free(scratchpad_);
-            scratchpad_ = nullptr;
-            size_ = 0;
+struct call_scratchpad_t : public scratchpad_t {
+    call_scratchpad_t(size_t size): size_(size) {}
+
+    /* a primitive destroyed outside of a scope gives its buffer back */
+    ~call_scratchpad_t() {
+        for (borrowed_t **b = &borrowed_; *b != nullptr; b = &(*b)->next) {
+            if ((*b)->owner != this) continue;
+            borrowed_t *mine = *b;
+            *b = mine->next;
+            ws_pool().put(mine->ptr);
+            delete mine;
+            break;
         }
     }
 
     virtual char *get() const {
-        return scratchpad_;
+        for (borrowed_t *b = borrowed_; b != nullptr; b = b->next)
+            if (b->owner == this) return b->ptr;
+
+        borrowed_t *b = new borrowed_t;
+        b->ptr = (char *)ws_pool().get(size_);
+        if (b->ptr == nullptr) {
+            delete b;
+            throw std::bad_alloc();
+        }
+        b->owner = this;
+        b->next = borrowed_;
+        borrowed_ = b;
+        return b->ptr;
     }
 
 private:
-    THREAD_LOCAL static char *scratchpad_;
-    THREAD_LOCAL static size_t size_;
-    THREAD_LOCAL static unsigned int reference_count_;
-    //OMP(threadprivate(scratchpad_, size_, reference_count_))//;
+    size_t size_;
 };
 
-THREAD_LOCAL char *global_scratchpad_t::scratchpad_ = nullptr;
-THREAD_LOCAL size_t global_scratchpad_t::size_ = 0;
-THREAD_LOCAL unsigned int global_scratchpad_t::reference_count_ = 0;
+scratchpad_scope_t::scratchpad_scope_t() { ++scope_depth_; }
 
+scratchpad_scope_t::~scratchpad_scope_t() {
+    if (--scope_depth_ > 0) return;
+    while (borrowed_ != nullptr) {
+        borrowed_t *b = borrowed_;
+        borrowed_ = b->next;
+        ws_pool().put(b->ptr);
+        delete b;
+    }
+}
 
 /*
    Scratchpad creation routine
 */
 scratchpad_t *create_scratchpad(size_t size) {
-#ifndef MKLDNN_ENABLE_CONCURRENT_EXEC
-    return new global_scratchpad_t(size);
-#else
-    return new concurent_scratchpad_t(size);
-#endif
+    return new call_scratchpad_t(size);
 }
 
 }
@@ -27,8 +27,27 @@ struct scratchpad_t {
     virtual char *get() const = 0;
 };
 
+/** A scratchpad only records its size: get() borrows a buffer from
+ * ws_pool() for the call in progress on the calling thread (every get() of
+ * the call returns the same buffer) and the buffer goes back to the pool
+ * when the call ends. A primitive thus keeps no transient state and may be
+ * executed concurrently from several threads. get() must be called outside
+ * of parallel regions and throws std::bad_alloc if the buffer cannot be
+ * allocated: whoever opens the scope turns it into status::out_of_memory. */
 scratchpad_t *create_scratchpad(size_t size);
 
+/** Delimits a call: the scratchpad buffers borrowed on the calling thread
+ * are given back when the outermost scope ends. Opened around execute() by
+ * the engines and the tuning. */
+struct scratchpad_scope_t {
+    scratchpad_scope_t();
+    ~scratchpad_scope_t();
+
+private:
+    scratchpad_scope_t(const scratchpad_scope_t &) = delete;
+    scratchpad_scope_t &operator=(const scratchpad_scope_t &) = delete;
+};
+
 }
 }
 #endif
@@ -55,6 +55,9 @@ struct softmax_fwd_pd_t: public primitive_desc_t {
     virtual int n_outputs() const override
     { return 1 + (workspace_pd() != nullptr); }
 
+    virtual double flops() const override
+    { return 4. * memory_desc_wrapper(desc_.data_desc).nelems(); }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
@@ -106,6 +109,9 @@ struct softmax_bwd_pd_t: public primitive_desc_t {
     virtual int n_outputs() const override
     { return 1 + (workspace_pd() != nullptr); }
 
+    virtual double flops() const override
+    { return 3. * memory_desc_wrapper(desc_.data_desc).nelems(); }
+
     virtual status_t query(query_t what, int idx, void *result) const override
     {
         switch (what) {
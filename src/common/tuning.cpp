@@ -0,0 +1,257 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "event.hpp"
+#include "memory_pd.hpp"
+#include "nstl.hpp"
+#include "primitive.hpp"
+#include "primitive_desc.hpp"
+#include "primitive_iterator.hpp"
+#include "scratchpad.hpp"
+#include "tuning.hpp"
+#include "utils.hpp"
+#include "verbose.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+using namespace mkldnn::impl::status;
+
+namespace {
+
+struct tuning_db_t {
+    tuning_db_t() {
+        const int len = 1024;
+        char path[len] = {0};
+        if (mkldnn_getenv(path, "MKLDNN_TUNING_DB", len) > 0)
+            path_ = path;
+        load();
+    }
+
+    bool find(const std::string &problem, std::string &impl) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = db_.find(problem);
+        if (it == db_.end()) return false;
+        impl = it->second;
+        return true;
+    }
+
+    void add(const std::string &problem, const std::string &impl) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        db_[problem] = impl;
+        if (path_.empty()) return;
+        FILE *f = fopen(path_.c_str(), "a");
+        if (f == nullptr) return;
+        fprintf(f, "%s\t%s\n", problem.c_str(), impl.c_str());
+        fclose(f);
+    }
+
+private:
+    void load() {
+        if (path_.empty()) return;
+        FILE *f = fopen(path_.c_str(), "r");
+        if (f == nullptr) return;
+        /* later lines override earlier ones */
+        char line[MKLDNN_VERBOSE_BUF_LEN + 128];
+        while (fgets(line, sizeof(line), f)) {
+            char *tab = strchr(line, '\t');
+            if (tab == nullptr) continue;
+            *tab = '\0';
+            char *impl = tab + 1;
+            impl[strcspn(impl, "\r\n")] = '\0';
+            if (*line && *impl) db_[line] = impl;
+        }
+        fclose(f);
+    }
+
+    std::mutex mutex_;
+    std::map<std::string, std::string> db_;
+    std::string path_;
+};
+
+tuning_db_t &tuning_db() {
+    static tuning_db_t db;
+    return db;
+}
+
+/** the info() string without the implementation name (the second field) */
+std::string problem_str(const primitive_desc_t *pd) {
+    const std::string info = pd->info();
+    const size_t b = info.find(',');
+    const size_t e = b == std::string::npos
+        ? std::string::npos : info.find(',', b + 1);
+    if (e == std::string::npos) return info;
+    return info.substr(0, b) + info.substr(e);
+}
+
+/** runs the primitive described by @p pd on zero-filled buffers and returns
+ * the best time (in ms) out of a few runs, or a negative value if the
+ * primitive could not be run */
+double time_candidate(const primitive_desc_t *pd) {
+    enum { n_runs_max = 5 };
+    const double budget_ms = 100.;
+
+    nstl::vector<primitive_t *> mems;
+    nstl::vector<void *> bufs;
+    nstl::vector<primitive_at_t> inputs;
+    nstl::vector<const primitive_t *> outputs;
+
+    auto make_memory = [&](const memory_pd_t *mpd) -> primitive_t * {
+        primitive_t *m = nullptr;
+        if (mpd == nullptr
+                || mpd->create_primitive(&m, nullptr, nullptr) != success)
+            return nullptr;
+        mems.push_back(m);
+        const size_t size = mpd->get_size();
+        if (size != 0) {
+            void *buf = impl::malloc(size, 64);
+            if (buf == nullptr) return nullptr;
+            bufs.push_back(buf);
+            memset(buf, 0, size);
+            m->set_data_handle(buf);
+        }
+        return m;
+    };
+
+    double best_ms = -1.;
+    bool ok = true;
+    for (int i = 0; i < pd->n_inputs() && ok; ++i) {
+        primitive_t *m = make_memory(pd->input_pd(i));
+        ok = m != nullptr;
+        inputs.push_back(primitive_at_t{m, 0});
+    }
+    for (int i = 0; i < pd->n_outputs() && ok; ++i) {
+        primitive_t *m = make_memory(pd->output_pd(i));
+        ok = m != nullptr;
+        outputs.push_back(m);
+    }
+
+    primitive_t *p = nullptr;
+    if (ok && pd->create_primitive(&p, inputs.size() ? &inputs[0] : nullptr,
+                outputs.size() ? &outputs[0] : nullptr) == success) {
+        /* one call per scope, as in cpu_engine_t::submit(), so that the
+         * scratchpad buffers go back to the pool between the runs */
+        auto run = [&](double &ms) -> bool {
+            event_t e;
+            scratchpad_scope_t scratchpad_scope;
+            ms = get_msec();
+            try {
+                p->execute(&e);
+            } catch (const std::bad_alloc &) {
+                return false;
+            }
+            ms = get_msec() - ms;
+            return e.get_state() == event_t::ready;
+        };
+
+        double ms = 0.;
+        if (run(ms)) { /* warm-up */
+            double total_ms = 0.;
+            for (int r = 0; r < n_runs_max && total_ms < budget_ms; ++r) {
+                if (!run(ms)) { best_ms = -1.; break; }
+                total_ms += ms;
+                if (best_ms < 0. || ms < best_ms) best_ms = ms;
+            }
+        }
+    }
+
+    delete p;
+    for (size_t i = 0; i < mems.size(); ++i) delete mems[i];
+    for (size_t i = 0; i < bufs.size(); ++i) impl::free(bufs[i]);
+
+    return best_ms;
+}
+
+}
+
+bool tuning_enabled() {
+    /* the static initialization is thread-safe */
+    static const bool enabled = []() {
+        const int len = 2;
+        char val[len] = {0};
+        return mkldnn_getenv(val, "MKLDNN_TUNING", len) == 1
+            && atoi(val) != 0;
+    }();
+    return enabled;
+}
+
+status_t tuned_primitive_desc_create(primitive_desc_t **primitive_desc,
+        const op_desc_t *op_desc, const primitive_attr_t *attr,
+        engine_t *engine, const primitive_desc_t *hint_fwd_pd) {
+    nstl::vector<primitive_desc_t *> candidates;
+    {
+        primitive_desc_iterator_t it(engine, op_desc, attr, hint_fwd_pd);
+        for (++it; it != it.end(); ++it)
+            candidates.push_back(*it);
+    }
+    if (candidates.size() == 0) return unimplemented;
+
+    size_t best = 0;
+    if (candidates.size() > 1) {
+        const std::string problem = problem_str(candidates[0]);
+        std::string impl;
+        bool known = false;
+        if (tuning_db().find(problem, impl)) {
+            for (size_t c = 0; c < candidates.size() && !known; ++c) {
+                if (impl == candidates[c]->name()) {
+                    best = c;
+                    known = true;
+                }
+            }
+        }
+
+        if (!known) {
+            double best_ms = -1.;
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                const double ms = time_candidate(candidates[c]);
+                if (mkldnn_verbose()->level >= 2) {
+                    printf("mkldnn_verbose,tune,%s,%g\n",
+                            candidates[c]->info(), ms);
+                    fflush(0);
+                }
+                if (ms >= 0. && (best_ms < 0. || ms < best_ms)) {
+                    best = c;
+                    best_ms = ms;
+                }
+            }
+            if (best_ms >= 0.)
+                tuning_db().add(problem, candidates[best]->name());
+        }
+    }
+
+    for (size_t c = 0; c < candidates.size(); ++c)
+        if (c != best) delete candidates[c];
+    *primitive_desc = candidates[best];
+    return success;
+}
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef TUNING_HPP
+#define TUNING_HPP
+
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Empirical selection of implementations (opt-in).
+ *
+ * With MKLDNN_TUNING=1 primitive descriptor creation does not take the first
+ * applicable implementation: every applicable implementation is executed on
+ * synthetic (zero) data for the requested problem and the fastest one wins.
+ *
+ * Decisions are keyed by the verbose problem string (the info() of the first
+ * candidate without the implementation name) and are kept in a tuning
+ * database. If MKLDNN_TUNING_DB names a file, decisions are loaded from it
+ * on first use and every new decision is appended to it, one
+ * "<problem>\t<implementation>" line per decision.
+ *
+ * With MKLDNN_VERBOSE=2 the time of every candidate is reported. */
+bool tuning_enabled();
+
+status_t tuned_primitive_desc_create(primitive_desc_t **primitive_desc,
+        const op_desc_t *op_desc, const primitive_attr_t *attr,
+        engine_t *engine, const primitive_desc_t *hint_fwd_pd);
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -55,6 +55,7 @@ ISSPEC(int8_t, int32_t);
 ISSPEC(uint8_t, int32_t);
 ISSPEC(int8_t, int16_t);
 ISSPEC(uint8_t, int16_t);
+ISSPEC(bfloat16_t, float);
 #undef ISSPEC
 
 namespace types {
@@ -67,6 +68,7 @@ inline size_t data_type_size(data_type_t data_type) {
     case s16: return sizeof(prec_traits<s16>::type);
     case s8: return sizeof(prec_traits<s8>::type);
     case u8: return sizeof(prec_traits<u8>::type);
+    case bf16: return sizeof(prec_traits<bf16>::type);
     case data_type::undef:
     default: assert(!"unknown data_type");
     }
@@ -199,6 +201,14 @@ inline bool wino_desc_is_equal(const wino_data_t &lhs,
         && lhs.r == rhs.r;
 }
 
+inline bool bcsr_desc_is_equal(const bcsr_data_t &lhs,
+    const bcsr_data_t &rhs) {
+    return lhs.oc == rhs.oc
+        && lhs.k == rhs.k
+        && lhs.oc_block == rhs.oc_block
+        && lhs.k_block == rhs.k_block;
+}
+
 inline bool operator==(const memory_desc_t &lhs, const memory_desc_t &rhs) {
     assert(lhs.primitive_kind == mkldnn::impl::primitive_kind::memory);
     assert(rhs.primitive_kind == mkldnn::impl::primitive_kind::memory);
@@ -214,6 +224,9 @@ inline bool operator==(const memory_desc_t &lhs, const memory_desc_t &rhs) {
     else if (lhs.format == memory_format::wino_fmt)
         return wino_desc_is_equal(lhs.layout_desc.wino_desc,
             rhs.layout_desc.wino_desc);
+    else if (lhs.format == memory_format::bcsr_fmt)
+        return bcsr_desc_is_equal(lhs.layout_desc.bcsr_desc,
+            rhs.layout_desc.bcsr_desc);
     return true;
 }
 
@@ -253,6 +266,7 @@ inline data_type_t default_accum_data_type(data_type_t src_dt,
     using namespace data_type;
 
     if (one_of(f32, src_dt, dst_dt)) return f32;
+    if (one_of(bf16, src_dt, dst_dt)) return f32;
     if (one_of(s32, src_dt, dst_dt)) return s32;
     if (one_of(s16, src_dt, dst_dt)) return s32;
 
@@ -270,6 +284,11 @@ inline data_type_t default_accum_data_type(data_type_t src_dt,
 
     /* prop_kind doesn't matter */
     if (everyone_is(f32, src_dt, wei_dt, dst_dt)) return f32;
+    /* bf16 inputs (and possibly an f32 output) accumulate in f32 */
+    if (one_of(bf16, src_dt, wei_dt, dst_dt)
+            && everyone_is(true, one_of(src_dt, bf16, f32),
+                one_of(wei_dt, bf16, f32), one_of(dst_dt, bf16, f32)))
+        return f32;
 
     if (one_of(prop_kind, forward_training, forward_inference)) {
         if (src_dt == s16 && wei_dt == s16 && dst_dt == s32)
@@ -25,6 +25,7 @@
 #include "xmmintrin.h"
 #endif
 
+#include "mem_policy.hpp"
 #include "utils.hpp"
 
 namespace mkldnn {
@@ -122,7 +123,8 @@ void restore_rnd_mode() {
 #endif
 
 void *malloc(size_t size, int alignment) {
-    void *ptr;
+    void *ptr = mem_policy_malloc(size, alignment);
+    if (ptr != nullptr) return ptr;
 
 #ifdef _WIN32
     ptr = _aligned_malloc(size, alignment);
@@ -135,6 +137,7 @@ void *malloc(size_t size, int alignment) {
 }
 
 void free(void *p) {
+    if (mem_policy_free(p)) return;
 #ifdef _WIN32
     _aligned_free(p);
 #else
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+
+#include "nstl.hpp"
+#include "ws_pool.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+ws_pool_t::~ws_pool_t() {
+    for (auto &e: idle_)
+        free(e.second);
+}
+
+size_t ws_pool_t::capacity_from_env() {
+    const int len = 24;
+    char val[len] = {0};
+    if (mkldnn_getenv(val, "MKLDNN_WS_POOL_CAPACITY", len) > 0)
+        return (size_t)atoll(val);
+    return default_capacity;
+}
+
+void *ws_pool_t::get(size_t size) {
+    size = utils::rnd_up(nstl::max(size, (size_t)1), (size_t)alignment);
+    if (!enabled()) return malloc(size, alignment);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = idle_.lower_bound(size);
+        if (it != idle_.end() && it->first <= 2 * size) {
+            void *ptr = it->second;
+            busy_[ptr] = it->first;
+            idle_bytes_ -= it->first;
+            idle_.erase(it);
+            ++hits_;
+            return ptr;
+        }
+        ++misses_;
+    }
+
+    void *ptr = malloc(size, alignment);
+    if (ptr == nullptr) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    busy_[ptr] = size;
+    return ptr;
+}
+
+void ws_pool_t::put(void *ptr) {
+    if (ptr == nullptr) return;
+    if (!enabled()) { free(ptr); return; }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = busy_.find(ptr);
+        /* a buffer not from get() has no size to be accounted with: it is
+         * just freed */
+        if (it != busy_.end()) {
+            const size_t size = it->second;
+            busy_.erase(it);
+            if (idle_bytes_ + size <= capacity_) {
+                idle_.insert(std::make_pair(size, ptr));
+                idle_bytes_ += size;
+                return;
+            }
+        }
+    }
+    free(ptr);
+}
+
+void ws_pool_t::trim() {
+    std::multimap<size_t, void *> idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle.swap(idle_);
+        idle_bytes_ = 0;
+    }
+    for (auto &e: idle)
+        free(e.second);
+}
+
+size_t ws_pool_t::idle_bytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_bytes_;
+}
+
+ws_pool_t &ws_pool() {
+    static ws_pool_t pool;
+    return pool;
+}
+
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef WS_POOL_HPP
+#define WS_POOL_HPP
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+
+/** Thread-safe pool of the temporary buffers that live for one call only
+ * (the gemm k-splitting and copy workspaces), so that repeated calls of the
+ * same shape reuse warm buffers instead of a malloc/free pair each.
+ *
+ * get() returns the smallest idle buffer that fits (if it is at most twice
+ * the requested size) or allocates a new one, put() gives it back. At most
+ * capacity() bytes of idle buffers are kept; the rest is freed. The
+ * capacity (bytes) is taken from the MKLDNN_WS_POOL_CAPACITY environment
+ * variable (default: ws_pool_t::default_capacity); a pool of capacity 0 is
+ * disabled and allocates on every get(). Buffers are aligned on
+ * ws_pool_t::alignment and follow the memory policy (see mem_policy.hpp):
+ * trim() drops the idle ones when the policy changes. */
+struct ws_pool_t: public c_compatible {
+    enum { alignment = 4096, default_capacity = 64 * 1024 * 1024 };
+
+    ws_pool_t(): ws_pool_t(capacity_from_env()) {}
+    ws_pool_t(size_t capacity): capacity_(capacity), idle_bytes_(0)
+        , hits_(0), misses_(0) {}
+    ~ws_pool_t();
+
+    size_t capacity() const { return capacity_; }
+    bool enabled() const { return capacity_ != 0; }
+
+    /** returns a buffer of at least @p size bytes or nullptr */
+    void *get(size_t size);
+    /** gives back a buffer returned by get() (nullptr is ignored, a buffer
+     * the pool does not know is freed) */
+    void put(void *ptr);
+    /** frees all the idle buffers */
+    void trim();
+
+    size_t idle_bytes();
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+private:
+    static size_t capacity_from_env();
+
+    size_t capacity_;
+    size_t idle_bytes_;
+    size_t hits_, misses_;
+    std::multimap<size_t, void *> idle_; /* by size */
+    std::unordered_map<void *, size_t> busy_;
+    std::mutex mutex_;
+
+    ws_pool_t(const ws_pool_t &) = delete;
+    ws_pool_t &operator=(const ws_pool_t &) = delete;
+};
+
+/** the process wide pool */
+ws_pool_t &ws_pool();
+
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
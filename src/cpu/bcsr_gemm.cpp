@@ -0,0 +1,140 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "bcsr_gemm.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+/* columns of C per tile. The oc_block x n_tile accumulators (at most 1 KB)
+ * are register resident only for the small oc blocks: for oc_block >= 8 the
+ * tile spills to L1, where it stays while the block row is streamed.
+ * Narrower tiles that fit the registers re-read the weights more often and
+ * measured slower */
+template <int OB> struct bcsr_tile { enum { n = OB >= 4 ? 16 : 64 / OB }; };
+
+/* one tile of block row rb: \p full tiles have the compile-time width, which
+ * gives the simd loops a constant trip count */
+template <int OB, bool full>
+void bcsr_tile_kernel(const bcsr_layout_t &l, const int32_t *row_ptr,
+        const int32_t *col_idx, const float *values, int rb, const float *B,
+        ptrdiff_t ldb, int n_len, float *C, ptrdiff_t ldc_o, ptrdiff_t ldc_s,
+        const float *bias, bool do_relu, float nslope) {
+    enum { NT = bcsr_tile<OB>::n };
+    const int nt = full ? (int)NT : n_len;
+    const int KB = l.k_block;
+
+    float acc[OB][NT];
+    for (int i = 0; i < OB; ++i)
+        PRAGMA_OMP_SIMD()
+        for (int s = 0; s < NT; ++s)
+            acc[i][s] = 0.f;
+
+    for (int b = row_ptr[rb]; b < row_ptr[rb + 1]; ++b) {
+        const int k0 = col_idx[b] * KB;
+        const int kb_len = nstl::min(KB, l.k - k0);
+        const float *v = values + (size_t)b * OB * KB;
+        for (int j = 0; j < kb_len; ++j) {
+            const float *b_row = B + (ptrdiff_t)(k0 + j) * ldb;
+            for (int i = 0; i < OB; ++i) {
+                const float w = v[j * OB + i];
+                PRAGMA_OMP_SIMD()
+                for (int s = 0; s < nt; ++s)
+                    acc[i][s] += w * b_row[s];
+            }
+        }
+    }
+
+    const int o_len = nstl::min(OB, l.oc - rb * OB);
+    for (int i = 0; i < o_len; ++i) {
+        const int o = rb * OB + i;
+        const float bv = bias ? bias[o] : 0.f;
+        float *c = C + (ptrdiff_t)o * ldc_o;
+        PRAGMA_OMP_SIMD()
+        for (int s = 0; s < nt; ++s) {
+            float d = acc[i][s] + bv;
+            if (do_relu && d < 0.f) d *= nslope;
+            c[s * ldc_s] = d;
+        }
+    }
+}
+
+template <int OB>
+void bcsr_gemm_ob(const bcsr_layout_t &l, const char *wei, const float *B,
+        ptrdiff_t ldb, int n, float *C, ptrdiff_t ldc_o, ptrdiff_t ldc_s,
+        const float *bias, bool do_relu, float nslope, int ithr, int nthr) {
+    enum { NT = bcsr_tile<OB>::n };
+    const int32_t *row_ptr = l.row_ptr(wei);
+    const int32_t *col_idx = l.col_idx(wei);
+    const float *values = l.values(wei);
+
+    /* tile major, so that consecutive items of a thread reuse the k x NT
+     * slice of B from cache */
+    const size_t work_amount = (size_t)utils::div_up(n, (int)NT) * l.nrb;
+    size_t start = 0, end = 0;
+    balance211(work_amount, nthr, ithr, start, end);
+    for (size_t iwork = start; iwork < end; ++iwork) {
+        const int t = (int)(iwork / l.nrb);
+        const int rb = (int)(iwork % l.nrb);
+        const int s0 = t * NT;
+        const int n_len = nstl::min((int)NT, n - s0);
+        if (n_len == NT)
+            bcsr_tile_kernel<OB, true>(l, row_ptr, col_idx, values, rb,
+                    B + s0, ldb, n_len, C + s0 * ldc_s, ldc_o, ldc_s, bias,
+                    do_relu, nslope);
+        else
+            bcsr_tile_kernel<OB, false>(l, row_ptr, col_idx, values, rb,
+                    B + s0, ldb, n_len, C + s0 * ldc_s, ldc_o, ldc_s, bias,
+                    do_relu, nslope);
+    }
+}
+
+}
+
+bool bcsr_gemm_supported(const bcsr_data_t &d) {
+    return utils::one_of(d.oc_block, 1, 2, 4, 8, 16) && d.k_block > 0;
+}
+
+void bcsr_gemm(const bcsr_layout_t &l, const char *wei, const float *B,
+        ptrdiff_t ldb, int n, float *C, ptrdiff_t ldc_o, ptrdiff_t ldc_s,
+        const float *bias, bool do_relu, float nslope, int ithr, int nthr) {
+#   define CASE(OB) case OB: bcsr_gemm_ob<OB>(l, wei, B, ldb, n, C, ldc_o, \
+            ldc_s, bias, do_relu, nslope, ithr, nthr); break
+    switch (l.oc_block) {
+    CASE(1);
+    CASE(2);
+    CASE(4);
+    CASE(8);
+    CASE(16);
+    default: assert(!"unsupported oc_block");
+    }
+#   undef CASE
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
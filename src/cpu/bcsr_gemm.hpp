@@ -0,0 +1,53 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_BCSR_GEMM_HPP
+#define CPU_BCSR_GEMM_HPP
+
+#include <stddef.h>
+
+#include "bcsr.hpp"
+#include "c_types_map.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** true if bcsr_gemm() has a kernel for the blocking of \p d */
+bool bcsr_gemm_supported(const bcsr_data_t &d);
+
+/** C = W * B for block-CSR weights W (an oc x k matrix, see bcsr_layout_t)
+ * at \p wei and a dense k x n matrix B whose rows are \p ldb apart. Element
+ * (o, s) of C is at C[o * ldc_o + s * ldc_s]; the bias (one per o, may be
+ * null) and relu are applied as C is stored.
+ *
+ * C is computed by tiles of oc_block rows and a few vectors worth of
+ * columns, kept in a local accumulator tile while the stored blocks of the
+ * block row are accumulated, so that the work is proportional to the number
+ * of stored blocks. The tiles are split among the \p nthr callers, \p ithr being the
+ * index of the calling one: the function is called either by every thread
+ * of a parallel region or by a single thread with nthr == 1. */
+void bcsr_gemm(const bcsr_layout_t &l, const char *wei, const float *B,
+        ptrdiff_t ldb, int n, float *C, ptrdiff_t ldc_o, ptrdiff_t ldc_s,
+        const float *bias, bool do_relu, float nslope, int ithr, int nthr);
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
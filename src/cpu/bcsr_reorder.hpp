@@ -0,0 +1,174 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_BCSR_REORDER_HPP
+#define CPU_BCSR_REORDER_HPP
+
+#include <assert.h>
+
+#include "bcsr.hpp"
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+#include "cpu_primitive.hpp"
+#include "cpu_reorder_pd.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Reorder between f32 weights in a blocked format and block-CSR weights
+ * (memory_format::bcsr_fmt), in either direction. Element (o, k) of the
+ * block-CSR matrix is the element of logical offset o * k_total + k of the
+ * plain tensor. Packing keeps the blocks with a non-zero element: a first
+ * pass over the block rows counts them (row_ptr), a second one stores
+ * them. */
+struct bcsr_reorder_t : public cpu_primitive_t {
+    struct pd_t : public cpu_reorder_pd_t {
+        pd_t(const cpu_memory_pd_t *input_pd, const cpu_memory_pd_t *output_pd,
+                const primitive_attr_t *attr)
+            : cpu_reorder_pd_t(input_pd, output_pd, attr) {}
+
+        DECLARE_COMMON_PD_T("bcsr_reorder", bcsr_reorder_t);
+
+        static status_t create(reorder_pd_t **reorder_pd,
+                const memory_pd_t *input_pd, const memory_pd_t *output_pd,
+                const primitive_attr_t *attr) {
+            assert(input_pd->engine()->kind() == engine_kind::cpu);
+            assert(output_pd->engine()->kind() == engine_kind::cpu);
+            const memory_desc_wrapper input_d(input_pd);
+            const memory_desc_wrapper output_d(output_pd);
+            const bool to_bcsr = output_d.is_bcsr_desc();
+
+            bool args_ok = true
+                && input_d.data_type() == data_type::f32
+                && output_d.data_type() == data_type::f32
+                && input_d.is_bcsr_desc() != to_bcsr
+                && (to_bcsr ? input_d : output_d).is_blocking_desc()
+                && input_d.consistent_with(output_d)
+                && attr->has_default_values();
+            if (!args_ok)
+                return invalid_arguments;
+
+            auto _pd = new pd_t((const cpu_memory_pd_t *)input_pd,
+                    (const cpu_memory_pd_t *)output_pd, attr);
+            if (_pd == nullptr) return out_of_memory;
+            if (_pd->init() != success) { delete _pd; return unimplemented; }
+            return safe_ptr_assign<reorder_pd_t>(*reorder_pd, _pd);
+        }
+    };
+
+    bcsr_reorder_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {}
+
+    virtual void execute(event_t *e) {
+        const memory_desc_wrapper input_d(conf_.input_pd());
+        const memory_desc_wrapper output_d(conf_.output_pd());
+        if (output_d.is_bcsr_desc())
+            pack(input_d, reinterpret_cast<const float *>(input_memory(0)),
+                    bcsr_layout_t(output_d.bcsr_desc()), memory());
+        else
+            unpack(bcsr_layout_t(input_d.bcsr_desc()), input_memory(0),
+                    output_d, reinterpret_cast<float *>(memory()));
+        e->set_state(event_t::ready);
+    }
+
+private:
+    static void pack(const memory_desc_wrapper &dense_d, const float *dense,
+            const bcsr_layout_t &l, char *wei) {
+        int32_t *row_ptr = l.row_ptr(wei);
+        int32_t *col_idx = l.col_idx(wei);
+        float *values = l.values(wei);
+
+        auto w = [&](int o, int k) {
+            return dense[dense_d.off_l((size_t)o * l.k + k)];
+        };
+        auto blk_is_zero = [&](int rb, int kb) {
+            const int o_end = nstl::min(l.oc, (rb + 1) * l.oc_block);
+            const int k_end = nstl::min(l.k, (kb + 1) * l.k_block);
+            for (int o = rb * l.oc_block; o < o_end; ++o)
+            for (int k = kb * l.k_block; k < k_end; ++k)
+                if (w(o, k) != 0.f) return false;
+            return true;
+        };
+
+        OMP(parallel for schedule(static))//;
+        for (int rb = 0; rb < l.nrb; ++rb) {
+            int nblk = 0;
+            for (int kb = 0; kb < l.nkb; ++kb)
+                nblk += !blk_is_zero(rb, kb);
+            row_ptr[rb + 1] = nblk;
+        }
+        row_ptr[0] = 0;
+        for (int rb = 0; rb < l.nrb; ++rb)
+            row_ptr[rb + 1] += row_ptr[rb];
+
+        OMP(parallel for schedule(static))//;
+        for (int rb = 0; rb < l.nrb; ++rb) {
+            int b = row_ptr[rb];
+            for (int kb = 0; kb < l.nkb; ++kb) {
+                if (blk_is_zero(rb, kb)) continue;
+                col_idx[b] = kb;
+                float *v = values + (size_t)b * l.blk_sz();
+                for (int j = 0; j < l.k_block; ++j)
+                for (int i = 0; i < l.oc_block; ++i) {
+                    const int o = rb * l.oc_block + i;
+                    const int k = kb * l.k_block + j;
+                    v[j * l.oc_block + i]
+                        = (o < l.oc && k < l.k) ? w(o, k) : 0.f;
+                }
+                ++b;
+            }
+        }
+    }
+
+    static void unpack(const bcsr_layout_t &l, const char *wei,
+            const memory_desc_wrapper &dense_d, float *dense) {
+        const int32_t *row_ptr = l.row_ptr(wei);
+        const int32_t *col_idx = l.col_idx(wei);
+        const float *values = l.values(wei);
+
+        OMP(parallel for schedule(static))//;
+        for (int rb = 0; rb < l.nrb; ++rb) {
+            const int o_end = nstl::min(l.oc, (rb + 1) * l.oc_block);
+            for (int o = rb * l.oc_block; o < o_end; ++o)
+            for (int k = 0; k < l.k; ++k)
+                dense[dense_d.off_l((size_t)o * l.k + k)] = 0.f;
+
+            for (int b = row_ptr[rb]; b < row_ptr[rb + 1]; ++b) {
+                const float *v = values + (size_t)b * l.blk_sz();
+                const int k0 = col_idx[b] * l.k_block;
+                const int k_end = nstl::min(l.k, k0 + l.k_block);
+                for (int k = k0; k < k_end; ++k)
+                for (int o = rb * l.oc_block; o < o_end; ++o)
+                    dense[dense_d.off_l((size_t)o * l.k + k)]
+                        = v[(k - k0) * l.oc_block + o - rb * l.oc_block];
+            }
+        }
+    }
+
+    pd_t conf_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,395 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include "cpu_batch_normalization_utils.hpp"
+#include "c_types_map.hpp"
+#include "blocked_batch_normalization.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+
+// clang6 generates incorrect code with OMP_SIMD in some particular cases
+#if (defined __clang_major__) && (__clang_major__ == 6)
+#define SAFE_TO_USE_OMP_SIMD 0
+#else
+#define SAFE_TO_USE_OMP_SIMD 1
+#endif
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+inline int padded_channels(const cpu_memory_t::pd_t *data_pd) {
+    return memory_desc_wrapper(data_pd).blocking_desc().padding_dims[1];
+}
+
+/* The sweeps over the data split (N, channel blocks) on an nthr_n x nthr_cb
+ * grid, so that a small batch still keeps every thread busy. The partial
+ * sums are kept per grid row: the threads of a row own disjoint channel
+ * blocks and write disjoint parts of the row. Threads outside of the grid
+ * get empty ranges. */
+inline int grid_rows(int N, int nthr) {
+    return nstl::max(1, nstl::min(N, nthr));
+}
+
+inline void grid_ranges(int N, int CB, int nthr, int ithr, int &ithr_n,
+        int &N_s, int &N_e, int &cb_s, int &cb_e) {
+    const int nthr_n = grid_rows(N, nthr);
+    const int nthr_cb = nstl::max(1, nstl::min(CB, nthr / nthr_n));
+    ithr_n = ithr / nthr_cb;
+    N_s = N_e = cb_s = cb_e = 0;
+    if (ithr_n >= nthr_n) {
+        ithr_n = 0;
+        return;
+    }
+    balance211(N, nthr_n, ithr_n, N_s, N_e);
+    balance211(CB, nthr_cb, ithr % nthr_cb, cb_s, cb_e);
+}
+}
+
+template <int blksize>
+blocked_batch_normalization_fwd_t<blksize>::blocked_batch_normalization_fwd_t(
+        const pd_t *pd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(&conf_, inputs, outputs), scratchpad_(nullptr),
+    stats_reduction_off_(0), tmp_stats_off_(0), conf_(*pd) {
+    const int C_PADDED = padded_channels(conf_.src_pd());
+    stats_reduction_off_ = 2 * C_PADDED;
+    tmp_stats_off_ = stats_reduction_off_;
+    size_t size = tmp_stats_off_;
+    if (!conf_.stats_is_src()) {
+        tmp_stats_off_ += 2 * C_PADDED * omp_get_max_threads();
+        size = tmp_stats_off_;
+        if (!conf_.is_training())
+            size += 2 * conf_.C();
+    }
+    scratchpad_ = create_scratchpad(size * sizeof(data_t));
+}
+
+template <int blksize>
+blocked_batch_normalization_fwd_t<blksize>::
+~blocked_batch_normalization_fwd_t() {
+    delete scratchpad_;
+}
+
+template <int blksize>
+void blocked_batch_normalization_fwd_t<blksize>::execute_forward() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto dst = reinterpret_cast<data_t *>(this->memory(0));
+    const bool calculate_stats = !conf_.stats_is_src();
+    const bool save_stats = conf_.is_training();
+    const bool is_training = conf_.is_training();
+    const bool fuse_bn_relu = conf_.fuse_bn_relu();
+    const bool with_relu = conf_.with_relu_post_op();
+    data_t *scratch = (data_t *)scratchpad_->get();
+
+    data_t *mean, *variance;
+    if (!calculate_stats) {
+        mean = reinterpret_cast<data_t *>(
+                const_cast<char *>(this->input_memory(1)));
+        variance = reinterpret_cast<data_t *>(
+                const_cast<char *>(this->input_memory(2)));
+    } else {
+        if (save_stats) {
+            mean = reinterpret_cast<data_t *>(this->memory(1));
+            variance = reinterpret_cast<data_t *>(this->memory(2));
+        } else {
+            mean = scratch + tmp_stats_off_;
+            variance = mean + conf_.C();
+        }
+    }
+    auto idx_scaleshift = 1 + 2 * conf_.stats_is_src();
+    auto scaleshift = reinterpret_cast<const data_t *>(
+            this->input_memory(idx_scaleshift));
+    auto ws = reinterpret_cast<uint8_t *>(this->memory(conf_.ws_idx()));
+    data_t *ws_reduce = scratch + stats_reduction_off_;
+
+    const float eps = conf_.desc()->batch_norm_epsilon;
+    const bool use_scaleshift = conf_.use_scaleshift();
+    const int N = conf_.MB();
+    const int C = conf_.C();
+    const int C_PADDED = padded_channels(conf_.src_pd());
+    const int CB = C_PADDED / blksize;
+    const int SP = conf_.D() * conf_.H() * conf_.W();
+
+    /* per-channel y = alpha * x + beta */
+    data_t *alpha = scratch;
+    data_t *beta = scratch + C_PADDED;
+
+#pragma omp parallel
+    {
+        const int nthr = omp_get_num_threads(), ithr = omp_get_thread_num();
+        const int nthr_n = grid_rows(N, nthr);
+        int ithr_n = 0, N_s = 0, N_e = 0, cb_s = 0, cb_e = 0, C_s = 0, C_e = 0;
+        grid_ranges(N, CB, nthr, ithr, ithr_n, N_s, N_e, cb_s, cb_e);
+        balance211(C, nthr, ithr, C_s, C_e);
+
+        if (calculate_stats) {
+            // single sweep: running (mean, m2) vectorized over the channel
+            // block, then a Chan merge across the grid rows
+            data_t *mean_red = ws_reduce + C_PADDED * ithr_n;
+            data_t *m2_red = ws_reduce + C_PADDED * nthr + C_PADDED * ithr_n;
+            for (int c = cb_s * blksize; c < cb_e * blksize; c++) {
+                mean_red[c] = 0.;
+                m2_red[c] = 0.;
+            }
+
+            for (int n = N_s; n < N_e; n++)
+                for (int cb = cb_s; cb < cb_e; cb++) {
+                    const data_t *s = &src[((size_t)n * CB + cb) * SP * blksize];
+                    data_t *m_b = &mean_red[cb * blksize];
+                    data_t *m2_b = &m2_red[cb * blksize];
+                    for (int sp = 0; sp < SP; sp++) {
+                        const data_t inv_cnt
+                                = 1.f / (data_t)((n - N_s) * SP + sp + 1);
+                        PRAGMA_OMP_SIMD()
+                        for (int cc = 0; cc < blksize; cc++) {
+                            data_t x = s[sp * blksize + cc];
+                            data_t delta = x - m_b[cc];
+                            m_b[cc] += delta * inv_cnt;
+                            m2_b[cc] += delta * (x - m_b[cc]);
+                        }
+                    }
+                }
+
+#pragma omp barrier
+            for (int c = C_s; c < C_e; c++) {
+                data_t n_acc = 0, v_mean = 0, m2 = 0;
+                for (int t = 0; t < nthr_n; t++) {
+                    int n_s = 0, n_e = 0;
+                    balance211(N, nthr_n, t, n_s, n_e);
+                    bnorm_utils::moments_merge(n_acc, v_mean, m2,
+                            (data_t)(n_e - n_s) * SP,
+                            ws_reduce[C_PADDED * t + c],
+                            ws_reduce[C_PADDED * nthr + C_PADDED * t + c]);
+                }
+                mean[c] = v_mean;
+                variance[c] = m2 / (SP * N);
+            }
+        }
+
+        for (int c = C_s; c < C_e; c++) {
+            data_t sm = use_scaleshift ? scaleshift[c] : 1;
+            data_t sv = use_scaleshift ? scaleshift[C + c] : 0;
+            data_t sqrt_variance
+                    = static_cast<data_t>(1.0f / sqrtf(variance[c] + eps));
+            alpha[c] = sm * sqrt_variance;
+            beta[c] = sv - mean[c] * alpha[c];
+        }
+#pragma omp barrier
+
+        for (int n = N_s; n < N_e; n++)
+            for (int cb = cb_s; cb < cb_e; cb++) {
+                const size_t off = ((size_t)n * CB + cb) * SP * blksize;
+                const int c_blk = nstl::min(blksize, C - cb * blksize);
+                const data_t *a_b = &alpha[cb * blksize];
+                const data_t *b_b = &beta[cb * blksize];
+                for (int sp = 0; sp < SP; sp++) {
+#if SAFE_TO_USE_OMP_SIMD
+                    PRAGMA_OMP_SIMD()
+#endif
+                    for (int cc = 0; cc < c_blk; cc++) {
+                        const size_t d_off = off + sp * blksize + cc;
+                        data_t bn_res = a_b[cc] * src[d_off] + b_b[cc];
+                        if (fuse_bn_relu) {
+                            if (bn_res <= 0) {
+                                bn_res = 0;
+                                if (is_training)
+                                    ws[d_off] = 0;
+                            } else {
+                                if (is_training)
+                                    ws[d_off] = 1;
+                            }
+                        }
+                        if (with_relu && bn_res < 0)
+                            bn_res = 0;
+                        dst[d_off] = bn_res;
+                    }
+                    for (int cc = c_blk; cc < blksize; cc++) {
+                        const size_t d_off = off + sp * blksize + cc;
+                        if (fuse_bn_relu && is_training)
+                            ws[d_off] = 0;
+                        dst[d_off] = 0;
+                    }
+                }
+            }
+    }
+}
+
+template <int blksize>
+blocked_batch_normalization_bwd_t<blksize>::blocked_batch_normalization_bwd_t(
+        const pd_t *pd, const input_vector &inputs,
+        const output_vector &outputs)
+    : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+    , scratchpad_(nullptr), stats_reduction_off_(0), tmp_diff_ss_off_(0) {
+    const int C_PADDED = padded_channels(conf_.src_pd());
+    stats_reduction_off_ = 3 * C_PADDED;
+    tmp_diff_ss_off_ = stats_reduction_off_
+        + 2 * C_PADDED * omp_get_max_threads();
+    size_t size = tmp_diff_ss_off_;
+    if (!(conf_.use_scaleshift()
+                && conf_.desc()->prop_kind == prop_kind::backward))
+        size += conf_.C() * 2;
+    scratchpad_ = create_scratchpad(size * sizeof(data_t));
+}
+
+template <int blksize>
+blocked_batch_normalization_bwd_t<blksize>::
+~blocked_batch_normalization_bwd_t() {
+    delete scratchpad_;
+}
+
+template <int blksize>
+void blocked_batch_normalization_bwd_t<blksize>::execute_backward() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto mean = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto variance = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(3));
+    auto scaleshift = reinterpret_cast<const data_t *>(this->input_memory(4));
+    auto ws = reinterpret_cast<const uint8_t *>(
+            this->input_memory(conf_.ws_idx()));
+
+    auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+    data_t *scratch = (data_t *)scratchpad_->get();
+    auto diff_scaleshift = (this->memory(1)) ?
+            reinterpret_cast<data_t *>(this->memory(1)) :
+            scratch + tmp_diff_ss_off_;
+
+    const int N = conf_.MB();
+    const int C = conf_.C();
+    const int C_PADDED = padded_channels(conf_.src_pd());
+    const int CB = C_PADDED / blksize;
+    const int SP = conf_.D() * conf_.H() * conf_.W();
+    data_t *diff_gamma = diff_scaleshift, *diff_beta = diff_scaleshift + C;
+    data_t *ws_reduce = scratch + stats_reduction_off_;
+
+    const float eps = conf_.desc()->batch_norm_epsilon;
+    const bool use_scaleshift = conf_.use_scaleshift();
+    const bool calculate_diff_stats = !conf_.omit_stats();
+    const bool fuse_bn_relu = conf_.fuse_bn_relu();
+
+    /* diff_src = k_dd * diff_dst + k_x * (src - mean) + k_0 */
+    data_t *k_dd = scratch;
+    data_t *k_x = scratch + C_PADDED;
+    data_t *k_0 = scratch + 2 * C_PADDED;
+
+#pragma omp parallel
+    {
+        const int nthr = omp_get_num_threads(), ithr = omp_get_thread_num();
+        const int nthr_n = grid_rows(N, nthr);
+        int ithr_n = 0, N_s = 0, N_e = 0, cb_s = 0, cb_e = 0, C_s = 0, C_e = 0;
+        grid_ranges(N, CB, nthr, ithr, ithr_n, N_s, N_e, cb_s, cb_e);
+        balance211(C, nthr, ithr, C_s, C_e);
+
+        data_t *dg_red = ws_reduce + C_PADDED * ithr_n;
+        data_t *db_red = ws_reduce + C_PADDED * nthr + C_PADDED * ithr_n;
+        for (int c = cb_s * blksize; c < cb_e * blksize; c++) {
+            dg_red[c] = 0.;
+            db_red[c] = 0.;
+        }
+
+        for (int n = N_s; n < N_e; n++)
+            for (int cb = cb_s; cb < cb_e; cb++) {
+                const size_t off = ((size_t)n * CB + cb) * SP * blksize;
+                const int c_blk = nstl::min(blksize, C - cb * blksize);
+                const data_t *m_b = &mean[cb * blksize];
+                data_t *dg_b = &dg_red[cb * blksize];
+                data_t *db_b = &db_red[cb * blksize];
+                for (int sp = 0; sp < SP; sp++) {
+#if SAFE_TO_USE_OMP_SIMD
+                    PRAGMA_OMP_SIMD()
+#endif
+                    for (int cc = 0; cc < c_blk; cc++) {
+                        const size_t d_off = off + sp * blksize + cc;
+                        data_t dd;
+                        if (fuse_bn_relu)
+                            dd = (!ws[d_off]) ? 0 : diff_dst[d_off];
+                        else
+                            dd = diff_dst[d_off];
+                        dg_b[cc] += (src[d_off] - m_b[cc]) * dd;
+                        db_b[cc] += dd;
+                    }
+                }
+            }
+
+#pragma omp barrier
+        for (int c = C_s; c < C_e; c++) {
+            data_t sqrt_variance
+                    = static_cast<data_t>(1.0f / sqrtf(variance[c] + eps));
+            data_t dg = 0., db = 0.;
+            for (int t = 0; t < nthr_n; t++) {
+                dg += ws_reduce[C_PADDED * t + c];
+                db += ws_reduce[C_PADDED * nthr + C_PADDED * t + c];
+            }
+            dg *= sqrt_variance;
+            diff_gamma[c] = dg;
+            diff_beta[c] = db;
+
+            data_t gamma = use_scaleshift ? scaleshift[c] : 1;
+            k_dd[c] = gamma * sqrt_variance;
+            if (calculate_diff_stats) {
+                k_x[c] = -k_dd[c] * dg * sqrt_variance / (SP * N);
+                k_0[c] = -k_dd[c] * db / (SP * N);
+            } else {
+                k_x[c] = 0.;
+                k_0[c] = 0.;
+            }
+        }
+#pragma omp barrier
+
+        for (int n = N_s; n < N_e; n++)
+            for (int cb = cb_s; cb < cb_e; cb++) {
+                const size_t off = ((size_t)n * CB + cb) * SP * blksize;
+                const int c_blk = nstl::min(blksize, C - cb * blksize);
+                const data_t *kdd_b = &k_dd[cb * blksize];
+                const data_t *kx_b = &k_x[cb * blksize];
+                const data_t *k0_b = &k_0[cb * blksize];
+                const data_t *m_b = &mean[cb * blksize];
+                for (int sp = 0; sp < SP; sp++) {
+#if SAFE_TO_USE_OMP_SIMD
+                    PRAGMA_OMP_SIMD()
+#endif
+                    for (int cc = 0; cc < c_blk; cc++) {
+                        const size_t d_off = off + sp * blksize + cc;
+                        data_t dd;
+                        if (fuse_bn_relu)
+                            dd = (!ws[d_off]) ? 0 : diff_dst[d_off];
+                        else
+                            dd = diff_dst[d_off];
+                        diff_src[d_off]
+                                = kdd_b[cc] * dd
+                                + kx_b[cc] * (src[d_off] - m_b[cc]) + k0_b[cc];
+                    }
+                    for (int cc = c_blk; cc < blksize; cc++)
+                        diff_src[off + sp * blksize + cc] = 0;
+                }
+            }
+    }
+}
+
+template struct blocked_batch_normalization_fwd_t<8>;
+template struct blocked_batch_normalization_fwd_t<16>;
+template struct blocked_batch_normalization_bwd_t<8>;
+template struct blocked_batch_normalization_bwd_t<16>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
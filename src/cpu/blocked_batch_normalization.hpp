@@ -0,0 +1,181 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_BLOCKED_BATCH_NORMALIZATION_HPP
+#define CPU_BLOCKED_BATCH_NORMALIZATION_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_batch_normalization_pd.hpp"
+#include "cpu_engine.hpp"
+#include "scratchpad.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Portable batch normalization for nChw8c/nChw16c (and 3D) activations.
+ * Inner loops run over the channel block, so they vectorize without jit.
+ * Padded channels of dst / diff_src are written as zeros. */
+template <int blksize>
+struct blocked_batch_normalization_fwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_batch_normalization_fwd_pd_t {
+        pd_t(engine_t *engine, const batch_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const batch_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_batch_normalization_fwd_pd_t(
+                      engine, adesc, attr, hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("blocked_bnorm:any",
+                blocked_batch_normalization_fwd_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace data_type;
+            using namespace memory_format;
+            assert(engine()->kind() == engine_kind::cpu);
+            auto desired_fmt = (ndims() == 4)
+                ? blksize == 16 ? nChw16c : nChw8c
+                : blksize == 16 ? nCdhw16c : nCdhw8c;
+            bool ok = true
+                && is_fwd()
+                && !has_zero_dim_memory()
+                && utils::one_of(ndims(), 4, 5)
+                && desc()->data_desc.data_type == f32
+                && utils::implication(use_scaleshift(),
+                        desc()->data_scaleshift_desc.data_type == f32)
+                && data_pd_.desc()->format == desired_fmt
+                && (attr()->has_default_values() || this->with_relu_post_op());
+            if (!ok)
+                return status::unimplemented;
+
+            if (is_training() && fuse_bn_relu())
+                bn_init_default_ws(this, this->workspace_pd_, 8);
+
+            if (stats_is_src() || is_training()) {
+                memory_desc_t stats_d;
+                dims_t stats_dims = { C() };
+                mkldnn_memory_desc_init(&stats_d, 1, stats_dims, data_type::f32,
+                        memory_format::x);
+                mean_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+                variance_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
+            }
+
+            return status::success;
+        }
+    };
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    blocked_batch_normalization_fwd_t(const pd_t *pd,
+            const input_vector &inputs, const output_vector &outputs);
+    ~blocked_batch_normalization_fwd_t();
+    virtual void execute(event_t *e) {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    /* scale and shift, the reduction space, then the statistics when they
+     * are not outputs */
+    scratchpad_t *scratchpad_;
+    size_t stats_reduction_off_, tmp_stats_off_;
+    void execute_forward();
+    pd_t conf_;
+};
+
+template <int blksize>
+struct blocked_batch_normalization_bwd_t : public cpu_primitive_t {
+    struct pd_t : public cpu_batch_normalization_bwd_pd_t {
+        pd_t(engine_t *engine, const batch_normalization_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const batch_normalization_fwd_pd_t *hint_fwd_pd)
+            : cpu_batch_normalization_bwd_pd_t(
+                      engine, adesc, attr, hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("blocked_bnorm:any",
+                blocked_batch_normalization_bwd_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace data_type;
+            using namespace memory_format;
+            assert(engine()->kind() == engine_kind::cpu);
+            auto desired_fmt = (ndims() == 4)
+                ? blksize == 16 ? nChw16c : nChw8c
+                : blksize == 16 ? nCdhw16c : nCdhw8c;
+            bool ok = true
+                && is_bwd()
+                && !has_zero_dim_memory()
+                && utils::one_of(ndims(), 4, 5)
+                && utils::everyone_is(f32, desc()->data_desc.data_type,
+                        desc()->diff_data_desc.data_type)
+                && utils::implication(use_scaleshift(),
+                        desc()->data_scaleshift_desc.data_type == f32)
+                && utils::everyone_is(desired_fmt, data_pd_.desc()->format,
+                        diff_data_pd_.desc()->format)
+                && attr()->has_default_values()
+                && hint_fwd_pd_ != nullptr;
+            if (!ok)
+                return status::unimplemented;
+
+            if (fuse_bn_relu()) {
+                bn_init_default_ws(this, this->workspace_pd_, 8);
+                const size_t this_ws_sz
+                        = memory_desc_wrapper(this->workspace_pd()).size();
+
+                bool ws_ok = true && hint_fwd_pd_->workspace_pd()
+                        && memory_desc_wrapper(hint_fwd_pd_->workspace_pd())
+                                        .size()
+                                == this_ws_sz;
+                if (!ws_ok)
+                    return status::unimplemented;
+            }
+
+            return status::success;
+        }
+    };
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    blocked_batch_normalization_bwd_t(const pd_t *pd,
+            const input_vector &inputs, const output_vector &outputs);
+    ~blocked_batch_normalization_bwd_t();
+    virtual void execute(event_t *e) {
+        execute_backward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward();
+    pd_t conf_;
+
+    /* the coefficients, the reduction space, then diff_scaleshift when it
+     * is not an output */
+    scratchpad_t *scratchpad_;
+    size_t stats_reduction_off_, tmp_diff_ss_off_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
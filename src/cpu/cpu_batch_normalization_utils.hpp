@@ -19,6 +19,9 @@
 
 #include "c_types_map.hpp"
 #include "cpu_batch_normalization_pd.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+
 namespace mkldnn {
 namespace impl {
 namespace cpu {
@@ -36,6 +39,48 @@ namespace bnorm_utils {
     void set_spatial_thr(const batch_normalization_pd_t *bdesc,
         const int simd_w, const int data_size, int &is_spatial_thr);
 
+    /** Chan et al. pairwise merge of partial moments.
+     * Folds (n_b, mean_b, m2_b) into the running (n_a, mean_a, m2_a), where
+     * m2 is the sum of squared deviations from the mean. Lets threads that
+     * own disjoint N/spatial chunks of a channel compute mean and variance
+     * in a single sweep over the data. */
+    template <typename data_t>
+    inline void moments_merge(data_t &n_a, data_t &mean_a, data_t &m2_a,
+            data_t n_b, data_t mean_b, data_t m2_b) {
+        if (n_b == data_t(0)) return;
+        const data_t n_ab = n_a + n_b;
+        const data_t delta = mean_b - mean_a;
+        mean_a += delta * n_b / n_ab;
+        m2_a += m2_b + delta * delta * n_a * n_b / n_ab;
+        n_a = n_ab;
+    }
+
+    /** Single-sweep partial moments of a contiguous row x[0..len).
+     * The row is consumed in L1-sized chunks; each chunk gets a vectorised
+     * sum and sum of squared deviations (the second loop re-reads cached
+     * data only) and is then merged into (n, mean, m2). */
+    template <typename data_t>
+    inline void moments_accumulate(const data_t *x, int len,
+            data_t &n, data_t &mean, data_t &m2) {
+        const int chunk = 256;
+        for (int s = 0; s < len; s += chunk) {
+            const int e = nstl::min(len, s + chunk);
+            data_t sum = 0;
+            PRAGMA_OMP_SIMD(reduction(+ : sum))
+            for (int i = s; i < e; ++i)
+                sum += x[i];
+            const data_t n_b = (data_t)(e - s);
+            const data_t mean_b = sum / n_b;
+            data_t m2_b = 0;
+            PRAGMA_OMP_SIMD(reduction(+ : m2_b))
+            for (int i = s; i < e; ++i) {
+                data_t m = x[i] - mean_b;
+                m2_b += m * m;
+            }
+            moments_merge(n, mean, m2, n_b, mean_b, m2_b);
+        }
+    }
+
 };
 
 }
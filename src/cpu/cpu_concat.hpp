@@ -53,6 +53,8 @@ namespace cpu {
             printf("mkldnn_verbose,create,%s,%g\n", this->info(), ms); \
             fflush(0); \
         } \
+        if (profiling_enabled()) \
+            profiling_record(mkldnn_profiling_create, this, ms); \
         return ret; \
     } \
     virtual pd_t *clone() const override { return nullptr; } \
@@ -81,8 +83,23 @@ struct cpu_concat_pd_t: public concat_pd_t {
 
     virtual const cpu_memory_pd_t *src_pd(int index = 0) const override
     { return index < this->n_ ? &src_pds_[index] : nullptr; }
-    virtual const cpu_memory_pd_t *src_image_pd(int index = 0) const
+    virtual const cpu_memory_pd_t *src_image_pd(int index = 0) const override
     { return index < this->n_ ? &src_image_pds_[index] : nullptr; }
+
+    /** true if the @p index-th input of the concat primitive @p p already
+     * occupies its slot of the destination, i.e. it is a memory created with
+     * src_image_pd(@p index) on top of the destination buffer, so there is
+     * nothing to copy */
+    bool src_is_dst_image(const primitive_t *p, int index) const {
+        const auto &in = p->inputs()[index];
+        if (in.primitive->kind() != primitive_kind::memory) return false;
+        auto src = static_cast<const cpu_primitive_t *>(in.primitive);
+        auto dst = static_cast<const cpu_primitive_t *>(p->outputs()[0]);
+        auto src_pd = static_cast<const memory_pd_t *>(in.primitive->pd());
+        return src->const_memory() == dst->const_memory()
+            && memory_desc_wrapper(src_pd)
+                == memory_desc_wrapper(&src_image_pds_[index]);
+    }
     virtual const cpu_memory_pd_t *dst_pd(int index = 0) const override
     { return index == 0 ? &dst_pd_ : nullptr; }
 
@@ -99,7 +116,7 @@ protected:
 
         for (int i = 0; i < n_; ++i) {
             const memory_desc_wrapper i_d(&src_pds_[i]);
-            if (i_d.is_wino_desc())
+            if (i_d.is_wino_desc() || i_d.is_bcsr_desc())
                 return unimplemented;
         }
 
@@ -15,9 +15,12 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <new>
 
 #include "cpu_engine.hpp"
 #include "cpu_memory.hpp"
+#include "profiling.hpp"
+#include "scratchpad.hpp"
 #include "type_helpers.hpp"
 #include "verbose.hpp"
 
@@ -28,9 +31,13 @@
 
 #include "cpu/gemm_convolution.hpp"
 #include "cpu/gemm_u8s8s32x_convolution.hpp"
+#include "cpu/gemm_bf16_convolution.hpp"
+#include "cpu/gemm_bcsr_convolution.hpp"
+#include "cpu/dw_convolution.hpp"
 //#include "cpu/ref_convolution_3d.hpp"
 #include "cpu/ref_convolution.hpp"
 #include "cpu/ref_deconvolution.hpp"
+#include "cpu/subpixel_deconvolution.hpp"
 #include "cpu/ref_eltwise.hpp"
 #include "cpu/ref_softmax.hpp"
 #include "cpu/ref_pooling.hpp"
@@ -40,9 +47,12 @@
 #include "cpu/ref_batch_normalization.hpp"
 #include "cpu/ncsp_batch_normalization.hpp"
 #include "cpu/nspc_batch_normalization.hpp"
+#include "cpu/blocked_batch_normalization.hpp"
 #include "cpu/ref_inner_product.hpp"
 #include "cpu/gemm_inner_product.hpp"
 #include "cpu/gemm_u8s8s32x_inner_product.hpp"
+#include "cpu/gemm_bf16_inner_product.hpp"
+#include "cpu/gemm_bcsr_inner_product.hpp"
 
 #if JITFUNCS > 0
 //#warning "including jit headers..."
@@ -175,7 +185,7 @@ mkldnn::impl::status_t verbose_primitive_desc_create(
 
 
 #if JITFUNCS >= JITFUNCS_AVX512
-#define INSTANCE_avx512(...) &INSTANCE_CREATOR(__VA_ARGS__),
+#define INSTANCE_avx512(...) INSTANCE_ITEM(__VA_ARGS__),
 //#warning "jit avx512 YES"
 #else
 //#warning "INSTANCE_avx512 is NO-OP"
@@ -183,34 +193,43 @@ mkldnn::impl::status_t verbose_primitive_desc_create(
 #endif
 
 #if JITFUNCS >= JITFUNCS_AVX2
-#define INSTANCE_avx2(...) &INSTANCE_CREATOR(__VA_ARGS__),
+#define INSTANCE_avx2(...) INSTANCE_ITEM(__VA_ARGS__),
 #else
 #define INSTANCE_avx2(...) /* placeholder "non-null ptr-to-never-impl here?" */
 #endif
 
 #if JITFUNCS >= JITFUNCS_AVX
-#define INSTANCE_avx(...) &INSTANCE_CREATOR(__VA_ARGS__),
+#define INSTANCE_avx(...) INSTANCE_ITEM(__VA_ARGS__),
 #else
 #define INSTANCE_avx(...) /* placeholder "non-null ptr-to-never-impl here?" */
 #endif
 
 #if JITFUNCS >= JITFUNCS_SSE42
-#define INSTANCE_sse42(...) &INSTANCE_CREATOR(__VA_ARGS__),
+#define INSTANCE_sse42(...) INSTANCE_ITEM(__VA_ARGS__),
 #else
 #define INSTANCE_sse42(...) /* placeholder "non-null ptr-to-never-impl here?" */
 #endif
 
 #if VEJIT > 0
-#define INSTANCE_ve(...) &INSTANCE_CREATOR(__VA_ARGS__),
+#define INSTANCE_ve(...) INSTANCE_ITEM(__VA_ARGS__),
 #else
 #define INSTANCE_ve(...) /* placeholder "non-null ptr-to-never-impl here?" */
 #endif
 
 // JITFUNCS >= JIT_FUNCS_ANY (always include this impl)
-#define INSTANCE(...) &INSTANCE_CREATOR(__VA_ARGS__),
+#define INSTANCE(...) INSTANCE_ITEM(__VA_ARGS__),
 //@}
 
-static const pd_create_f cpu_impl_list[] = {
+/** list entries carry the primitive kind, so that primitive descriptor
+ * creation only walks the implementations of the requested kind */
+struct impl_list_item_t {
+    primitive_kind_t kind;
+    pd_create_f create;
+};
+#define INSTANCE_ITEM(...) \
+    { __VA_ARGS__::pd_t::base_pkind, &INSTANCE_CREATOR(__VA_ARGS__) }
+
+static const impl_list_item_t cpu_impl_list[] = {
     /* RNN */
     INSTANCE(ref_rnn_fwd_t)
     INSTANCE(ref_rnn_bwd_t)
@@ -247,6 +266,10 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE_ve(vednnx_convolution_fwd_t)
     INSTANCE_ve(vednnx_convolution_bwd_data_t)
     INSTANCE_ve(vednnx_convolution_bwd_weights_t)
+    INSTANCE(gemm_bcsr_convolution_fwd_t)
+    INSTANCE(dw_convolution_fwd_t)
+    INSTANCE(dw_convolution_bwd_data_t)
+    INSTANCE(dw_convolution_bwd_weights_t)
     INSTANCE(gemm_convolution_fwd_t)
     INSTANCE(gemm_convolution_bwd_data_t)
     INSTANCE(gemm_convolution_bwd_weights_t)
@@ -288,9 +311,19 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_convolution_bwd_data_t<s8, s8, u8, s32>)
     INSTANCE(ref_convolution_bwd_data_t<u8, s8, u8, s32>)
     INSTANCE(ref_convolution_bwd_weights_t<s16, s32, s16, s32>)
+    /* conv (bf16) */
+    INSTANCE(gemm_bf16_convolution_fwd_t<f32>)
+    INSTANCE(gemm_bf16_convolution_fwd_t<bf16>)
+    INSTANCE(ref_convolution_fwd_t<bf16, bf16, f32, f32>)
+    INSTANCE(ref_convolution_fwd_t<bf16, bf16, bf16, f32>)
+    INSTANCE(ref_convolution_bwd_data_t<f32, bf16, bf16, f32>)
+    INSTANCE(ref_convolution_bwd_data_t<bf16, bf16, bf16, f32>)
+    INSTANCE(ref_convolution_bwd_weights_t<bf16, f32, bf16, f32>)
+    INSTANCE(ref_convolution_bwd_weights_t<bf16, bf16, bf16, f32>)
     /* deconv */
     INSTANCE(ref_deconvolution_bwd_weights_t)
     INSTANCE(ref_deconvolution_bwd_data_t)
+    INSTANCE(subpixel_deconvolution_fwd_t)
     INSTANCE(ref_deconvolution_fwd_t)
     /* eltwise */
     //INSTANCE_avx512(jit_uni_eltwise_fwd_t<avx512_common>)
@@ -308,6 +341,9 @@ static const pd_create_f cpu_impl_list[] = {
     //INSTANCE(ref_eltwise_fwd_t<u8>)
     //INSTANCE(ref_eltwise_bwd_t<s32>)
     //INSTANCE(ref_eltwise_bwd_t<s16>)
+    /* eltwise (bf16) */
+    INSTANCE(ref_eltwise_fwd_t<bf16>)
+    INSTANCE(ref_eltwise_bwd_t<bf16>)
     /* softmax */
     INSTANCE(ref_softmax_fwd_t<f32>)
     INSTANCE(ref_softmax_bwd_t<f32>)
@@ -332,6 +368,9 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_pooling_fwd_t<u8, s32>)
     INSTANCE(ref_pooling_bwd_t<s32>)
     INSTANCE(ref_pooling_bwd_t<s16, s32>)
+    /* pool (bf16) */
+    INSTANCE(ref_pooling_fwd_t<bf16, f32>)
+    INSTANCE(ref_pooling_bwd_t<bf16, f32>)
     /* lrn */
     INSTANCE_avx512(jit_avx512_common_lrn_fwd_t)
     INSTANCE_avx512(jit_avx512_common_lrn_bwd_t)
@@ -351,10 +390,17 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ncsp_batch_normalization_bwd_t)
     INSTANCE(nspc_batch_normalization_fwd_t)
     INSTANCE(nspc_batch_normalization_bwd_t)
+    INSTANCE(blocked_batch_normalization_fwd_t<16>)
+    INSTANCE(blocked_batch_normalization_bwd_t<16>)
+    INSTANCE(blocked_batch_normalization_fwd_t<8>)
+    INSTANCE(blocked_batch_normalization_bwd_t<8>)
     INSTANCE(ref_batch_normalization_fwd_t<f32>)
     INSTANCE(ref_batch_normalization_bwd_t<f32>)
+    INSTANCE(ref_batch_normalization_fwd_t<bf16>)
+    INSTANCE(ref_batch_normalization_bwd_t<bf16>)
     /* inner product */
 #if 1 // debugging...
+    INSTANCE(gemm_bcsr_inner_product_fwd_t)
     INSTANCE(gemm_inner_product_fwd_t<f32>)
     INSTANCE(gemm_inner_product_bwd_data_t<f32>)
     INSTANCE(gemm_inner_product_bwd_weights_t<f32>)
@@ -375,6 +421,13 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_inner_product_fwd_t<s16, s16, s32, s32>)
     INSTANCE(ref_inner_product_bwd_data_t<s32, s16, s16, s32>)
 #endif
+    /* inner product (bf16) */
+    INSTANCE(gemm_bf16_inner_product_fwd_t<f32>)
+    INSTANCE(gemm_bf16_inner_product_fwd_t<bf16>)
+    INSTANCE(gemm_bf16_inner_product_bwd_data_t<f32>)
+    INSTANCE(gemm_bf16_inner_product_bwd_data_t<bf16>)
+    INSTANCE(gemm_bf16_inner_product_bwd_weights_t<f32>)
+    INSTANCE(gemm_bf16_inner_product_bwd_weights_t<bf16>)
     /* conv_eltwise */
     INSTANCE_avx512(jit_avx512_common_dw_convolution_relu_t)
     INSTANCE_avx512(jit_avx512_common_convolution_winograd_relu_t)
@@ -386,6 +439,7 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE_sse42(jit_sse42_1x1_convolution_relu_t)
     INSTANCE_avx2(jit_avx2_convolution_relu_t)
     INSTANCE_sse42(jit_sse42_convolution_relu_t)
+    INSTANCE(dw_convolution_relu_t)
     INSTANCE(gemm_convolution_relu_t)
     INSTANCE(ref_convolution_relu_t<f32>)
     /* conv_eltwise (int) */
@@ -412,29 +466,102 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_convolution_relu_t<u8, s8, s8, s32>)
     INSTANCE(ref_convolution_relu_t<u8, s8, u8, s32>)
     /* eol */
-    nullptr
+    { primitive_kind::undefined, nullptr }
 };
 #undef INSTANCE
+#undef INSTANCE_ITEM
+
+/** NULL-terminated lists built from cpu_impl_list: all the implementations
+ * and the implementations of each primitive kind (in the same order) */
+struct impl_lists_t {
+    static constexpr int n_kinds = primitive_kind::rnn + 1;
+
+    impl_lists_t() {
+        for (auto i = cpu_impl_list; i->create; ++i) {
+            assert(0 <= (int)i->kind && (int)i->kind < n_kinds);
+            all.push_back(i->create);
+            by_kind[i->kind].push_back(i->create);
+        }
+        all.push_back(nullptr);
+        for (int k = 0; k < n_kinds; ++k)
+            by_kind[k].push_back(nullptr);
+    }
+
+    nstl::vector<pd_create_f> all;
+    nstl::vector<pd_create_f> by_kind[n_kinds];
+};
+
+const impl_lists_t &impl_lists() {
+    static const impl_lists_t lists;
+    return lists;
+}
 }
 
 const pd_create_f* cpu_engine_t::get_implementation_list() const {
-    return cpu_impl_list;
+    return &impl_lists().all[0];
+}
+
+const pd_create_f* cpu_engine_t::get_kind_implementation_list(
+        primitive_kind_t kind) const {
+    if ((int)kind < 0 || (int)kind >= impl_lists_t::n_kinds)
+        return get_implementation_list();
+    return &impl_lists().by_kind[kind][0];
 }
 
 cpu_engine_factory_t engine_factory;
 
+/* the primitives find the padding of their memories zeroed (see
+ * cpu_primitive_t::ensure_zero_padding()) */
+static status_t ensure_zero_padding(const cpu_primitive_t *p) {
+    for (auto &in: p->inputs()) {
+        auto in_p = static_cast<const cpu_primitive_t *>(in.primitive);
+        status_t status = in_p->ensure_zero_padding(in.output_index);
+        if (status != success) return status;
+    }
+    for (size_t i = 0; i < p->outputs().size(); ++i) {
+        status_t status = p->ensure_zero_padding(i);
+        if (status != success) return status;
+    }
+    return success;
+}
+
 status_t cpu_engine_t::submit(primitive_t *p, event_t *e,
         event_vector &prerequisites) {
+    auto cpu_p = static_cast<const cpu_primitive_t *>(p);
+    scratchpad_scope_t scratchpad_scope;
+    if (!utils::one_of(p->kind(), primitive_kind::memory,
+                primitive_kind::view)) {
+        status_t status = ensure_zero_padding(cpu_p);
+        if (status != success) {
+            e->set_state(event_t::error);
+            return status;
+        }
+    }
+
     /* FIXME: this should live in primitive execute function... */
-    if (mkldnn_verbose()->level) {
-        double ms = get_msec();
-        p->execute(e);
-        ms = get_msec() - ms;
-        printf("mkldnn_verbose,exec,%s,%g\n", p->pd()->info(), ms);
-        fflush(0);
-    } else {
-        p->execute(e);
+    const bool profile = profiling_enabled();
+    try {
+        if (mkldnn_verbose()->level || profile) {
+            double ms = get_msec();
+            p->execute(e);
+            ms = get_msec() - ms;
+            if (mkldnn_verbose()->level) {
+                printf("mkldnn_verbose,exec,%s,%g\n", p->pd()->info(), ms);
+                fflush(0);
+            }
+            if (profile)
+                profiling_record(mkldnn_profiling_exec, p->pd(), ms);
+        } else {
+            p->execute(e);
+        }
+    } catch (const std::bad_alloc &) {
+        /* a scratchpad could not be allocated (see scratchpad_t::get()) */
+        e->set_state(event_t::error);
+        return out_of_memory;
     }
+    if (!cpu_p->preserves_zero_padding())
+        for (size_t i = 0; i < p->outputs().size(); ++i)
+            cpu_p->set_zero_padding_dirty(i);
     return success;
 }
 
@@ -24,6 +24,7 @@
 
 #include "c_types_map.hpp"
 #include "../common/engine.hpp"
+#include "../common/pd_cache.hpp"
 
 // oops SX VERBOSE_PRIMITIVE_CREATE uses unsupported c++1 features???
 #if defined(_SX)
@@ -78,6 +79,13 @@ public:
     virtual const sum_primitive_desc_create_f*
         get_sum_implementation_list() const;
     virtual const primitive_desc_create_f* get_implementation_list() const;
+    virtual const primitive_desc_create_f* get_kind_implementation_list(
+            primitive_kind_t kind) const;
+
+    virtual pd_cache_t *pd_cache() { return &pd_cache_; }
+
+private:
+    pd_cache_t pd_cache_;
 };
 
 class cpu_engine_factory_t: public engine_factory_t {
@@ -19,6 +19,8 @@
 #include "memory_pd.hpp"
 #include "mkldnn_traits.hpp"
 #include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "offset_calc.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
@@ -254,12 +256,10 @@ void typed_zero_pad_generic_blocked(const memory_desc_wrapper &m_d,
     const auto &dims = m_d.dims();
     const auto &pdims = m_d.blocking_desc().padding_dims;
 
-    const ptrdiff_t nelems = (ptrdiff_t)m_d.nelems(true);
-
     /* [D_0] .. [D_k][D_k+1] .. [D_ndim - 1]
      *            |  \                     /
      *            |   ---------------------
-     *           has        contiguous
+     *           has         no padding
      *         padding
      *
      * step     <-- D_k+1 * ... * D_ndims-1
@@ -276,35 +276,55 @@ void typed_zero_pad_generic_blocked(const memory_desc_wrapper &m_d,
     assert(step_dim >= 0 && "no zero padding is required");
     if (step_dim < 0) return;
 
-#   pragma omp parallel for
-    for (ptrdiff_t e = 0; e < nelems; e += step) {
-        bool need_zero = false;
+    /* the offset is a sum of per dimension terms: the offsets of the inner
+     * (step) part are tabulated once, so that zeroing a padded row is a
+     * single vectorizable scatter instead of an off_l() per element */
+    const offset_calc_t calc(m_d);
+    nstl::vector<ptrdiff_t> inner_off(step);
+    for (ptrdiff_t e0 = 0; e0 < step; ++e0) {
+        ptrdiff_t off = 0, idx = e0;
+        for (int d = ndims - 1; d > step_dim; --d) {
+            off += calc.dim_off(d, (int)(idx % dims[d]));
+            idx /= dims[d];
+        }
+        inner_off[e0] = off;
+    }
+    const ptrdiff_t *inner = &inner_off[0];
 
-        ptrdiff_t idx = e / step;
+    dims_t zero_pos;
+    utils::array_set(zero_pos, 0, TENSOR_MAX_DIMS);
+    const ptrdiff_t base = (ptrdiff_t)m_d.off_v(zero_pos);
+
+    ptrdiff_t n_outer = 1;
+    for (int d = 0; d <= step_dim; ++d) n_outer *= pdims[d];
+
+    OMP(parallel for schedule(static))//;
+    for (ptrdiff_t o = 0; o < n_outer; ++o) {
+        bool need_zero = false;
+        ptrdiff_t off = base, idx = o;
         for (int d = step_dim; d >= 0; --d) {
-            if (idx % pdims[d] >= dims[d]) {
-                need_zero = true;
-                break;
-            }
+            const int p = (int)(idx % pdims[d]);
+            need_zero = need_zero || p >= dims[d];
+            off += calc.dim_off(d, p);
             idx /= pdims[d];
         }
-
         if (!need_zero) continue;
 
+        auto *d = &data[off];
+        PRAGMA_OMP_SIMD()
         for (ptrdiff_t e0 = 0; e0 < step; ++e0)
-            data[m_d.off_l(e + e0, true)] = 0;
+            d[inner[e0]] = 0;
     }
 }
 
 template <data_type_t dt>
-status_t cpu_memory_t::typed_zero_pad() {
+status_t cpu_memory_t::typed_zero_pad() const {
     const memory_desc_wrapper mpd(&conf_);
 
-    // FIXME: guard this check for non-blocked layout
-    if (mpd.nelems(false) == mpd.nelems(true))
+    if (!mpd.is_blocking_desc() || mpd.nelems(false) == mpd.nelems(true))
         return success;
 
-    auto *data = (typename prec_traits<dt>::type *)data_;
+    auto *data = (typename prec_traits<dt>::type *)this->data();
     const auto fmt = mpd.format();
 
     /* data */
@@ -373,10 +393,10 @@ status_t cpu_memory_t::typed_zero_pad() {
     return unimplemented;
 }
 
-status_t cpu_memory_t::zero_pad() {
+status_t cpu_memory_t::zero_pad() const {
     memory_desc_wrapper md(&conf_);
     const bool skip_zeroing = false
-        || data_ == nullptr
+        || data() == nullptr
         || md.is_zero()
         || !md.is_blocking_desc();
     if (skip_zeroing) return success;
@@ -387,6 +407,7 @@ status_t cpu_memory_t::zero_pad() {
         case s16: return typed_zero_pad<s16>();
         case s8: return typed_zero_pad<s8>();
         case u8: return typed_zero_pad<u8>();
+        case bf16: return typed_zero_pad<bf16>();
         default: assert(!"memory is undefined"); return unimplemented;
     }
     return unimplemented;
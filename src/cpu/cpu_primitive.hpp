@@ -77,6 +77,36 @@ struct cpu_primitive_t: public primitive_t {
                 this->inputs()[index].primitive);
         return p->const_memory(oi);
     }
+
+    /** Zero padding of the blocked memories.
+     *
+     * The padding of a memory is zero: a primitive may read the padding of
+     * its inputs and must not leave garbage in the padding of its outputs.
+     * cpu_memory_t::set_data_handle() zeroes the padding of the buffer;
+     * the primitives that do not preserve it only mark their outputs dirty
+     * and cpu_engine_t::submit() zeroes them right before the next
+     * primitive using the memory, so that clean memories are not rewritten
+     * at every primitive boundary. */
+
+    /** whether execute() keeps the padding of the outputs zero: true for
+     * the kernels that only write the logical elements */
+    virtual bool preserves_zero_padding() const { return true; }
+
+    /** zeroes the padding of output @p output_index if it may be dirty */
+    virtual status_t ensure_zero_padding(size_t output_index = 0) const {
+        if (output_index >= this->outputs().size()) return status::success;
+        auto p = static_cast<const cpu_primitive_t *>(
+                this->outputs()[output_index]);
+        return p == this ? status::success : p->ensure_zero_padding();
+    }
+
+    /** marks the padding of output @p output_index as possibly dirty */
+    virtual void set_zero_padding_dirty(size_t output_index = 0) const {
+        if (output_index >= this->outputs().size()) return;
+        auto p = static_cast<const cpu_primitive_t *>(
+                this->outputs()[output_index]);
+        if (p != this) p->set_zero_padding_dirty();
+    }
 };
 
 }
@@ -284,15 +284,12 @@ inline reducer_2d_driver_t<data_type> *create_reduce_2d_drv(int n_src,
 
 template <impl::data_type_t data_type>
 cpu_reducer_t<data_type>::cpu_reducer_t(const reduce_balancer_t &balancer)
-    : balancer_(balancer), workspace_(nullptr)
-    , drv_(nullptr), barriers_(nullptr)
+    : balancer_(balancer), scratchpad_(nullptr), drv_(nullptr)
 {
-    allocate_workspace();
     if (balancer_.nthr_per_group_ > 1) {
-        barriers_ = (simple_barrier::ctx_t *)malloc(
-                balancer_.ngroups_ * sizeof(simple_barrier::ctx_t), 64);
-        for (int i = 0; i < balancer_.ngroups_; ++i)
-            simple_barrier::ctx_init(&barriers_[i]);
+        scratchpad_ = create_scratchpad(
+                utils::rnd_up(ws_size() * sizeof(data_t), 64)
+                + balancer_.ngroups_ * sizeof(simple_barrier::ctx_t));
         drv_ = create_reduce_2d_drv<data_type>(balancer_.nthr_per_group_ - 1,
                 ws_per_thread(), 0, 0, false);
     }
@@ -300,23 +297,25 @@ cpu_reducer_t<data_type>::cpu_reducer_t(const reduce_balancer_t &balancer)
 
 template <impl::data_type_t data_type>
 cpu_reducer_t<data_type>::~cpu_reducer_t() {
-    deallocate_workspace();
-    free(barriers_);
+    delete scratchpad_;
     delete drv_;
 }
 
 template <impl::data_type_t data_type>
-void cpu_reducer_t<data_type>::allocate_workspace() {
-    if (balancer_.nthr_per_group_ == 1) return;
+typename cpu_reducer_t<data_type>::data_t *
+cpu_reducer_t<data_type>::get_workspace() {
+    if (scratchpad_ == nullptr) return nullptr;
 
-    const size_t ws_size = balancer_.ngroups_ * (balancer_.nthr_per_group_ - 1)
-        * ws_per_thread();
-    workspace_ = (data_t *)malloc(ws_size * sizeof(data_t), PAGE_4K);
+    data_t *workspace = (data_t *)scratchpad_->get();
+    for (int i = 0; i < balancer_.ngroups_; ++i)
+        simple_barrier::ctx_init(&barriers(workspace)[i]);
+    return workspace;
 }
 
 template <impl::data_type_t data_type>
 typename cpu_reducer_t<data_type>::data_t *
-cpu_reducer_t<data_type>::get_local_ptr(int ithr, data_t *dst) {
+cpu_reducer_t<data_type>::get_local_ptr(int ithr, data_t *dst,
+        data_t *workspace) {
     const int id_in_grp = balancer_.id_in_group(ithr);
 
     /* threads 0 from each group writes directly to the destination */
@@ -326,11 +325,12 @@ cpu_reducer_t<data_type>::get_local_ptr(int ithr, data_t *dst) {
     const int grp_id = balancer_.group_id(ithr);
     const int offset_factor = grp_id * (balancer_.nthr_per_group_ - 1)
         + (id_in_grp - 1);
-    return workspace_ + offset_factor * ws_per_thread();
+    return workspace + offset_factor * ws_per_thread();
 }
 
 template <impl::data_type_t data_type>
-void cpu_reducer_t<data_type>::reduce_nolock(int ithr, data_t *dst) {
+void cpu_reducer_t<data_type>::reduce_nolock(int ithr, data_t *dst,
+        data_t *workspace) {
     bool redundant_reduction = balancer_.nthr_per_group_ == 1
         || balancer_.idle(ithr);
     if (redundant_reduction) return;
@@ -340,10 +340,10 @@ void cpu_reducer_t<data_type>::reduce_nolock(int ithr, data_t *dst) {
         return; /* only threads 0 do the reduction */
 
     const int njobs_in_grp = balancer_.ithr_njobs(ithr);
-    data_t *d = get_local_ptr(ithr, dst);
+    data_t *d = get_local_ptr(ithr, dst, workspace);
     for (int id_in_grp = 1; id_in_grp < balancer_.nthr_per_group_; ++id_in_grp)
     {
-        const data_t *wspace = get_local_ptr(ithr + id_in_grp, dst);
+        const data_t *wspace = get_local_ptr(ithr + id_in_grp, dst, workspace);
         for (size_t i = 0; i < (size_t)njobs_in_grp * balancer_.job_size_; ++i)
             d[i] += wspace[i];
     }
@@ -361,8 +361,8 @@ void cpu_reducer_t<data_type>::reduce_nolock(int ithr, data_t *dst) {
 
     if (start == end) return;
 
-    data_t *d = get_local_ptr(ithr - id_in_grp, dst) + start * cl;
-    const data_t *wspace = get_local_ptr(ithr - id_in_grp + 1, dst)
+    data_t *d = get_local_ptr(ithr - id_in_grp, dst, workspace) + start * cl;
+    const data_t *wspace = get_local_ptr(ithr - id_in_grp + 1, dst, workspace)
         + start * cl;
     const size_t len = nstl::min(end * cl, reduction_size) - start * cl;
 
@@ -382,15 +382,12 @@ cpu_reducer_2d_t<data_type>::cpu_reducer_2d_t(
         int dst_x, int dst_y, bool master_uses_dst)
     : balancer_(balancer), master_uses_dst_(master_uses_dst)
     , job_size_x_(job_size_x), job_size_y_(job_size_y), x_block_(x_block)
-    , dst_x_(dst_x), dst_y_(dst_y), workspace_(nullptr), drv_(nullptr)
-    , barriers_(nullptr)
+    , dst_x_(dst_x), dst_y_(dst_y), scratchpad_(nullptr), drv_(nullptr)
 {
-    allocate_workspace();
     if (balancer_.nthr_per_group_ > 1) {
-        barriers_ = (simple_barrier::ctx_t *)malloc(
-                balancer_.ngroups_ * sizeof(simple_barrier::ctx_t), 64);
-        for (int i = 0; i < balancer_.ngroups_; ++i)
-            simple_barrier::ctx_init(&barriers_[i]);
+        scratchpad_ = create_scratchpad(
+                utils::rnd_up(ws_size() * sizeof(data_t), 64)
+                + balancer_.ngroups_ * sizeof(simple_barrier::ctx_t));
         const int n_src = balancer_.nthr_per_group_ - master_uses_dst_;
         drv_ = create_reduce_2d_drv<data_type>(n_src, ws_per_thread(),
                 job_size_x_, dst_x_, !master_uses_dst_);
@@ -399,24 +396,25 @@ cpu_reducer_2d_t<data_type>::cpu_reducer_2d_t(
 
 template <impl::data_type_t data_type>
 cpu_reducer_2d_t<data_type>::~cpu_reducer_2d_t() {
-    deallocate_workspace();
-    free(barriers_);
+    delete scratchpad_;
     delete drv_;
 }
 
 template <impl::data_type_t data_type>
-void cpu_reducer_2d_t<data_type>::allocate_workspace() {
-    if (balancer_.nthr_per_group_ == 1) return;
+typename cpu_reducer_2d_t<data_type>::data_t *
+cpu_reducer_2d_t<data_type>::get_workspace() {
+    if (scratchpad_ == nullptr) return nullptr;
 
-    const size_t ws_size = balancer_.ngroups_
-        * (balancer_.nthr_per_group_ - master_uses_dst_)
-        * ws_per_thread();
-    workspace_ = (data_t *)malloc(ws_size * sizeof(data_t), 64);
+    data_t *workspace = (data_t *)scratchpad_->get();
+    for (int i = 0; i < balancer_.ngroups_; ++i)
+        simple_barrier::ctx_init(&barriers(workspace)[i]);
+    return workspace;
 }
 
 template <impl::data_type_t data_type>
 typename cpu_reducer_2d_t<data_type>::data_t *
-cpu_reducer_2d_t<data_type>::get_local_ptr(int ithr, data_t *dst) {
+cpu_reducer_2d_t<data_type>::get_local_ptr(int ithr, data_t *dst,
+        data_t *workspace) {
     const int id_in_grp = balancer_.id_in_group(ithr);
 
     /* master threads from each group should write directly to the destination
@@ -430,7 +428,7 @@ cpu_reducer_2d_t<data_type>::get_local_ptr(int ithr, data_t *dst) {
     const int offset_factor
         = grp_id * (balancer_.nthr_per_group_ - master_uses_dst_)
         + (id_in_grp - master_uses_dst_);
-    return workspace_ + offset_factor * ws_per_thread();
+    return workspace + offset_factor * ws_per_thread();
 }
 
 template <impl::data_type_t data_type>
@@ -478,7 +476,8 @@ void cpu_reducer_2d_t<data_type>::reduce_block(const data_t* wspace_base,
 }
 
 template <impl::data_type_t data_type>
-void cpu_reducer_2d_t<data_type>::reduce_nolock(int ithr, data_t *dst) {
+void cpu_reducer_2d_t<data_type>::reduce_nolock(int ithr, data_t *dst,
+        data_t *workspace) {
     bool redundant_reduction = balancer_.nthr_per_group_ == 1
         || balancer_.idle(ithr);
     if (redundant_reduction) return;
@@ -488,7 +487,8 @@ void cpu_reducer_2d_t<data_type>::reduce_nolock(int ithr, data_t *dst) {
     const int njobs_x = utils::div_up(dst_x_, job_size_x_);
     const int global_job_start = balancer_.ithr_job_off(ithr);
 
-    const data_t *wspace_base = get_local_ptr(ithr - id_in_grp, nullptr);
+    const data_t *wspace_base = get_local_ptr(ithr - id_in_grp, nullptr,
+            workspace);
 
     const int pr_grps = nstl::min(njobs_in_grp, balancer_.nthr_per_group_);
     const int pr_nthr_per_grp = balancer_.nthr_per_group_ / pr_grps;
@@ -23,6 +23,7 @@
 #include "mkldnn_thread.hpp"
 #include "mkldnn_types.h"
 #include "nstl.hpp"
+#include "scratchpad.hpp"
 #include "type_helpers.hpp"
 
 #include "cpu_barrier.hpp"
@@ -156,11 +157,11 @@ struct cpu_reducer_t {
     cpu_reducer_t(const reduce_balancer_t &balancer);
     ~cpu_reducer_t();
 
-    /** allocates internal buffer for partial computations. */
-    void allocate_workspace();
-
-    /** deallocates internal buffer. */
-    void deallocate_workspace() { if (workspace_) free(workspace_); }
+    /** returns the buffer for partial computations of the call in progress,
+     * with its barriers reset, to be passed to get_local_ptr() and reduce().
+     * Must be called outside of parallel regions (see scratchpad_t::get()).
+     */
+    data_t *get_workspace();
 
     /** for given thread returns the pointer where to put partial results.
      * Reduction destination @p dst must be provided as well (master threads
@@ -171,17 +172,18 @@ struct cpu_reducer_t {
      *        threads should start writing from the very beginning of returned
      *        address.
      */
-    data_t *get_local_ptr(int ithr, data_t *dst);
+    data_t *get_local_ptr(int ithr, data_t *dst, data_t *workspace);
 
     /** performs the reduction with built-in synchronization. */
-    void reduce(int ithr, data_t *dst) {
+    void reduce(int ithr, data_t *dst, data_t *workspace) {
         bool redundant_reduction = balancer_.nthr_per_group_ == 1
             || balancer_.idle(ithr);
         if (redundant_reduction) return;
 
-        simple_barrier::barrier(&barriers_[balancer_.group_id(ithr)],
+        simple_barrier::barrier(
+                &barriers(workspace)[balancer_.group_id(ithr)],
                 balancer_.nthr_per_group_);
-        reduce_nolock(ithr, dst);
+        reduce_nolock(ithr, dst, workspace);
     }
 
     reduce_balancer_t balancer_;
@@ -190,11 +192,23 @@ private:
     size_t ws_per_thread() const
     { return balancer_.njobs_per_group_ub_ * balancer_.job_size_; }
 
-    data_t *workspace_; /** data_t[nthr_][njobs_per_group_ub_][jobs_size_] */
+    size_t ws_size() const {
+        return balancer_.ngroups_ * (balancer_.nthr_per_group_ - 1)
+            * ws_per_thread();
+    }
+
+    /** the barriers of the groups follow the partial results */
+    simple_barrier::ctx_t *barriers(data_t *workspace) const {
+        return (simple_barrier::ctx_t *)((char *)workspace
+                + utils::rnd_up(ws_size() * sizeof(data_t), 64));
+    }
+
+    /** per call: data_t[nthr_][njobs_per_group_ub_][jobs_size_] followed by
+     * barrier::ctx_t[groups_] */
+    scratchpad_t *scratchpad_;
     reducer_2d_driver_t<data_type> *drv_;
-    simple_barrier::ctx_t *barriers_; /** barrier::ctx_t[groups_] */
 
-    void reduce_nolock(int ithr, data_t *dst);
+    void reduce_nolock(int ithr, data_t *dst, data_t *workspace);
 };
 
 template <impl::data_type_t data_type>
@@ -206,11 +220,11 @@ struct cpu_reducer_2d_t {
             bool master_uses_dst);
     ~cpu_reducer_2d_t();
 
-    /** allocates internal buffer for partial computations. */
-    void allocate_workspace();
-
-    /** deallocates internal buffer. */
-    void deallocate_workspace() { if (workspace_) free(workspace_); }
+    /** returns the buffer for partial computations of the call in progress,
+     * with its barriers reset, to be passed to get_local_ptr() and reduce().
+     * Must be called outside of parallel regions (see scratchpad_t::get()).
+     */
+    data_t *get_workspace();
 
     /** for given thread returns the pointer where to put partial results.
      * Depending on @p master_uses_dst_ returned pointer for master threads
@@ -220,17 +234,18 @@ struct cpu_reducer_2d_t {
      *
      * @note: @p master_uses_dst_ == #false is unimplemented at the moment
      */
-    data_t *get_local_ptr(int ithr, data_t *dst);
+    data_t *get_local_ptr(int ithr, data_t *dst, data_t *workspace);
 
     /** performs the reduction with built-in synchronization. */
-    void reduce(int ithr, data_t *dst) {
+    void reduce(int ithr, data_t *dst, data_t *workspace) {
         bool redundant_reduction = balancer_.nthr_per_group_ == 1
             || balancer_.idle(ithr);
         if (redundant_reduction) return;
 
-        simple_barrier::barrier(&barriers_[balancer_.group_id(ithr)],
+        simple_barrier::barrier(
+                &barriers(workspace)[balancer_.group_id(ithr)],
                 balancer_.nthr_per_group_);
-        reduce_nolock(ithr, dst);
+        reduce_nolock(ithr, dst, workspace);
     }
 
     reduce_balancer_t balancer_;
@@ -242,15 +257,28 @@ private:
     size_t ws_per_thread() const
     { return balancer_.njobs_per_group_ub_ * balancer_.job_size_; }
 
-    data_t *workspace_; /** data_t[nthr_][njobs_per_group_ub_][jobs_size_] */
+    size_t ws_size() const {
+        return balancer_.ngroups_
+            * (balancer_.nthr_per_group_ - master_uses_dst_)
+            * ws_per_thread();
+    }
+
+    /** the barriers of the groups follow the partial results */
+    simple_barrier::ctx_t *barriers(data_t *workspace) const {
+        return (simple_barrier::ctx_t *)((char *)workspace
+                + utils::rnd_up(ws_size() * sizeof(data_t), 64));
+    }
+
+    /** per call: data_t[nthr_][njobs_per_group_ub_][jobs_size_] followed by
+     * barrier::ctx_t[groups_] */
+    scratchpad_t *scratchpad_;
     reducer_2d_driver_t<data_type> *drv_;
-    simple_barrier::ctx_t *barriers_; /** barrier::ctx_t[groups_] */
 
     int choose_x_blocking(int nx, int ny, int nthr_per_grp);
     void reduce_block(const data_t* wspace_base,
             data_t *dst, int job, int start_y, int start_x,
             int ny_start, int nx_start, int ny_step, int nx_step);
-    void reduce_nolock(int ithr, data_t *dst);
+    void reduce_nolock(int ithr, data_t *dst, data_t *workspace);
 };
 
 /** simple 1d accumulator: y[:] += x[:] */
@@ -22,7 +22,10 @@
 
 #ifndef TARGET_VANILLA
 #include "cpu/jit_uni_reorder.hpp"
+#else
+#include "tr_reorder.hpp"
 #endif
+#include "bcsr_reorder.hpp"
 #include "simple_reorder.hpp"
 #include "wino_reorder.hpp"
 
@@ -47,11 +50,16 @@ using namespace mkldnn::impl::memory_format;
     REG_SR(idt, any, odt, any, fmt_order::any, spec::direct_copy), \
     REG_SR(idt, any, odt, any, fmt_order::any, spec::direct_copy_except_dim_0)
 
+#define REG_TR(idt, odt) tr_reorder_t<idt, odt>::pd_t::create
+
 static const rpd_create_f cpu_reorder_impl_list[] = {
     /* winograd */
     wino_reorder_t<f32, f32>::pd_t::create,
     wino_reorder_t<f32, s8>::pd_t::create,
 
+    /* block-CSR */
+    bcsr_reorder_t::pd_t::create,
+
 #if defined(__INTEL_COMPILER) || defined(__ve) || defined(_SX)
     /* direct copy for icc, which is faster than jitted code */
     REG_SR_DIRECT_COPY(f32, f32),
@@ -75,6 +83,37 @@ static const rpd_create_f cpu_reorder_impl_list[] = {
 #if !defined(TARGET_VANILLA)
     /* jit */
     jit_uni_reorder_create,
+#else
+    /* portable transpose-based reorder, same problem decomposition as jit */
+    REG_TR(f32, f32),
+    REG_TR(f32, s32),
+    REG_TR(f32, s16),
+    REG_TR(f32, s8),
+    REG_TR(f32, u8),
+
+    REG_TR(s32, f32),
+    REG_TR(s32, s32),
+    REG_TR(s32, s16),
+    REG_TR(s32, s8),
+    REG_TR(s32, u8),
+
+    REG_TR(s16, f32),
+    REG_TR(s16, s32),
+    REG_TR(s16, s16),
+
+    REG_TR(s8, f32),
+    REG_TR(s8, s32),
+    REG_TR(s8, s8),
+    REG_TR(s8, u8),
+
+    REG_TR(u8, f32),
+    REG_TR(u8, s32),
+    REG_TR(u8, u8),
+    REG_TR(u8, s8),
+
+    REG_TR(f32, bf16),
+    REG_TR(bf16, f32),
+    REG_TR(bf16, bf16),
 #endif
 
 #if 1 || MKLDNN_JIT_TYPES > 0
@@ -162,6 +201,10 @@ static const rpd_create_f cpu_reorder_impl_list[] = {
     REG_SR(u8, any, u8, any, fmt_order::any, spec::reference),
     REG_SR(u8, any, s8, any, fmt_order::any, spec::reference),
 
+    REG_SR(f32, any, bf16, any, fmt_order::any, spec::reference),
+    REG_SR(bf16, any, f32, any, fmt_order::any, spec::reference),
+    REG_SR(bf16, any, bf16, any, fmt_order::any, spec::reference),
+
     /* eol */
     nullptr,
 };
@@ -32,6 +32,9 @@ namespace {
 #define INSTANCE(...) __VA_ARGS__::pd_t::create
 static const spd_create_f cpu_sum_impl_list[] = {
     INSTANCE(simple_sum_t<data_type::f32>),
+    INSTANCE(simple_sum_t<data_type::s32>),
+    INSTANCE(simple_sum_t<data_type::s8>),
+    INSTANCE(simple_sum_t<data_type::u8>),
     INSTANCE(ref_sum_t),
     nullptr,
 };
@@ -51,6 +51,8 @@ namespace cpu {
             printf("mkldnn_verbose,create,%s,%g\n", this->info(), ms); \
             fflush(0); \
         } \
+        if (profiling_enabled()) \
+            profiling_record(mkldnn_profiling_create, this, ms); \
         return ret; \
     } \
     virtual pd_t *clone() const override { return nullptr; } \
@@ -0,0 +1,405 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "dw_convolution.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_format;
+
+namespace dw_convolution {
+
+strides_t::strides_t(const memory_pd_t *pd) {
+    const memory_desc_wrapper md(pd);
+    const blocking_desc_t &blk = md.blocking_desc();
+    const bool is_wei = md.ndims() == 5;
+    const int c = is_wei ? 0 : 1, h = md.ndims() - 2, w = md.ndims() - 1;
+    base = blk.offset_padding;
+    sn = is_wei ? 0 : blk.strides[0][0];
+    sc = blk.strides[0][c];
+    sci = blk.strides[1][c];
+    cblk = blk.block_dims[c];
+    sh = blk.strides[0][h];
+    sw = blk.strides[0][w];
+}
+
+bool act_format_ok(memory_format_t act) {
+    return utils::one_of(act, nchw, nhwc, nChw8c, nChw16c);
+}
+
+bool wei_format_ok(memory_format_t act, memory_format_t wei) {
+    switch (act) {
+    case nChw8c: return utils::one_of(wei, goihw, hwigo, Goihw8g);
+    case nChw16c: return utils::one_of(wei, goihw, hwigo, Goihw16g);
+    default: return utils::one_of(wei, goihw, hwigo, Goihw8g, Goihw16g);
+    }
+}
+
+memory_format_t default_wei_format(memory_format_t act) {
+    switch (act) {
+    case nhwc: return hwigo;
+    case nChw8c: return Goihw8g;
+    case nChw16c: return Goihw16g;
+    default: return goihw;
+    }
+}
+
+int simd_w(memory_format_t act, memory_format_t wei) {
+    switch (act) {
+    case nchw: return 0;
+    case nChw8c: return 8;
+    case nChw16c: return 16;
+    default: return wei == Goihw8g ? 8 : 16;
+    }
+}
+
+namespace {
+
+inline float relu(const conf_t &c, float d) {
+    return (c.with_relu && d < 0.f) ? d * c.relu_negative_slope : d;
+}
+
+/* Kernels along the width (nchw): the pointers are at channel ch of image
+ * n, the rows of the activations are contiguous. */
+
+void fwd_w(const conf_t &c, const window_taps_t &th, const window_taps_t &tw,
+        const strides_t &ss, const strides_t &ws, const strides_t &ds,
+        const float *src, const float *wei, float bias, float *dst, int oh) {
+    float *d = dst + oh * ds.sh;
+    PRAGMA_OMP_SIMD()
+    for (int ow = 0; ow < c.ow; ++ow) d[ow] = bias;
+
+    for (int kh = th.k_beg(oh); kh < th.k_end(oh); ++kh) {
+        const float *s = src + (oh * c.str_h - c.t_pad + kh * c.dil_h) * ss.sh;
+        for (int kw = 0; kw < c.kw; ++kw) {
+            const float w = wei[kh * ws.sh + kw * ws.sw];
+            const int off = kw * c.dil_w - c.l_pad;
+            PRAGMA_OMP_SIMD()
+            for (int ow = tw.o_beg(kw); ow < tw.o_end(kw); ++ow)
+                d[ow] += w * s[ow * c.str_w + off];
+        }
+    }
+
+    if (c.with_relu) {
+        PRAGMA_OMP_SIMD()
+        for (int ow = 0; ow < c.ow; ++ow) d[ow] = relu(c, d[ow]);
+    }
+}
+
+void bwd_d_w(const conf_t &c, const window_taps_t &th,
+        const window_taps_t &tw, const strides_t &dss, const strides_t &ws,
+        const strides_t &dds, float *diff_src, const float *wei,
+        const float *diff_dst, int ih) {
+    float *ds = diff_src + ih * dss.sh;
+    PRAGMA_OMP_SIMD()
+    for (int iw = 0; iw < c.iw; ++iw) ds[iw] = 0.f;
+
+    for (int t = 0; t < th.bn(ih); ++t) {
+        const int kh = th.bk_beg(ih) + t * th.bk_step();
+        const float *dd = diff_dst
+            + (th.bo_beg(ih) - t * th.bo_step()) * dds.sh;
+        for (int kw = 0; kw < c.kw; ++kw) {
+            const float w = wei[kh * ws.sh + kw * ws.sw];
+            const int off = kw * c.dil_w - c.l_pad;
+            PRAGMA_OMP_SIMD()
+            for (int ow = tw.o_beg(kw); ow < tw.o_end(kw); ++ow)
+                ds[ow * c.str_w + off] += w * dd[ow];
+        }
+    }
+}
+
+void bwd_w_w(const conf_t &c, const window_taps_t &th,
+        const window_taps_t &tw, const strides_t &ss, const strides_t &dws,
+        const strides_t &dds, const float *src, float *diff_wei,
+        const float *diff_dst, float *diff_bias, int kh) {
+    for (int kw = 0; kw < c.kw; ++kw) {
+        const int off = kw * c.dil_w - c.l_pad;
+        float acc = 0.f;
+        for (int n = 0; n < c.mb; ++n)
+        for (int oh = th.o_beg(kh); oh < th.o_end(kh); ++oh) {
+            const float *s = src + n * ss.sn
+                + (oh * c.str_h - c.t_pad + kh * c.dil_h) * ss.sh;
+            const float *dd = diff_dst + n * dds.sn + oh * dds.sh;
+            PRAGMA_OMP_SIMD(reduction(+:acc))
+            for (int ow = tw.o_beg(kw); ow < tw.o_end(kw); ++ow)
+                acc += s[ow * c.str_w + off] * dd[ow];
+        }
+        diff_wei[kh * dws.sh + kw * dws.sw] = acc;
+    }
+
+    if (diff_bias == nullptr) return;
+    float db = 0.f;
+    for (int n = 0; n < c.mb; ++n)
+    for (int oh = 0; oh < c.oh; ++oh) {
+        const float *dd = diff_dst + n * dds.sn + oh * dds.sh;
+        PRAGMA_OMP_SIMD(reduction(+:db))
+        for (int ow = 0; ow < c.ow; ++ow) db += dd[ow];
+    }
+    *diff_bias = db;
+}
+
+/* Kernels along the channels (nhwc, nChw8c, nChw16c): the pointers are at
+ * the first channel c0 of a group of len <= V channels (of image n for the
+ * activations), the channels of a group are contiguous in the activations
+ * and ws.c_lane() apart in the weights. The \p full groups have the
+ * compile-time width. Padded channels of the blocked layouts are written
+ * with zeros. */
+
+template <int V, bool full>
+void fwd_c(const conf_t &c, const window_taps_t &th, const window_taps_t &tw,
+        const strides_t &ss, const strides_t &ws, const strides_t &ds,
+        const float *src, const float *wei, const float *bias, float *dst,
+        int oh, int len) {
+    const int l = full ? V : len;
+    const ptrdiff_t wl = ws.c_lane();
+    for (int ow = 0; ow < c.ow; ++ow) {
+        float acc[V];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < V; ++i) acc[i] = 0.f;
+
+        for (int kh = th.k_beg(oh); kh < th.k_end(oh); ++kh) {
+            const int ih = oh * c.str_h - c.t_pad + kh * c.dil_h;
+            for (int kw = tw.k_beg(ow); kw < tw.k_end(ow); ++kw) {
+                const int iw = ow * c.str_w - c.l_pad + kw * c.dil_w;
+                const float *s = src + ih * ss.sh + iw * ss.sw;
+                const float *w = wei + kh * ws.sh + kw * ws.sw;
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < l; ++i) acc[i] += s[i] * w[i * wl];
+            }
+        }
+
+        float *d = dst + oh * ds.sh + ow * ds.sw;
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < l; ++i)
+            d[i] = relu(c, acc[i] + (bias ? bias[i] : 0.f));
+        if (!full && ds.cblk > 1)
+            for (int i = l; i < V; ++i) d[i] = 0.f;
+    }
+}
+
+template <int V, bool full>
+void bwd_d_c(const conf_t &c, const window_taps_t &th,
+        const window_taps_t &tw, const strides_t &dss, const strides_t &ws,
+        const strides_t &dds, float *diff_src, const float *wei,
+        const float *diff_dst, int ih, int len) {
+    const int l = full ? V : len;
+    const ptrdiff_t wl = ws.c_lane();
+    for (int iw = 0; iw < c.iw; ++iw) {
+        float acc[V];
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < V; ++i) acc[i] = 0.f;
+
+        for (int t = 0; t < th.bn(ih); ++t) {
+            const int kh = th.bk_beg(ih) + t * th.bk_step();
+            const int oh = th.bo_beg(ih) - t * th.bo_step();
+            for (int u = 0; u < tw.bn(iw); ++u) {
+                const int kw = tw.bk_beg(iw) + u * tw.bk_step();
+                const int ow = tw.bo_beg(iw) - u * tw.bo_step();
+                const float *dd = diff_dst + oh * dds.sh + ow * dds.sw;
+                const float *w = wei + kh * ws.sh + kw * ws.sw;
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < l; ++i) acc[i] += dd[i] * w[i * wl];
+            }
+        }
+
+        float *ds = diff_src + ih * dss.sh + iw * dss.sw;
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < l; ++i) ds[i] = acc[i];
+        if (!full && dss.cblk > 1)
+            for (int i = l; i < V; ++i) ds[i] = 0.f;
+    }
+}
+
+template <int V, bool full>
+void bwd_w_c(const conf_t &c, const window_taps_t &th,
+        const window_taps_t &tw, const strides_t &ss, const strides_t &dws,
+        const strides_t &dds, const float *src, float *diff_wei,
+        const float *diff_dst, float *diff_bias, int kh, int len) {
+    const int l = full ? V : len;
+    const ptrdiff_t wl = dws.c_lane();
+    float acc[V];
+    for (int kw = 0; kw < c.kw; ++kw) {
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < V; ++i) acc[i] = 0.f;
+
+        for (int n = 0; n < c.mb; ++n)
+        for (int oh = th.o_beg(kh); oh < th.o_end(kh); ++oh) {
+            const int ih = oh * c.str_h - c.t_pad + kh * c.dil_h;
+            for (int ow = tw.o_beg(kw); ow < tw.o_end(kw); ++ow) {
+                const int iw = ow * c.str_w - c.l_pad + kw * c.dil_w;
+                const float *s = src + n * ss.sn + ih * ss.sh + iw * ss.sw;
+                const float *dd = diff_dst + n * dds.sn + oh * dds.sh
+                    + ow * dds.sw;
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < l; ++i) acc[i] += s[i] * dd[i];
+            }
+        }
+
+        float *dw = diff_wei + kh * dws.sh + kw * dws.sw;
+        for (int i = 0; i < l; ++i) dw[i * wl] = acc[i];
+    }
+
+    if (diff_bias == nullptr) return;
+    PRAGMA_OMP_SIMD()
+    for (int i = 0; i < V; ++i) acc[i] = 0.f;
+    for (int n = 0; n < c.mb; ++n)
+    for (int oh = 0; oh < c.oh; ++oh)
+    for (int ow = 0; ow < c.ow; ++ow) {
+        const float *dd = diff_dst + n * dds.sn + oh * dds.sh + ow * dds.sw;
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < l; ++i) acc[i] += dd[i];
+    }
+    for (int i = 0; i < l; ++i) diff_bias[i] = acc[i];
+}
+
+}
+
+}
+
+using namespace dw_convolution;
+
+/* kernel<V, full>(...) for the vector width and the group length of the
+ * call site (c_, len) */
+#define DW_DISPATCH(kernel, ...) do { \
+    const bool full = len == c_.simd_w; \
+    if (c_.simd_w == 8) { \
+        if (full) kernel<8, true>(__VA_ARGS__); \
+        else kernel<8, false>(__VA_ARGS__); \
+    } else { \
+        if (full) kernel<16, true>(__VA_ARGS__); \
+        else kernel<16, false>(__VA_ARGS__); \
+    } \
+} while (0)
+
+template <bool with_relu>
+void _dw_convolution_fwd_t<with_relu>::execute_forward() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<data_t *>(this->memory());
+
+    const strides_t &ss = src_s_, &ws = wei_s_, &ds = dst_s_;
+    const data_t *_bias = c_.with_bias ? bias : nullptr;
+
+    if (c_.simd_w == 0) {
+        parallel_nd(c_.mb, c_.c, c_.oh, [&](int n, int ch, int oh) {
+            fwd_w(c_, taps_h_, taps_w_, ss, ws, ds,
+                    src + ss.base + n * ss.sn + ss.c_off(ch),
+                    weights + ws.base + ws.c_off(ch),
+                    _bias ? _bias[ch] : 0.f,
+                    dst + ds.base + n * ds.sn + ds.c_off(ch), oh);
+        });
+        return;
+    }
+
+    const int nchk = utils::div_up(c_.c, c_.simd_w);
+    parallel_nd(c_.mb, nchk, c_.oh, [&](int n, int chk, int oh) {
+        const int c0 = chk * c_.simd_w;
+        const int len = nstl::min(c_.simd_w, c_.c - c0);
+        DW_DISPATCH(fwd_c, c_, taps_h_, taps_w_, ss, ws, ds,
+                src + ss.base + n * ss.sn + ss.c_off(c0),
+                weights + ws.base + ws.c_off(c0),
+                _bias ? _bias + c0 : nullptr,
+                dst + ds.base + n * ds.sn + ds.c_off(c0), oh, len);
+    });
+}
+
+template struct _dw_convolution_fwd_t<true>;
+template struct _dw_convolution_fwd_t<false>;
+
+void dw_convolution_bwd_data_t::execute_backward_data() {
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto diff_src = reinterpret_cast<data_t *>(this->memory());
+
+    const strides_t &dss = diff_src_s_, &ws = wei_s_, &dds = diff_dst_s_;
+
+    if (c_.simd_w == 0) {
+        parallel_nd(c_.mb, c_.c, c_.ih, [&](int n, int ch, int ih) {
+            bwd_d_w(c_, taps_h_, taps_w_, dss, ws, dds,
+                    diff_src + dss.base + n * dss.sn + dss.c_off(ch),
+                    weights + ws.base + ws.c_off(ch),
+                    diff_dst + dds.base + n * dds.sn + dds.c_off(ch), ih);
+        });
+        return;
+    }
+
+    const int nchk = utils::div_up(c_.c, c_.simd_w);
+    parallel_nd(c_.mb, nchk, c_.ih, [&](int n, int chk, int ih) {
+        const int c0 = chk * c_.simd_w;
+        const int len = nstl::min(c_.simd_w, c_.c - c0);
+        DW_DISPATCH(bwd_d_c, c_, taps_h_, taps_w_, dss, ws, dds,
+                diff_src + dss.base + n * dss.sn + dss.c_off(c0),
+                weights + ws.base + ws.c_off(c0),
+                diff_dst + dds.base + n * dds.sn + dds.c_off(c0), ih, len);
+    });
+}
+
+void dw_convolution_bwd_weights_t::execute_backward_weights() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto diff_weights = reinterpret_cast<data_t *>(this->memory(0));
+    auto diff_bias = reinterpret_cast<data_t *>(this->memory(1));
+
+    const strides_t &ss = src_s_, &dws = diff_wei_s_, &dds = diff_dst_s_;
+
+    /* a work item owns the kh row of the weights of its channels, and the
+     * items of row 0 the bias: no reduction */
+    if (c_.simd_w == 0) {
+        parallel_nd(c_.c, c_.kh, [&](int ch, int kh) {
+            bwd_w_w(c_, taps_h_, taps_w_, ss, dws, dds,
+                    src + ss.base + ss.c_off(ch),
+                    diff_weights + dws.base + dws.c_off(ch),
+                    diff_dst + dds.base + dds.c_off(ch),
+                    c_.with_bias && kh == 0 ? diff_bias + ch : nullptr, kh);
+        });
+    } else {
+        const int nchk = utils::div_up(c_.c, c_.simd_w);
+        parallel_nd(nchk, c_.kh, [&](int chk, int kh) {
+            const int c0 = chk * c_.simd_w;
+            const int len = nstl::min(c_.simd_w, c_.c - c0);
+            DW_DISPATCH(bwd_w_c, c_, taps_h_, taps_w_, ss, dws, dds,
+                    src + ss.base + ss.c_off(c0),
+                    diff_weights + dws.base + dws.c_off(c0),
+                    diff_dst + dds.base + dds.c_off(c0),
+                    c_.with_bias && kh == 0 ? diff_bias + c0 : nullptr, kh,
+                    len);
+        });
+    }
+
+    /* the padded groups of Goihw8g / Goihw16g */
+    const int c_padded = utils::rnd_up(c_.c, dws.cblk);
+    for (int g = c_.c; g < c_padded; ++g)
+    for (int kh = 0; kh < c_.kh; ++kh)
+    for (int kw = 0; kw < c_.kw; ++kw)
+        diff_weights[dws.base + dws.c_off(g) + kh * dws.sh + kw * dws.sw] = 0;
+}
+
+#undef DW_DISPATCH
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
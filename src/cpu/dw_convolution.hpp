@@ -0,0 +1,360 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_DW_CONVOLUTION_HPP
+#define CPU_DW_CONVOLUTION_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_convolution_pd.hpp"
+#include "cpu_engine.hpp"
+#include "idiv.hpp"
+#include "memory_desc_wrapper.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Portable depthwise convolution (ngroups == ic == oc, 2D, f32) for the
+ * engines without the jit_uni_dw kernels. nchw is processed a row at a time
+ * along the width; nhwc, nChw8c and nChw16c along the channels, simd_w()
+ * channels at a time. The valid kernel taps come from window_taps_t, so
+ * the inner loops have no bounds checks. */
+namespace dw_convolution {
+
+/** The strides of an operand: activations (n, c, h, w) or weights
+ * (g, 1, 1, kh, kw), g playing the part of c. The offset of an element is
+ * base + n * sn + (c / cblk) * sc + (c % cblk) * sci + h * sh + w * sw. */
+struct strides_t {
+    strides_t(const memory_pd_t *pd);
+
+    ptrdiff_t c_off(int c) const { return (c / cblk) * sc + (c % cblk) * sci; }
+    /** the distance between two channels of a simd_w() group */
+    ptrdiff_t c_lane() const { return cblk > 1 ? sci : sc; }
+
+    ptrdiff_t base, sn, sc, sci, sh, sw;
+    int cblk;
+};
+
+/** the activations formats of the kernels */
+bool act_format_ok(memory_format_t act);
+/** the weights formats usable with the activations format \p act */
+bool wei_format_ok(memory_format_t act, memory_format_t wei);
+/** the weights format matching \p act, taken when the user asks for any */
+memory_format_t default_wei_format(memory_format_t act);
+/** channels per vector for the layouts vectorized along the channels (a
+ * group of channels never straddles a block), 0 for nchw */
+int simd_w(memory_format_t act, memory_format_t wei);
+
+struct conf_t {
+    int mb, c, ih, iw, oh, ow, kh, kw;
+    int str_h, str_w, t_pad, l_pad, dil_h, dil_w; /* dil: 1 + dilation */
+    int simd_w;
+    bool with_bias, with_relu;
+    float relu_negative_slope;
+};
+
+template <typename pd_t>
+void init_conf(conf_t &c, const pd_t *pd, memory_format_t act,
+        memory_format_t wei) {
+    c.mb = pd->MB(); c.c = pd->G();
+    c.ih = pd->IH(); c.iw = pd->IW();
+    c.oh = pd->OH(); c.ow = pd->OW();
+    c.kh = pd->KH(); c.kw = pd->KW();
+    c.str_h = pd->KSH(); c.str_w = pd->KSW();
+    c.t_pad = pd->padT(); c.l_pad = pd->padL();
+    c.dil_h = 1 + pd->KDH(); c.dil_w = 1 + pd->KDW();
+    c.simd_w = simd_w(act, wei);
+    c.with_bias = pd->with_bias();
+    c.with_relu = false;
+    c.relu_negative_slope = 0.f;
+}
+
+/** a depthwise problem: one input and one output channel per group */
+template <typename pd_t>
+bool is_depthwise(const pd_t *pd) {
+    return pd->ndims() == 4 && pd->with_groups()
+        && pd->G() == pd->IC() && pd->G() == pd->OC();
+}
+
+}
+
+template <bool with_relu>
+struct _dw_convolution_fwd_t: public cpu_primitive_t {
+    struct pd_t: public _cpu_convolution_fwd_pd_t<with_relu> {
+        pd_t(engine_t *engine,
+                const typename pd_t::base_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const typename pd_t::base_class *hint_fwd_pd)
+            : _cpu_convolution_fwd_pd_t<with_relu>(engine, adesc, attr,
+                    hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("dw:any", _dw_convolution_fwd_t<with_relu>);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            assert(this->engine()->kind() == engine_kind::cpu);
+
+            const auto &po = this->attr()->post_ops_;
+            const auto act = this->src_pd_.desc()->format;
+            bool ok = true
+                && this->set_default_params() == status::success
+                && utils::one_of(this->cdesc_().prop_kind, forward_training,
+                        forward_inference)
+                && this->cdesc_().alg_kind == alg_kind::convolution_direct
+                && !this->has_zero_dim_memory()
+                && dw_convolution::is_depthwise(this)
+                && utils::everyone_is(data_type::f32,
+                        this->cdesc_().src_desc.data_type,
+                        this->cdesc_().weights_desc.data_type,
+                        this->cdesc_().dst_desc.data_type)
+                && utils::implication(this->with_bias(),
+                        data_type::f32 == this->cdesc_().bias_desc.data_type)
+                && dw_convolution::act_format_ok(act)
+                && this->dst_pd_.desc()->format == act
+                && dw_convolution::wei_format_ok(act,
+                        this->weights_pd_.desc()->format)
+                && this->attr()->output_scales_.has_default_values()
+                && po.len_ <= 1
+                && utils::implication(po.len_ == 1,
+                        po.entry_[0].is_relu(true, false));
+            return ok ? status::success : status::unimplemented;
+        }
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->src_pd_.desc()->format == any)
+                CHECK(this->src_pd_.set_format(nChw8c));
+            if (this->dst_pd_.desc()->format == any)
+                CHECK(this->dst_pd_.set_format(
+                            this->src_pd_.desc()->format));
+            if (this->weights_pd_.desc()->format == any)
+                CHECK(this->weights_pd_.set_format(
+                            dw_convolution::default_wei_format(
+                                this->src_pd_.desc()->format)));
+            if (this->bias_pd_.desc()->format == any)
+                CHECK(this->bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    _dw_convolution_fwd_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , src_s_(conf_.src_pd()), wei_s_(conf_.weights_pd())
+        , dst_s_(conf_.dst_pd())
+        , taps_h_(conf_.OH(), conf_.IH(), conf_.KH(), conf_.KSH(),
+                conf_.padT(), 1 + conf_.KDH())
+        , taps_w_(conf_.OW(), conf_.IW(), conf_.KW(), conf_.KSW(),
+                conf_.padL(), 1 + conf_.KDW())
+    {
+        dw_convolution::init_conf(c_, &conf_, conf_.src_pd()->desc()->format,
+                conf_.weights_pd()->desc()->format);
+        const auto &po = conf_.attr()->post_ops_;
+        c_.with_relu = with_relu || po.len_ == 1;
+        c_.relu_negative_slope = with_relu ? conf_.negative_slope()
+            : po.len_ == 1 ? po.entry_[0].eltwise.alpha : 0.f;
+    }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward();
+    pd_t conf_;
+    dw_convolution::conf_t c_;
+    const dw_convolution::strides_t src_s_, wei_s_, dst_s_;
+    const window_taps_t taps_h_, taps_w_;
+};
+
+using dw_convolution_fwd_t = _dw_convolution_fwd_t<false>;
+using dw_convolution_relu_t = _dw_convolution_fwd_t<true>;
+
+struct dw_convolution_bwd_data_t: public cpu_primitive_t {
+    struct pd_t: public cpu_convolution_bwd_data_pd_t {
+        pd_t(engine_t *engine,
+                const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_bwd_data_pd_t(engine, adesc, attr, hint_fwd_pd)
+        {}
+
+        DECLARE_COMMON_PD_T("dw:any", dw_convolution_bwd_data_t);
+
+        virtual status_t init() override {
+            assert(this->engine()->kind() == engine_kind::cpu);
+
+            const auto act = this->diff_src_pd_.desc()->format;
+            bool ok = true
+                && this->set_default_params() == status::success
+                && utils::one_of(this->desc()->prop_kind, prop_kind::backward,
+                        prop_kind::backward_data)
+                && this->desc()->alg_kind == alg_kind::convolution_direct
+                && !this->has_zero_dim_memory()
+                && dw_convolution::is_depthwise(this)
+                && utils::everyone_is(data_type::f32,
+                        this->desc()->diff_src_desc.data_type,
+                        this->desc()->weights_desc.data_type,
+                        this->desc()->diff_dst_desc.data_type)
+                && dw_convolution::act_format_ok(act)
+                && this->diff_dst_pd_.desc()->format == act
+                && dw_convolution::wei_format_ok(act,
+                        this->weights_pd_.desc()->format);
+            return ok ? status::success : status::unimplemented;
+        }
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->diff_src_pd_.desc()->format == any)
+                CHECK(this->diff_src_pd_.set_format(nChw8c));
+            if (this->diff_dst_pd_.desc()->format == any)
+                CHECK(this->diff_dst_pd_.set_format(
+                            this->diff_src_pd_.desc()->format));
+            if (this->weights_pd_.desc()->format == any)
+                CHECK(this->weights_pd_.set_format(
+                            dw_convolution::default_wei_format(
+                                this->diff_src_pd_.desc()->format)));
+            return status::success;
+        }
+    };
+
+    dw_convolution_bwd_data_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , diff_src_s_(conf_.diff_src_pd()), wei_s_(conf_.weights_pd())
+        , diff_dst_s_(conf_.diff_dst_pd())
+        , taps_h_(conf_.OH(), conf_.IH(), conf_.KH(), conf_.KSH(),
+                conf_.padT(), 1 + conf_.KDH())
+        , taps_w_(conf_.OW(), conf_.IW(), conf_.KW(), conf_.KSW(),
+                conf_.padL(), 1 + conf_.KDW())
+    {
+        dw_convolution::init_conf(c_, &conf_,
+                conf_.diff_src_pd()->desc()->format,
+                conf_.weights_pd()->desc()->format);
+    }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) {
+        execute_backward_data();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward_data();
+    pd_t conf_;
+    dw_convolution::conf_t c_;
+    const dw_convolution::strides_t diff_src_s_, wei_s_, diff_dst_s_;
+    const window_taps_t taps_h_, taps_w_;
+};
+
+struct dw_convolution_bwd_weights_t: public cpu_primitive_t {
+    struct pd_t: public cpu_convolution_bwd_weights_pd_t {
+        pd_t(engine_t *engine,
+                const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_bwd_weights_pd_t(engine, adesc, attr,
+                    hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("dw:any", dw_convolution_bwd_weights_t);
+
+        virtual status_t init() override {
+            assert(this->engine()->kind() == engine_kind::cpu);
+
+            const auto act = this->src_pd_.desc()->format;
+            bool ok = true
+                && this->set_default_params() == status::success
+                && this->desc()->prop_kind == prop_kind::backward_weights
+                && this->desc()->alg_kind == alg_kind::convolution_direct
+                && !this->has_zero_dim_memory()
+                && dw_convolution::is_depthwise(this)
+                && utils::everyone_is(data_type::f32,
+                        this->desc()->src_desc.data_type,
+                        this->desc()->diff_weights_desc.data_type,
+                        this->desc()->diff_dst_desc.data_type)
+                && utils::implication(this->with_bias(), data_type::f32
+                        == this->desc()->diff_bias_desc.data_type)
+                && dw_convolution::act_format_ok(act)
+                && this->diff_dst_pd_.desc()->format == act
+                && dw_convolution::wei_format_ok(act,
+                        this->diff_weights_pd_.desc()->format);
+            return ok ? status::success : status::unimplemented;
+        }
+
+    protected:
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->src_pd_.desc()->format == any)
+                CHECK(this->src_pd_.set_format(nChw8c));
+            if (this->diff_dst_pd_.desc()->format == any)
+                CHECK(this->diff_dst_pd_.set_format(
+                            this->src_pd_.desc()->format));
+            if (this->diff_weights_pd_.desc()->format == any)
+                CHECK(this->diff_weights_pd_.set_format(
+                            dw_convolution::default_wei_format(
+                                this->src_pd_.desc()->format)));
+            if (this->diff_bias_pd_.desc()->format == any)
+                CHECK(this->diff_bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    dw_convolution_bwd_weights_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , src_s_(conf_.src_pd()), diff_wei_s_(conf_.diff_weights_pd(0))
+        , diff_dst_s_(conf_.diff_dst_pd())
+        , taps_h_(conf_.OH(), conf_.IH(), conf_.KH(), conf_.KSH(),
+                conf_.padT(), 1 + conf_.KDH())
+        , taps_w_(conf_.OW(), conf_.IW(), conf_.KW(), conf_.KSW(),
+                conf_.padL(), 1 + conf_.KDW())
+    {
+        dw_convolution::init_conf(c_, &conf_, conf_.src_pd()->desc()->format,
+                conf_.diff_weights_pd(0)->desc()->format);
+    }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) {
+        execute_backward_weights();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward_weights();
+    pd_t conf_;
+    dw_convolution::conf_t c_;
+    const dw_convolution::strides_t src_s_, diff_wei_s_, diff_dst_s_;
+    const window_taps_t taps_h_, taps_w_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
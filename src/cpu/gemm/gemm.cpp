@@ -13,7 +13,7 @@
 * See the License for the specific language governing permissions and
 * limitations under the License.
 *******************************************************************************/
-#if !defined(USE_CBLAS)
+#if !defined(USE_CBLAS) && !defined(TARGET_VANILLA)
 #include <mutex>
 #endif
 
@@ -72,7 +72,18 @@ mkldnn_status_t check_gemm_input(const char *transa, const char *transb,
     return success;
 }
 
-#if !defined(USE_CBLAS)
+/** C = beta * C, the whole product when K == 0 */
+static void gemm_scale_c(int M, int N, float beta, float *C, int ldc) {
+    if (beta == 1.f) return;
+    for (int j = 0; j < N; ++j) {
+        float *c = C + (size_t)j * ldc;
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < M; ++i)
+            c[i] = beta == 0.f ? 0.f : beta * c[i];
+    }
+}
+
+#if !defined(USE_CBLAS) && !defined(TARGET_VANILLA)
 struct gemm_impl_t {
     gemm_impl_t(char transa, char transb, bool zero_beta, bool with_bias) {
         //jit kernel has three codepaths: beta is 0, 1 or arbitrary
@@ -107,7 +118,7 @@ struct gemm_impl_t {
                 break;
             default:
                 ref_gemm(transa, transb, M, N, K, alpha, A, lda, B, ldb, beta,
-                        C, ldc, bias);
+                        C, ldc, gemm_epilogue_t(bias));
                 break;
         }
         return mkldnn_success;
@@ -147,25 +158,52 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
             lda, ldb, ldc, alpha, beta, bias != nullptr);
     if (status != mkldnn_success)
         return status;
-    if (*M == 0 || *N == 0 || *K == 0)
+    return extended_sgemm(transa, transb, M, N, K, alpha, A, lda, B, ldb,
+            beta, C, ldc, gemm_epilogue_t(bias));
+}
+
+mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc,
+        const gemm_epilogue_t &ep) {
+    //Check input
+    mkldnn_status_t status = check_gemm_input(transa, transb, M, N, K,
+            lda, ldb, ldc, alpha, beta, false);
+    if (status != mkldnn_success)
+        return status;
+    if (*M == 0 || *N == 0)
+        return mkldnn_success;
+    if (*K == 0) {
+        gemm_scale_c(*M, *N, *beta, C, *ldc);
+        ep.apply(*M, *N, C, *ldc);
         return mkldnn_success;
+    }
+#if defined(USE_CBLAS)
     int trA = *transa == 't' || *transa == 'T';
     int trB = *transb == 't' || *transb == 'T';
-#ifdef USE_CBLAS
     //Call cblas
     CBLAS_TRANSPOSE Cblas_trA = trA ? CblasTrans : CblasNoTrans;
     CBLAS_TRANSPOSE Cblas_trB = trB ? CblasTrans : CblasNoTrans;
     cblas_sgemm(CblasColMajor, Cblas_trA, Cblas_trB,
             *M, *N, *K, *alpha, A, *lda, B, *ldb, *beta, C, *ldc);
-    //Add bias if necessary (bias is applied to columns of C)
-    if (bias) {
-        cblas_int incx = 1, incy = 1;
-#       pragma omp parallel for schedule(static)
-        for (int i = 0; i < *N; i++)
-            cblas_saxpy(*M, 1.0, bias, incx, C + i*(*ldc), incy);
+    //Apply the epilogue in a single pass over C (bias is applied to the
+    //columns of C)
+    if (!ep.is_identity()) {
+        const int N_ = *N;
+#       pragma omp parallel for schedule(static) if (!omp_in_parallel())
+        for (int j = 0; j < N_; j++)
+            ep.shifted(0, j).apply(*M, 1, C + (size_t)j * (*ldc), *ldc);
     }
     return mkldnn_success;
+#elif defined(TARGET_VANILLA)
+    //The reference gemm applies the epilogue as it stores C
+    ref_gemm(transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc,
+            ep);
+    return mkldnn_success;
 #else
+    int trA = *transa == 't' || *transa == 'T';
+    int trB = *transb == 't' || *transb == 'T';
     //Generate jit kernel and call sgemm with bias
     volatile static int initialized = 0;
     if (!initialized) {
@@ -176,18 +214,50 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
             initialized = 1;
         }
     }
-    if (bias)
+    //The jit kernels only know the row bias, with beta == 0
+    const bool jit_bias = ep.bias_m && !ep.bias_n && !ep.with_relu
+        && *beta == 0.f;
+    if (jit_bias)
         gemm_bias_impl[trA][trB]->call(
                 transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc,
-                bias);
-    else
+                ep.bias_m);
+    else {
         gemm_impl[*beta == 0.f][trA][trB]->call(
                 transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+        if (!ep.is_identity()) {
+            const int N_ = *N;
+            parallel_nd(N_, [&](int j) {
+                ep.shifted(0, j).apply(*M, 1, C + (size_t)j * (*ldc), *ldc);
+            });
+        }
+    }
 
     return mkldnn_success;
 #endif
 }
 
+mkldnn_status_t gemm_bf16bf16f32(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const bfloat16_t *A, const int *lda, const bfloat16_t *B,
+        const int *ldb, const float *beta, float *C, const int *ldc,
+        const gemm_epilogue_t &ep) {
+    //Check input
+    mkldnn_status_t status = check_gemm_input(transa, transb, M, N, K,
+            lda, ldb, ldc, alpha, beta, false);
+    if (status != mkldnn_success)
+        return status;
+    if (*M == 0 || *N == 0)
+        return mkldnn_success;
+    if (*K == 0) {
+        gemm_scale_c(*M, *N, *beta, C, *ldc);
+        ep.apply(*M, *N, C, *ldc);
+        return mkldnn_success;
+    }
+    ref_gemm(transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc,
+            ep);
+    return mkldnn_success;
+}
+
 }
 }
 }
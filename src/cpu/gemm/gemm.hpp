@@ -15,18 +15,91 @@
 *******************************************************************************/
 #ifndef GEMM_HPP
 #define GEMM_HPP
+
+#include <stddef.h>
+
+#include "bfloat16.hpp"
+#include "mkldnn_thread.hpp"
+
 namespace mkldnn {
 namespace impl {
 namespace cpu {
+/** Element-wise post-processing of C done by the gemm as the results are
+ * stored: C(i, j) = relu(C(i, j) + bias_m[i] + bias_n[j]). bias_m is the
+ * classic gemm bias (one value per row of the column-major C), bias_n holds
+ * one value per column; either may be null. */
+struct gemm_epilogue_t {
+    gemm_epilogue_t(const float *bias_m = nullptr,
+            const float *bias_n = nullptr, bool with_relu = false,
+            float relu_nslope = 0.f)
+        : bias_m(bias_m), bias_n(bias_n), with_relu(with_relu)
+        , relu_nslope(relu_nslope) {}
+
+    bool is_identity() const { return !bias_m && !bias_n && !with_relu; }
+
+    /** the epilogue of the sub-matrix of C starting at (i, j) */
+    gemm_epilogue_t shifted(int i, int j) const {
+        return gemm_epilogue_t(bias_m ? bias_m + i : nullptr,
+                bias_n ? bias_n + j : nullptr, with_relu, relu_nslope);
+    }
+
+    float operator()(float c, int i, int j) const {
+        if (bias_m) c += bias_m[i];
+        if (bias_n) c += bias_n[j];
+        if (with_relu && c < 0.f) c *= relu_nslope;
+        return c;
+    }
+
+    /** applies the epilogue to the m x n column-major matrix C */
+    void apply(int m, int n, float *C, int ldc) const {
+        for (int j = 0; j < n; ++j) {
+            float *c = C + (size_t)j * ldc;
+            const float b = bias_n ? bias_n[j] : 0.f;
+            if (bias_m) {
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < m; ++i) c[i] += bias_m[i] + b;
+            } else if (bias_n) {
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < m; ++i) c[i] += b;
+            }
+            if (with_relu) {
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < m; ++i)
+                    if (c[i] < 0.f) c[i] *= relu_nslope;
+            }
+        }
+    }
+
+    const float *bias_m;
+    const float *bias_n;
+    bool with_relu;
+    float relu_nslope;
+};
+
 mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
         const int *M, const int *N, const int *K, const float *alpha,
         const float *A, const int *lda, const float *B, const int *ldb,
         const float *beta, float *C, const int *ldc,
         const float *bias = nullptr);
+/** sgemm followed by the epilogue @p ep (any beta is allowed) */
+mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc,
+        const gemm_epilogue_t &ep);
+/** gemm with bf16 A and B, f32 C and f32 accumulation. There is no bf16
+ * BLAS to forward to, so every build runs the portable ref_gemm. */
+mkldnn_status_t gemm_bf16bf16f32(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const bfloat16_t *A, const int *lda, const bfloat16_t *B,
+        const int *ldb, const float *beta, float *C, const int *ldc,
+        const gemm_epilogue_t &ep = gemm_epilogue_t());
+/** A and B are float or bfloat16_t; C is always f32 */
+template <typename data_t>
 void ref_gemm(const char *transa, const char *transb, const int *M,
-        const int *N, const int *K, const float *alpha, const float *A,
-        const int *lda, const float *B, const int *ldb, const float *beta,
-        float *C, const int *ldc, const float *bias);
+        const int *N, const int *K, const float *alpha, const data_t *A,
+        const int *lda, const data_t *B, const int *ldb, const float *beta,
+        float *C, const int *ldc, const gemm_epilogue_t &ep);
 #ifdef USE_CBLAS
 #define GEMM_IMPL_STR "gemm:blas"
 #else
@@ -18,6 +18,7 @@
 
 #include "mkldnn_thread.hpp"
 #include "utils.hpp"
+#include "ws_pool.hpp"
 
 #include "gemm_utils.hpp"
 #include "jit_avx512_common_gemm_f32.hpp"
@@ -1877,15 +1878,15 @@ void jit_avx512_common_gemm_f32::sgemm(const char *transa, const char *transb,
         for (int i = 0; i < nthr; i++)
             ompstatus[i * CACHE_LINE_SIZE] = 0;
 
-        c_buffers = (float *)malloc(nthr_m * nthr_n * (nthr_k - 1) * MB * NB
-                * sizeof(float), PAGE_4K);
+        c_buffers = (float *)ws_pool().get(nthr_m * nthr_n * (nthr_k - 1)
+                * MB * NB * sizeof(float));
     }
 
     const size_t ws_elems_per_thr = k * 48 + 64;
     const size_t ws_size_per_thr
             = utils::rnd_up(ws_elems_per_thr * sizeof(float), PAGE_4K);
     if (k > STACK_K_CAPACITY) {
-        ws_buffers = (float *)malloc(nthr * ws_size_per_thr, PAGE_4K);
+        ws_buffers = (float *)ws_pool().get(nthr * ws_size_per_thr);
     }
 
 #pragma omp parallel for num_threads(nthr)
@@ -2005,8 +2006,8 @@ void jit_avx512_common_gemm_f32::sgemm(const char *transa, const char *transb,
     }
 
     if (nthr_k > 1)
-        free(c_buffers);
-    free(ws_buffers);
+        ws_pool().put(c_buffers);
+    ws_pool().put(ws_buffers);
 }
 
 jit_avx512_common_gemm_f32::jit_avx512_common_gemm_f32(
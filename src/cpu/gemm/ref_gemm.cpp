@@ -13,9 +13,11 @@
 * See the License for the specific language governing permissions and
 * limitations under the License.
 *******************************************************************************/
+#include "gemm.hpp"
 #include "gemm_utils.hpp"
 #include "utils.hpp"
 #include "nstl.hpp"
+#include "ws_pool.hpp"
 //#include "../jit_generator.hpp" // do not require any jit-specific stuff
 #include "mkldnn_thread.hpp"
 #include "../cpu_isa_traits.hpp"
@@ -27,8 +29,12 @@ using namespace mkldnn::impl::utils;
 
 constexpr int unroll_m = 16;
 constexpr int unroll_n = 6;
+/* A and B may be stored in a narrower type than C (bf16): they are widened
+ * to f32 as they are loaded and all the accumulation is done in f32. The
+ * packed copy of A is always f32. */
+template <typename data_t>
 static void copy_A(
-        bool isTransA, int K, const float *A, const int lda, float *ws) {
+        bool isTransA, int K, const data_t *A, const int lda, float *ws) {
     for (int k = 0; k < K; k++) {
         PRAGMA_OMP_SIMD()
         for (int i = 0; i < unroll_m; i++) {
@@ -38,10 +44,10 @@ static void copy_A(
     }
 }
 
-template <bool isTransA, bool isTransB>
-static void kernel_mxn(int K, const float *A, const int lda,
-        const float *B, const int ldb, float *C, const int ldc,
-        const float alpha, const float beta) {
+template <typename a_t, typename b_t, bool isTransA, bool isTransB>
+static void kernel_mxn(int K, const a_t *A, const int lda,
+        const b_t *B, const int ldb, float *C, const int ldc,
+        const float alpha, const float beta, const gemm_epilogue_t *ep) {
     float c[unroll_m * unroll_n] = { 0. };
     for (int k = 0; k < K; k++) {
         for (int j = 0; j < unroll_n; j++) {
@@ -56,32 +62,39 @@ static void kernel_mxn(int K, const float *A, const int lda,
     for (int j = 0; j < unroll_n; j++) {
         PRAGMA_OMP_SIMD()
         for (int i = 0; i < unroll_m; i++) {
-            C[i + j * ldc] = (beta == 0.0f)
+            float v = (beta == 0.0f)
             ? alpha * c[i + unroll_m * j]
             : alpha * c[i + unroll_m * j] + beta * C[i + j * ldc];
+            C[i + j * ldc] = ep ? (*ep)(v, i, j) : v;
         }
     }
 }
 
-template <bool isTransA, bool isTransB>
+template <typename data_t, bool isTransA, bool isTransB>
 static void block_ker(const int M, const int N, const int K,
-        const float *A, const int lda, const float *B, const int ldb, float *C,
+        const data_t *A, const int lda, const data_t *B, const int ldb, float *C,
         const int ldc, const float alpha, const float beta, float *ws,
-        bool do_copy) {
+        bool do_copy, const gemm_epilogue_t *ep) {
     int Nu = rnd_dn(N, unroll_n), Mu = rnd_dn(M, unroll_m);
     for (int i = 0; i < Mu; i += unroll_m) {
         for (int j = 0; j < Nu; j += unroll_n) {
-            const float *b = isTransB ? &B[j] : &B[j * ldb];
-            const float *a = isTransA ? &A[i * lda] : &A[i];
+            const data_t *b = isTransB ? &B[j] : &B[j * ldb];
+            const data_t *a = isTransA ? &A[i * lda] : &A[i];
+            gemm_epilogue_t tile_ep;
+            if (ep) tile_ep = ep->shifted(i, j);
             if (do_copy) {
                 if (j == 0) {
                     copy_A(isTransA, K, a, lda, ws);
                 }
-                kernel_mxn<false, isTransB>(
-                        K, ws, unroll_m, b, ldb, &C[i + j * ldc], ldc, alpha, beta);
+                kernel_mxn<float, data_t, false, isTransB>(K, ws, unroll_m,
+                        b, ldb,
+                        &C[i + j * ldc], ldc, alpha, beta,
+                        ep ? &tile_ep : nullptr);
             } else {
-                kernel_mxn<isTransA, isTransB>(
-                        K, a, lda, b, ldb, &C[i + j * ldc], ldc, alpha, beta);
+                kernel_mxn<data_t, data_t, isTransA, isTransB>(K, a, lda,
+                        b, ldb,
+                        &C[i + j * ldc], ldc, alpha, beta,
+                        ep ? &tile_ep : nullptr);
             }
         }
     }
@@ -94,7 +107,7 @@ static void block_ker(const int M, const int N, const int K,
                 float a = isTransA ? A[p + i * lda] : A[i + p * lda];
                 c += alpha * a * b;
             }
-            C[i + j * ldc] = c;
+            C[i + j * ldc] = ep ? (*ep)(c, i, j) : c;
         }
     }
     for (int i = Mu; i < M; i++) {
@@ -105,19 +118,20 @@ static void block_ker(const int M, const int N, const int K,
                 float a = isTransA ? A[p + i * lda] : A[i + p * lda];
                 c += alpha * a * b;
             }
-            C[i + j * ldc] = c;
+            C[i + j * ldc] = ep ? (*ep)(c, i, j) : c;
         }
     }
 }
 
-template <bool isTransA, bool isTransB>
+template <typename data_t, bool isTransA, bool isTransB>
 void gemm_ithr(const int M, const int N, const int K, const float alpha,
-        const float *A, const int lda, const float *B, const int ldb,
-        const float beta, float *C, const int ldc, bool do_copy, float *ws) {
+        const data_t *A, const int lda, const data_t *B, const int ldb,
+        const float beta, float *C, const int ldc, bool do_copy, float *ws,
+        const gemm_epilogue_t *ep) {
     int BM = 4032;
     int BN = isTransA ? 96 : 48;
     int BK = isTransB ? 96 : 256;
-    const float *curA, *curB;
+    const data_t *curA, *curB;
     float *curC;
 
     if ((M <= 0) || (N <= 0))
@@ -131,6 +145,7 @@ void gemm_ithr(const int M, const int N, const int K, const float alpha,
             for (int j = 0; j < N * M; j++)
                 C[j] *= beta;
         }
+        if (ep) ep->apply(M, N, C, ldc);
         return;
     }
 
@@ -143,22 +158,29 @@ void gemm_ithr(const int M, const int N, const int K, const float alpha,
                 curA = isTransA ? A + Bk + Bm * lda : A + Bm + Bk * lda;
                 curB = isTransB ? B + Bn + Bk * ldb : B + Bk + Bn * ldb;
                 curC = C + Bm + Bn * ldc;
+                /* the epilogue goes with the store of the last K block */
+                gemm_epilogue_t blk_ep;
+                const bool last_k = Bk + kb == K;
+                if (ep && last_k) blk_ep = ep->shifted(Bm, Bn);
+                const gemm_epilogue_t *cur_ep
+                    = ep && last_k ? &blk_ep : nullptr;
                 if (Bk == 0) {
-                    block_ker<isTransA, isTransB>(mb, nb, kb, curA, lda, curB,
-                            ldb, curC, ldc, alpha, beta, ws, do_copy);
+                    block_ker<data_t, isTransA, isTransB>(mb, nb, kb, curA, lda, curB,
+                            ldb, curC, ldc, alpha, beta, ws, do_copy, cur_ep);
                 } else {
-                    block_ker<isTransA, isTransB>(mb, nb, kb, curA, lda, curB,
-                            ldb, curC, ldc, alpha, 1.0f, ws, do_copy);
+                    block_ker<data_t, isTransA, isTransB>(mb, nb, kb, curA, lda, curB,
+                            ldb, curC, ldc, alpha, 1.0f, ws, do_copy, cur_ep);
                 }
             }
         }
     }
 }
 
+template <typename data_t>
 void ref_gemm(const char *transa_, const char *transb_, const int *M_,
-        const int *N_, const int *K_, const float *alpha_, const float *A,
-        const int *lda_, const float *B, const int *ldb_, const float *beta_,
-        float *C, const int *ldc_, const float *bias) {
+        const int *N_, const int *K_, const float *alpha_, const data_t *A,
+        const int *lda_, const data_t *B, const int *ldb_, const float *beta_,
+        float *C, const int *ldc_, const gemm_epilogue_t &ep) {
     bool isTransA = (*transa_ == 'T' || *transa_ == 't');
     bool isTransB = (*transb_ == 'T' || *transb_ == 't');
     const int M = *M_, N = *N_, K = *K_, lda = *lda_, ldb = *ldb_, ldc = *ldc_;
@@ -173,8 +195,8 @@ void ref_gemm(const char *transa_, const char *transb_, const int *M_,
 
     float *c_buffers = nullptr, *ws_buffers = nullptr;
     if (nthr_k > 1) {
-        c_buffers = (float *)malloc(nthr_m * nthr_n * (nthr_k - 1) * MB * NB
-                * sizeof(float), PAGE_4K);
+        c_buffers = (float *)ws_pool().get(nthr_m * nthr_n * (nthr_k - 1)
+                * MB * NB * sizeof(float));
         if (!c_buffers) {
             nthr_k = 1;
             KB = K;
@@ -187,7 +209,7 @@ void ref_gemm(const char *transa_, const char *transb_, const int *M_,
     const size_t ws_size_per_thr
             = utils::rnd_up(ws_elems_per_thr * sizeof(float), PAGE_4K);
     if (do_copy) {
-        ws_buffers = (float *)malloc(nthr * ws_size_per_thr, PAGE_4K);
+        ws_buffers = (float *)ws_pool().get(nthr * ws_size_per_thr);
         if (!ws_buffers)
             do_copy = false;
     }
@@ -231,28 +253,32 @@ void ref_gemm(const char *transa_, const char *transb_, const int *M_,
                 myBeta = 0.0f;
                 ld = MB;
             }
-            const float *myA = isTransA
+            const data_t *myA = isTransA
                     ? &(A[k_from + m_from * lda])
                     : &(A[m_from + k_from * lda]);
-            const float *myB = isTransB
+            const data_t *myB = isTransB
                     ? &(B[n_from + k_from * ldb])
                     : &(B[k_from + n_from * ldb]);
+            /* with a K split the epilogue waits for the reduction */
+            gemm_epilogue_t thr_ep = ep.shifted(m_from, n_from);
+            const gemm_epilogue_t *myEp
+                    = nthr_k == 1 && !ep.is_identity() ? &thr_ep : nullptr;
 
             if (!isTransA) {
                 if (!isTransB) {
-                    gemm_ithr<false, false>(myM, myN, myK, alpha, myA, lda, myB,
-                            ldb, myBeta, myC, ld, do_copy, ws);
+                    gemm_ithr<data_t, false, false>(myM, myN, myK, alpha, myA, lda,
+                            myB, ldb, myBeta, myC, ld, do_copy, ws, myEp);
                 } else {
-                    gemm_ithr<false, true>(myM, myN, myK, alpha, myA, lda, myB,
-                            ldb, myBeta, myC, ld, do_copy, ws);
+                    gemm_ithr<data_t, false, true>(myM, myN, myK, alpha, myA, lda,
+                            myB, ldb, myBeta, myC, ld, do_copy, ws, myEp);
                 }
             } else {
                 if (!isTransB) {
-                    gemm_ithr<true, false>(myM, myN, myK, alpha, myA, lda, myB,
-                            ldb, myBeta, myC, ld, do_copy, ws);
+                    gemm_ithr<data_t, true, false>(myM, myN, myK, alpha, myA, lda,
+                            myB, ldb, myBeta, myC, ld, do_copy, ws, myEp);
                 } else {
-                    gemm_ithr<true, true>(myM, myN, myK, alpha, myA, lda, myB,
-                            ldb, myBeta, myC, ld, do_copy, ws);
+                    gemm_ithr<data_t, true, true>(myM, myN, myK, alpha, myA, lda,
+                            myB, ldb, myBeta, myC, ld, do_copy, ws, myEp);
                 }
             }
         }
@@ -268,16 +294,24 @@ void ref_gemm(const char *transa_, const char *transb_, const int *M_,
                 gemm_utils::sum_two_matrices(myM, block, myC, MB,
                         &C[m_from + (n_from + offset) * ldc], ldc);
             }
+            if (myM > 0 && !ep.is_identity())
+                ep.shifted(m_from, n_from + offset).apply(myM, block,
+                        &C[m_from + (n_from + offset) * ldc], ldc);
         }
     }
-    if (bias) {
-        parallel_nd(N, M, [&](int i, int j) {
-            C[i*ldc + j] += bias[j];
-        });
-    }
-    free(ws_buffers);
-    free(c_buffers);
+    ws_pool().put(ws_buffers);
+    ws_pool().put(c_buffers);
 }
+
+template void ref_gemm<float>(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc, const gemm_epilogue_t &ep);
+template void ref_gemm<bfloat16_t>(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const bfloat16_t *A, const int *lda, const bfloat16_t *B,
+        const int *ldb, const float *beta, float *C, const int *ldc,
+        const gemm_epilogue_t &ep);
 }
 }
 }
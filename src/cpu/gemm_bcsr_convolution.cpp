@@ -0,0 +1,113 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "gemm_bcsr_convolution.hpp"
+#include "utils.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::utils;
+
+void gemm_bcsr_convolution_fwd_t::execute_forward() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = this->input_memory(1);
+    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<data_t *>(this->memory());
+
+    jit_gemm_conv_conf_t &jcp = this->conf_.jcp_;
+    const bcsr_layout_t l(conf_.weights_pd()->desc()->layout_desc.bcsr_desc);
+
+    const int M = jcp.os * jcp.od;
+    const size_t src_step = (size_t)jcp.ic * jcp.ih * jcp.iw * jcp.id;
+    const size_t dst_step = (size_t)jcp.oc * M;
+    const int m = jcp.os;
+    const ptrdiff_t LDB = jcp.im2col_sz ? m : M;
+
+    const auto &post_ops = conf_.attr()->post_ops_;
+    const bool do_relu = post_ops.len_ == 1;
+    const float nslope = do_relu ? post_ops.entry_[0].eltwise.alpha : 0.f;
+    const data_t *_bias = jcp.with_bias ? bias : nullptr;
+
+    data_t *col = jcp.im2col_sz ? (data_t *)this->scratchpad_->get()
+        : nullptr;
+
+    /* with outer threading every thread takes whole (image, od) items and
+     * runs the sparse product alone; otherwise the images go one at a time
+     * and the threads split the tiles of the product */
+    const size_t work_amount = (size_t)jcp.mb * jcp.od;
+    if (jcp.nthr > 1) {
+        OMP(parallel num_threads(jcp.nthr))//;
+        {
+            const int ithr = omp_get_thread_num();
+            const int nthr = omp_get_num_threads();
+
+            data_t *_col = col + (ptrdiff_t)ithr * jcp.im2col_sz;
+            for (ptrdiff_t i = 0; i < jcp.im2col_sz; ++i) _col[i] = 0.f;
+
+            int n{0}, od{0};
+            size_t start = 0, end = 0;
+            balance211(work_amount, nthr, ithr, start, end);
+            nd_iterator_init(start, n, jcp.mb, od, jcp.od);
+            for (size_t iwork = start; iwork < end; ++iwork) {
+                const data_t *_src = src + n * src_step;
+                if (jcp.im2col_sz) {
+                    if (jcp.id == 1)
+                        jit_gemm_convolution_utils::im2col(jcp, _src, _col);
+                    else
+                        jit_gemm_convolution_utils::im2col_3d(jcp, _src,
+                                _col, od);
+                }
+                bcsr_gemm(l, weights, jcp.im2col_sz ? _col : _src + od * m,
+                        LDB, m, dst + n * dst_step + od * m, M, 1, _bias,
+                        do_relu, nslope, 0, 1);
+                nd_iterator_step(n, jcp.mb, od, jcp.od);
+            }
+        }
+        return;
+    }
+
+    OMP(parallel for)//;
+    for (ptrdiff_t i = 0; i < jcp.im2col_sz; ++i) col[i] = 0.f;
+
+    for (int n = 0; n < jcp.mb; ++n)
+    for (int od = 0; od < jcp.od; ++od) {
+        const data_t *_src = src + n * src_step;
+        if (jcp.im2col_sz) {
+            if (jcp.id == 1)
+                jit_gemm_convolution_utils::im2col(jcp, _src, col);
+            else
+                jit_gemm_convolution_utils::im2col_3d(jcp, _src, col, od);
+        }
+        const data_t *B = jcp.im2col_sz ? col : _src + od * m;
+        data_t *C = dst + n * dst_step + od * m;
+        OMP(parallel)//;
+        bcsr_gemm(l, weights, B, LDB, m, C, M, 1, _bias, do_relu, nslope,
+                omp_get_thread_num(), omp_get_num_threads());
+    }
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,63 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "gemm_bcsr_inner_product.hpp"
+#include "mkldnn_thread.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+void gemm_bcsr_inner_product_fwd_t::execute_forward() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = this->input_memory(1);
+    auto bias = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<data_t *>(this->memory());
+
+    const int MB = conf_.MB();
+    const int OC = conf_.OC();
+    const int IC = conf_.IC_total();
+    const bcsr_layout_t l(conf_.weights_pd()->desc()->layout_desc.bcsr_desc);
+
+    const auto &post_ops = conf_.attr()->post_ops_;
+    const bool do_relu = post_ops.len_ == 1;
+    const float nslope = do_relu ? post_ops.entry_[0].eltwise.alpha : 0.f;
+    const data_t *_bias = conf_.with_bias() ? bias : nullptr;
+
+    /* B[ic][mb]: a single image is already a column */
+    const data_t *B = src;
+    if (MB > 1) {
+        data_t *srcT = (data_t *)scratchpad_->get();
+        OMP(parallel for)//;
+        for (int ic = 0; ic < IC; ++ic)
+            for (int mb = 0; mb < MB; ++mb)
+                srcT[(size_t)ic * MB + mb] = src[(size_t)mb * IC + ic];
+        B = srcT;
+    }
+
+    OMP(parallel)//;
+    bcsr_gemm(l, weights, B, MB, MB, dst, 1, OC, _bias, do_relu, nslope,
+            omp_get_thread_num(), omp_get_num_threads());
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
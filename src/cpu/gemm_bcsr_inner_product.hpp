@@ -0,0 +1,105 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_GEMM_BCSR_INNER_PRODUCT_HPP
+#define CPU_GEMM_BCSR_INNER_PRODUCT_HPP
+
+#include <assert.h>
+
+#include "bcsr_gemm.hpp"
+#include "c_types_map.hpp"
+#include "cpu_inner_product_pd.hpp"
+#include "cpu_engine.hpp"
+#include "scratchpad.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Forward inner product with block-CSR (pruned) weights, see
+ * gemm_bcsr_convolution_fwd_t. The minibatch is transposed to ic-major
+ * order first so that the sparse product reads contiguous rows. */
+struct gemm_bcsr_inner_product_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_inner_product_fwd_pd_t {
+        pd_t(engine_t *engine, const inner_product_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const inner_product_fwd_pd_t *hint_fwd_pd)
+            : cpu_inner_product_fwd_pd_t(engine, adesc, attr, hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("gemm:bcsr", gemm_bcsr_inner_product_fwd_t);
+
+        virtual status_t init() override {
+            using namespace utils;
+            using namespace memory_format;
+            assert(engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && this->set_default_params() == status::success
+                && one_of(desc()->prop_kind, prop_kind::forward_training,
+                        prop_kind::forward_inference)
+                && !has_zero_dim_memory()
+                && everyone_is(data_type::f32, desc()->src_desc.data_type,
+                        desc()->weights_desc.data_type,
+                        desc()->dst_desc.data_type)
+                && implication(this->with_bias(),
+                        desc()->bias_desc.data_type == data_type::f32)
+                && one_of(src_pd_.desc()->format, nc, nchw, ncdhw)
+                && dst_pd_.desc()->format == nc
+                && weights_pd_.desc()->format == bcsr_fmt
+                && bcsr_gemm_supported(
+                        weights_pd_.desc()->layout_desc.bcsr_desc)
+                && attr()->output_scales_.has_default_values()
+                && attr()->post_ops_.len_ <= 1
+                && utils::implication(attr()->post_ops_.len_ == 1,
+                        attr()->post_ops_.entry_[0].is_relu(true, false));
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    gemm_bcsr_inner_product_fwd_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , scratchpad_(nullptr)
+    {
+        if (conf_.MB() > 1)
+            scratchpad_ = create_scratchpad((size_t)conf_.MB()
+                    * conf_.IC_total() * sizeof(data_t));
+    }
+
+    ~gemm_bcsr_inner_product_fwd_t() { delete scratchpad_; }
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward();
+    pd_t conf_;
+    scratchpad_t *scratchpad_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,118 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_types.h"
+
+#include "c_types_map.hpp"
+#include "gemm_bf16_convolution.hpp"
+#include "utils.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::utils;
+
+template <data_type_t dst_type>
+void gemm_bf16_convolution_fwd_t<dst_type>::execute_forward() {
+    auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
+    auto bias = reinterpret_cast<const acc_data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<dst_data_t *>(this->memory());
+
+    jit_gemm_conv_conf_t &jcp = this->conf_.jcp_;
+
+    const int M = jcp.os * jcp.od;
+    const size_t src_step = (size_t)jcp.ic * jcp.ih * jcp.iw * jcp.id;
+    const size_t dst_step = (size_t)jcp.oc * M;
+    const size_t weights_g_size = (size_t)jcp.ic * jcp.oc * jcp.ks;
+
+    const int K = jcp.ic * jcp.ks;
+    const int N = jcp.oc;
+    const int m = jcp.os;
+    const int LDA = jcp.im2col_sz ? m : M;
+
+    const auto &post_ops = conf_.attr()->post_ops_;
+    const bool do_relu = post_ops.len_ == 1;
+    const float nslope = do_relu ? post_ops.entry_[0].eltwise.alpha : 0.f;
+
+    const float one = 1.f, zero = 0.f;
+
+    char *scratchpad = scratchpad_ ? scratchpad_->get() : nullptr;
+    src_data_t *col = (src_data_t *)scratchpad;
+    acc_data_t *acc = (acc_data_t *)(scratchpad
+            + (ptrdiff_t)jcp.im2col_sz * sizeof(src_data_t) * jcp.nthr);
+
+    const size_t work_amount = (size_t)jcp.ngroups * jcp.mb * jcp.od;
+    OMP(parallel num_threads(jcp.nthr))//;
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+
+        src_data_t *_col = col + (ptrdiff_t)ithr * jcp.im2col_sz;
+        acc_data_t *_acc = acc + (ptrdiff_t)ithr * m * N;
+
+        int g{0}, n{0}, od{0};
+        size_t start = 0, end = 0;
+
+        balance211(work_amount, nthr, ithr, start, end);
+        nd_iterator_init(start, g, jcp.ngroups, n, jcp.mb, od, jcp.od);
+
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const src_data_t *_src = src + (n * jcp.ngroups + g) * src_step;
+            const wei_data_t *_weights = weights + g * weights_g_size;
+            dst_data_t *_dst = dst + (n * jcp.ngroups + g) * dst_step;
+
+            if (jcp.im2col_sz)
+                jit_gemm_convolution_utils::im2col_bf16(jcp, _src, _col, od);
+
+            /* bias (one per oc, a column of C) and relu go with the store */
+            const gemm_epilogue_t ep(nullptr,
+                    jcp.with_bias ? bias + g * jcp.oc : nullptr,
+                    do_relu, nslope);
+            const src_data_t *A = jcp.im2col_sz ? _col : _src + od * m;
+            if (dst_type == data_type::f32) {
+                gemm_bf16bf16f32("N", "N", &m, &N, &K, &one, A, &LDA,
+                        _weights, &K, &zero,
+                        (acc_data_t *)_dst + od * m, &M, ep);
+            } else {
+                gemm_bf16bf16f32("N", "N", &m, &N, &K, &one, A, &LDA,
+                        _weights, &K, &zero, _acc, &m, ep);
+                for (int oc = 0; oc < N; ++oc) {
+                    const acc_data_t *a = _acc + (size_t)oc * m;
+                    dst_data_t *d = _dst + (size_t)oc * M + od * m;
+                    PRAGMA_OMP_SIMD()
+                    for (int os = 0; os < m; ++os)
+                        d[os] = a[os];
+                }
+            }
+            nd_iterator_step(g, jcp.ngroups, n, jcp.mb, od, jcp.od);
+        }
+    }
+}
+
+using namespace data_type;
+
+template struct gemm_bf16_convolution_fwd_t<f32>;
+template struct gemm_bf16_convolution_fwd_t<bf16>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_GEMM_BF16_CONVOLUTION_HPP
+#define CPU_GEMM_BF16_CONVOLUTION_HPP
+
+#include "c_types_map.hpp"
+#include "cpu_convolution_pd.hpp"
+#include "cpu_engine.hpp"
+#include "gemm_convolution_utils.hpp"
+#include "gemm/gemm.hpp"
+#include "scratchpad.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Forward convolution with bf16 src and weights by im2col + gemm.
+ *
+ * The column buffer is bf16, so im2col moves half the bytes of the f32
+ * version, and the gemm widens its operands to f32 as it loads them. dst is
+ * f32 (written by the gemm directly) or bf16 (the gemm writes an f32 tile
+ * that is rounded to bf16 when stored). Bias is f32. */
+template <impl::data_type_t dst_type>
+struct gemm_bf16_convolution_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_convolution_fwd_pd_t {
+        pd_t(engine_t *engine,
+                const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T("gemm:ref", gemm_bf16_convolution_fwd_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace data_type;
+            assert(this->engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && this->set_default_params() == status::success
+                && utils::one_of(this->cdesc_().prop_kind, forward_training,
+                        forward_inference)
+                && this->cdesc_().alg_kind == alg_kind::convolution_direct
+                && !this->has_zero_dim_memory()
+                && utils::everyone_is(bf16,
+                        this->cdesc_().src_desc.data_type,
+                        this->cdesc_().weights_desc.data_type)
+                && this->cdesc_().dst_desc.data_type == dst_type
+                && utils::implication(this->with_bias(),
+                        this->cdesc_().bias_desc.data_type == f32)
+                && this->src_pd_.desc()->format == src_format()
+                && this->dst_pd_.desc()->format == src_format()
+                && this->weights_pd_.desc()->format == wei_format()
+                && this->attr()->output_scales_.has_default_values()
+                && this->attr()->post_ops_.len_ <= 1
+                && utils::implication(this->attr()->post_ops_.len_ == 1,
+                        this->attr()->post_ops_.entry_[0].is_relu(true,
+                            false));
+            return ok ? status::success : status::unimplemented;
+        }
+
+        jit_gemm_conv_conf_t jcp_;
+
+    protected:
+        memory_format_t src_format() const {
+            using namespace memory_format;
+            return this->cdesc_().src_desc.ndims == 4 ? nchw : ncdhw;
+        }
+
+        memory_format_t wei_format() const {
+            using namespace memory_format;
+            return this->cdesc_().src_desc.ndims == 4
+                ? this->with_groups() ? goihw : oihw
+                : this->with_groups() ? goidhw : oidhw;
+        }
+
+        virtual status_t set_default_params() override {
+            using namespace memory_format;
+            if (this->src_pd_.desc()->format == any)
+                CHECK(this->src_pd_.set_format(src_format()));
+            if (this->dst_pd_.desc()->format == any)
+                CHECK(this->dst_pd_.set_format(src_format()));
+            if (this->weights_pd_.desc()->format == any)
+                CHECK(this->weights_pd_.set_format(wei_format()));
+            if (this->bias_pd_.desc()->format == any)
+                CHECK(this->bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    gemm_bf16_convolution_fwd_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , scratchpad_(nullptr)
+    {
+        jit_gemm_conv_conf_t &jcp = conf_.jcp_;
+        jit_gemm_convolution_utils::init_conf(jcp, *(conf_.cdesc()),
+                conf_.src_pd(), conf_.weights_pd(0), conf_.dst_pd(),
+                omp_get_max_threads());
+
+        /* the col buffers of all the threads, then one f32 output plane
+         * per thread when dst is not f32 */
+        size_t col_size = (size_t)jcp.im2col_sz * sizeof(src_data_t);
+        size_t acc_size = dst_type == data_type::f32
+            ? 0 : (size_t)jcp.os * jcp.oc * sizeof(acc_data_t);
+        jit_gemm_convolution_utils::prepare_scratchpad(jcp,
+                &scratchpad_, col_size + acc_size, jcp.nthr);
+    }
+
+    ~gemm_bf16_convolution_fwd_t() { delete scratchpad_; }
+
+    typedef typename prec_traits<data_type::bf16>::type src_data_t;
+    typedef typename prec_traits<data_type::bf16>::type wei_data_t;
+    typedef typename prec_traits<dst_type>::type dst_data_t;
+    typedef typename prec_traits<data_type::f32>::type acc_data_t;
+
+    virtual void execute(event_t *e) {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward();
+    pd_t conf_;
+    scratchpad_t *scratchpad_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,153 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+
+#include "gemm_bf16_inner_product.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_format;
+
+namespace {
+/** rounds the f32 results of the gemm into the bf16 output */
+template <typename out_t>
+void store_acc(ptrdiff_t nelems, const float *acc, out_t *out) {
+    OMP(parallel for schedule(static))//;
+    for (ptrdiff_t i = 0; i < nelems; ++i)
+        out[i] = acc[i];
+}
+}
+
+template <data_type_t dst_type>
+void gemm_bf16_inner_product_fwd_t<dst_type>::execute_forward() {
+    auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
+    auto bias = reinterpret_cast<const acc_data_t *>(this->input_memory(2));
+    auto dst = reinterpret_cast<dst_data_t *>(this->memory());
+
+    const int MB = conf_.MB();
+    const int OC = conf_.OC();
+    const int IC = conf_.IC_total_padded();
+
+    bool wei_tr = !utils::one_of(conf_.weights_pd()->desc()->format,
+             hwio, dhwio, io);
+
+    const auto &post_ops = conf_.attr()->post_ops_;
+    const bool do_relu = post_ops.len_ == 1;
+    const float nslope = do_relu ? post_ops.entry_[0].eltwise.alpha : 0.f;
+
+    acc_data_t *acc = scratchpad_
+        ? (acc_data_t *)scratchpad_->get() : (acc_data_t *)dst;
+
+    /* bias (one per oc, a row of C) and relu go with the store */
+    float alpha = 1.0, beta = 0.0;
+    gemm_bf16bf16f32(wei_tr ? "T" : "N", "N", &OC, &MB, &IC, &alpha, weights,
+            wei_tr ? &IC : &OC, src, &IC, &beta, acc, &OC,
+            gemm_epilogue_t(bias, nullptr, do_relu, nslope));
+    if (scratchpad_)
+        store_acc((ptrdiff_t)MB * OC, acc, dst);
+}
+
+template <data_type_t diff_src_type>
+void gemm_bf16_inner_product_bwd_data_t<diff_src_type>
+    ::execute_backward_data() {
+    auto diff_dst = reinterpret_cast<const diff_dst_data_t *>(
+            this->input_memory(0));
+    auto weights = reinterpret_cast<const wei_data_t *>(this->input_memory(1));
+    auto diff_src = reinterpret_cast<diff_src_data_t *>(this->memory());
+
+    const int MB = conf_.MB();
+    const int OC = conf_.OC();
+    const int IC = conf_.IC_total_padded();
+
+    bool wei_tr = utils::one_of(conf_.weights_pd()->desc()->format,
+             hwio, dhwio, io);
+
+    acc_data_t *acc = scratchpad_
+        ? (acc_data_t *)scratchpad_->get() : (acc_data_t *)diff_src;
+
+    float alpha = 1.0, beta = 0.0;
+    gemm_bf16bf16f32(wei_tr ? "T" : "N", "N", &IC, &MB, &OC, &alpha, weights,
+            wei_tr ? &OC : &IC, diff_dst, &OC, &beta, acc, &IC);
+    if (scratchpad_)
+        store_acc((ptrdiff_t)MB * IC, acc, diff_src);
+}
+
+template <data_type_t diff_wei_type>
+void gemm_bf16_inner_product_bwd_weights_t<diff_wei_type>
+    ::execute_backward_weights() {
+    auto src = reinterpret_cast<const src_data_t *>(this->input_memory(0));
+    auto diff_dst = reinterpret_cast<const diff_dst_data_t *>(
+            this->input_memory(1));
+    auto diff_weights = reinterpret_cast<diff_wei_data_t *>(this->memory(0));
+    auto diff_bias = reinterpret_cast<acc_data_t *>(this->memory(1));
+
+    const memory_desc_wrapper diff_dst_d(conf_.diff_dst_pd());
+    const memory_desc_wrapper diff_bias_d(conf_.diff_weights_pd(1));
+
+    diff_dst += diff_dst_d.blocking_desc().offset_padding;
+
+    const int MB = conf_.MB();
+    const int OC = conf_.OC();
+    const int IC = conf_.IC_total_padded();
+
+    bool wei_tr = utils::one_of(conf_.diff_weights_pd()->desc()->format,
+             hwio, dhwio, io);
+
+    acc_data_t *acc = scratchpad_
+        ? (acc_data_t *)scratchpad_->get() : (acc_data_t *)diff_weights;
+
+    float alpha = 1.0, beta = 0.0;
+    if (wei_tr)
+        gemm_bf16bf16f32("N", "T", &OC, &IC, &MB, &alpha, diff_dst, &OC,
+                src, &IC, &beta, acc, &OC);
+    else
+        gemm_bf16bf16f32("N", "T", &IC, &OC, &MB, &alpha, src, &IC,
+                diff_dst, &OC, &beta, acc, &IC);
+    if (scratchpad_)
+        store_acc((ptrdiff_t)OC * IC, acc, diff_weights);
+
+    if (diff_bias) {
+        diff_bias += diff_bias_d.blocking_desc().offset_padding;
+        OMP(parallel for schedule(static))//;
+        for (int oc = 0; oc < OC; ++oc) {
+            acc_data_t db = 0;
+            for (int mb = 0; mb < MB; ++mb)
+                db += diff_dst[mb * OC + oc];
+            diff_bias[oc] = db;
+        }
+    }
+}
+
+using namespace data_type;
+
+template struct gemm_bf16_inner_product_fwd_t<f32>;
+template struct gemm_bf16_inner_product_fwd_t<bf16>;
+template struct gemm_bf16_inner_product_bwd_data_t<f32>;
+template struct gemm_bf16_inner_product_bwd_data_t<bf16>;
+template struct gemm_bf16_inner_product_bwd_weights_t<f32>;
+template struct gemm_bf16_inner_product_bwd_weights_t<bf16>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
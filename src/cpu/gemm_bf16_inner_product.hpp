@@ -0,0 +1,223 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_GEMM_BF16_INNER_PRODUCT_HPP
+#define CPU_GEMM_BF16_INNER_PRODUCT_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_inner_product_pd.hpp"
+#include "cpu_engine.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+#include "scratchpad.hpp"
+#include "gemm/gemm.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Inner product with bf16 inputs and f32 accumulation. The template
+ * parameter is the type of the output of the pass (dst, diff_src or
+ * diff_weights): f32 outputs are written by the gemm, bf16 outputs go
+ * through an f32 scratchpad. Biases are f32. */
+
+template <impl::data_type_t dst_type>
+struct gemm_bf16_inner_product_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_inner_product_fwd_pd_t {
+        pd_t(engine_t *engine, const inner_product_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const inner_product_fwd_pd_t *hint_fwd_pd)
+            : cpu_inner_product_fwd_pd_t(engine, adesc, attr, hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("gemm:ref", gemm_bf16_inner_product_fwd_t);
+
+        virtual status_t init() override {
+            using namespace utils;
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && this->set_default_params() == status::success
+                && one_of(desc()->prop_kind, prop_kind::forward_training,
+                        prop_kind::forward_inference)
+                && !has_zero_dim_memory()
+                && everyone_is(bf16, desc()->src_desc.data_type,
+                        desc()->weights_desc.data_type)
+                && desc()->dst_desc.data_type == dst_type
+                && implication(this->with_bias(),
+                        desc()->bias_desc.data_type == f32)
+                && attr()->output_scales_.has_default_values()
+                && attr()->post_ops_.len_ <= 1
+                && utils::implication(attr()->post_ops_.len_ == 1,
+                        attr()->post_ops_.entry_[0].is_relu(true, false))
+                && dense_gemm_consitency_check(src_pd(), weights_pd(),
+                        dst_pd());
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    gemm_bf16_inner_product_fwd_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , scratchpad_(nullptr)
+    {
+        if (dst_type != data_type::f32)
+            scratchpad_ = create_scratchpad(
+                    (size_t)conf_.MB() * conf_.OC() * sizeof(acc_data_t));
+    }
+    ~gemm_bf16_inner_product_fwd_t() { delete scratchpad_; }
+
+    typedef typename prec_traits<data_type::bf16>::type src_data_t;
+    typedef typename prec_traits<data_type::bf16>::type wei_data_t;
+    typedef typename prec_traits<dst_type>::type dst_data_t;
+    typedef typename prec_traits<data_type::f32>::type acc_data_t;
+
+    virtual void execute(event_t *e) {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward();
+    pd_t conf_;
+    scratchpad_t *scratchpad_;
+};
+
+template <impl::data_type_t diff_src_type>
+struct gemm_bf16_inner_product_bwd_data_t: public cpu_primitive_t {
+    struct pd_t: public cpu_inner_product_bwd_data_pd_t {
+        pd_t(engine_t *engine, const inner_product_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const inner_product_fwd_pd_t *hint_fwd_pd)
+            : cpu_inner_product_bwd_data_pd_t(engine, adesc, attr,
+                    hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("gemm:ref", gemm_bf16_inner_product_bwd_data_t);
+
+        virtual status_t init() override {
+            using namespace utils;
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && this->set_default_params() == status::success
+                && desc()->prop_kind == prop_kind::backward_data
+                && !has_zero_dim_memory()
+                && everyone_is(bf16, desc()->weights_desc.data_type,
+                        desc()->diff_dst_desc.data_type)
+                && desc()->diff_src_desc.data_type == diff_src_type
+                && attr()->has_default_values()
+                && dense_gemm_consitency_check(diff_src_pd(), weights_pd(),
+                        diff_dst_pd());
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    gemm_bf16_inner_product_bwd_data_t(const pd_t *pd,
+            const input_vector &inputs, const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , scratchpad_(nullptr)
+    {
+        if (diff_src_type != data_type::f32)
+            scratchpad_ = create_scratchpad((size_t)conf_.MB()
+                    * conf_.IC_total_padded() * sizeof(acc_data_t));
+    }
+    ~gemm_bf16_inner_product_bwd_data_t() { delete scratchpad_; }
+
+    typedef typename prec_traits<diff_src_type>::type diff_src_data_t;
+    typedef typename prec_traits<data_type::bf16>::type wei_data_t;
+    typedef typename prec_traits<data_type::bf16>::type diff_dst_data_t;
+    typedef typename prec_traits<data_type::f32>::type acc_data_t;
+
+    virtual void execute(event_t *e) {
+        execute_backward_data();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward_data();
+    pd_t conf_;
+    scratchpad_t *scratchpad_;
+};
+
+template <impl::data_type_t diff_wei_type>
+struct gemm_bf16_inner_product_bwd_weights_t: public cpu_primitive_t {
+    struct pd_t: public cpu_inner_product_bwd_weights_pd_t {
+        pd_t(engine_t *engine, const inner_product_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const inner_product_fwd_pd_t *hint_fwd_pd)
+            : cpu_inner_product_bwd_weights_pd_t(engine, adesc, attr,
+                    hint_fwd_pd) {}
+
+        DECLARE_COMMON_PD_T("gemm:ref", gemm_bf16_inner_product_bwd_weights_t);
+
+        virtual status_t init() override {
+            using namespace utils;
+            using namespace data_type;
+            assert(engine()->kind() == engine_kind::cpu);
+
+            bool ok = true
+                && this->set_default_params() == status::success
+                && desc()->prop_kind == prop_kind::backward_weights
+                && !has_zero_dim_memory()
+                && everyone_is(bf16, desc()->src_desc.data_type,
+                        desc()->diff_dst_desc.data_type)
+                && desc()->diff_weights_desc.data_type == diff_wei_type
+                && implication(this->with_bias(),
+                        desc()->diff_bias_desc.data_type == f32)
+                && attr()->has_default_values()
+                && dense_gemm_consitency_check(src_pd(), diff_weights_pd(),
+                        diff_dst_pd());
+            return ok ? status::success : status::unimplemented;
+        }
+    };
+
+    gemm_bf16_inner_product_bwd_weights_t(const pd_t *pd,
+            const input_vector &inputs, const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+        , scratchpad_(nullptr)
+    {
+        if (diff_wei_type != data_type::f32)
+            scratchpad_ = create_scratchpad((size_t)conf_.OC()
+                    * conf_.IC_total_padded() * sizeof(acc_data_t));
+    }
+    ~gemm_bf16_inner_product_bwd_weights_t() { delete scratchpad_; }
+
+    typedef typename prec_traits<data_type::bf16>::type src_data_t;
+    typedef typename prec_traits<diff_wei_type>::type diff_wei_data_t;
+    typedef typename prec_traits<data_type::bf16>::type diff_dst_data_t;
+    typedef typename prec_traits<data_type::f32>::type acc_data_t;
+
+    virtual void execute(event_t *e) {
+        execute_backward_weights();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_backward_weights();
+    pd_t conf_;
+    scratchpad_t *scratchpad_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -111,22 +111,13 @@ void _gemm_convolution_fwd_t<with_relu>::execute_forward() {
                     jit_gemm_convolution_utils::im2col_3d(jcp, _src, _col, od);
             }
 
+            /* bias (one per oc, a column of C) and relu go with the store */
+            const gemm_epilogue_t ep(nullptr,
+                    jcp.with_bias ? bias + g * jcp.oc : nullptr,
+                    do_relu, nslope);
             extended_sgemm("N", "N", &m, &N, &K, &one,
                     jcp.im2col_sz ? _col : _src + od * m, &LDA, _weights, &K,
-                    &this->beta_, _dst + od * m, &M);
-
-            if (jcp.with_bias || do_relu) {
-                data_t *d = _dst + od * m, b = 0.0;
-                for (int oc = 0; oc < jcp.oc; ++oc) {
-                    if(jcp.with_bias) b = bias[g * jcp.oc + oc];
-                    for (int oS = 0; oS < m; ++oS) {
-                        if (jcp.with_bias) d[oS] += b;
-                        if (do_relu && d[oS] < 0)
-                            d[oS] *= nslope;
-                    }
-                    d += M;
-                }
-            }
+                    &this->beta_, _dst + od * m, &M, ep);
             nd_iterator_step(g, jcp.ngroups, n, jcp.mb, od, jcp.od);
         }
     }
@@ -139,6 +130,8 @@ template struct _gemm_convolution_fwd_t<false>;
 void gemm_convolution_bwd_data_t::execute_backward_data() {
     auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto bias = conf_.with_bias()
+        ? reinterpret_cast<const data_t *>(this->input_memory(2)) : nullptr;
     auto diff_src = reinterpret_cast<data_t*>(this->memory());
 
     jit_gemm_conv_conf_t &jcp = this->conf_.jcp_;
@@ -170,10 +163,18 @@ void gemm_convolution_bwd_data_t::execute_backward_data() {
         for (ptrdiff_t i = 0; i < jcp.im2col_sz; ++i) _col[i] = (data_t)0;
 
         if (jcp.id > 1) {
-            ptrdiff_t diff_src_sz = (ptrdiff_t)(work_amount * src_step);
+            /* col2im_3d accumulates: start from the bias (or zero) */
+            const ptrdiff_t nchan = (ptrdiff_t)work_amount * jcp.ic;
+            const ptrdiff_t sp = src_step / jcp.ic;
             #pragma omp for
-            for (ptrdiff_t i = 0; i < diff_src_sz; ++i)
-                diff_src[i] = 0.;
+            for (ptrdiff_t c = 0; c < nchan; ++c) {
+                const data_t b = bias
+                    ? bias[c % (jcp.ngroups * jcp.ic)] : (data_t)0;
+                data_t *ds = diff_src + c * sp;
+                PRAGMA_OMP_SIMD()
+                for (ptrdiff_t i = 0; i < sp; ++i)
+                    ds[i] = b;
+            }
         }
 
         int g{0}, n{0};
@@ -184,18 +185,24 @@ void gemm_convolution_bwd_data_t::execute_backward_data() {
 
             data_t *_diff_src = diff_src + (n * jcp.ngroups + g)*src_step;
             const data_t *_weights = weights + g * weights_g_size;
+            const data_t *_bias = bias ? bias + g * jcp.ic : nullptr;
             for (int od = 0; od < jcp.od; ++od) {
                 const data_t *_diff_dst = diff_dst + (n * jcp.ngroups + g)
                     *dst_step + od * m;
 
+                /* without im2col C is diff_src and the bias (a column of
+                 * C per ic) goes with the store; otherwise col2im starts
+                 * from it */
+                const gemm_epilogue_t ep(nullptr,
+                        bias && !jcp.im2col_sz ? _bias : nullptr);
                 extended_sgemm("N", "T", &m, &N, &K, &one, _diff_dst, &M,
                     _weights, &N, &zero,
-                    jcp.im2col_sz ? _col:_diff_src + od * m, &LDC);
+                    jcp.im2col_sz ? _col:_diff_src + od * m, &LDC, ep);
 
                 if (jcp.im2col_sz) {
                     if (jcp.id == 1)
                         jit_gemm_convolution_utils::col2im(jcp, _col,
-                            _diff_src);
+                            _diff_src, _bias);
                     else
                         jit_gemm_convolution_utils::col2im_3d(jcp, _col,
                             _diff_src, od);
@@ -206,133 +213,9 @@ void gemm_convolution_bwd_data_t::execute_backward_data() {
     }
 }
 #endif
-#if 0 // ncc has issues here. The FIRST omp loop goes in a separate FILE (WORKAROUND XXX !!!)
-void gemm_convolution_bwd_weights_t::execute_backward_weights() {
-    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
-    auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
-    auto diff_weights = reinterpret_cast<data_t*>(this->memory(0));
-    auto diff_bias = reinterpret_cast<data_t *>(this->memory(1));
-
-    jit_gemm_conv_conf_t &jcp = this->conf_.jcp_;
-    const int K = jcp.os * jcp.od;
-    const size_t src_step = jcp.ic * jcp.ih * jcp.iw * jcp.id;
-    const size_t dst_step = jcp.oc * K;
-    const size_t weights_g_size = jcp.ic * jcp.oc * jcp.ks;
-
-    const int k = jcp.os;
-    const int N = jcp.oc;
-    const int M = jcp.ic * jcp.ks;
-    const int LDA = jcp.im2col_sz ? k : K;
-    const data_t zero = 0.0, one = 1.0;
-
-    data_t *col = nullptr, *wei_reduction = nullptr;
-    ptrdiff_t wei_offset = 0;
-    if (jcp.im2col_sz) {
-        col = (data_t *)this->scratchpad_->get();
-        wei_offset = jcp.im2col_sz * jcp.nthr;
-    }
-    if (jcp.need_wei_reduction)
-        wei_reduction = (data_t *)this->scratchpad_->get() + wei_offset;
-
-    OMP(parallel num_threads(jcp.nthr))
-    {
-        const int ithr = omp_get_thread_num();
-        const int nthr = omp_get_num_threads();
-
-        int ithr_g, nthr_g, ithr_mb, nthr_mb;
-        size_t g_start{0}, g_end{0}, mb_start{0}, mb_end{0};
-
-        jit_gemm_convolution_utils::bwd_weights_balance(ithr, nthr,
-                jcp.ngroups, jcp.mb, ithr_g, nthr_g, ithr_mb, nthr_mb);
-
-        const int need_reduction = nthr_mb != 1;
-
-        if (ithr_g != -1 && ithr_mb != -1) {
-            balance211((size_t)jcp.ngroups, nthr_g, ithr_g, g_start, g_end);
-            balance211((size_t)jcp.mb, nthr_mb, ithr_mb, mb_start, mb_end);
-
-            assert(implication((g_end - g_start) > 1, need_reduction == 0));
-
-            data_t *_col = col + (ptrdiff_t)ithr * jcp.im2col_sz;
-            data_t *weights_reduce_base = wei_reduction
-                    + ithr_g * nthr_mb * weights_g_size;
-            data_t *weights_reduce = weights_reduce_base
-                    + ithr_mb * weights_g_size;
-
-            # pragma omp parallel for if(jcp.nthr == 1)
-            for (ptrdiff_t i = 0; i < jcp.im2col_sz; ++i) _col[i] = (data_t)0;
-
-            for (size_t g = g_start; g < g_end; ++g) {
-                data_t *_diff_weights = need_reduction
-                        ? weights_reduce : (diff_weights + g * weights_g_size);
-                for (size_t mb = mb_start; mb < mb_end; ++mb) {
-                    const data_t *_src = src + (mb*jcp.ngroups+g)*src_step;
-                    for (int od = 0; od < jcp.od; ++od) {
-                    const data_t *_diff_dst = diff_dst
-                            + (mb*jcp.ngroups+g)*dst_step + od * k;
-
-                    if (jcp.im2col_sz) {
-                        if (jcp.id == 1)
-                            jit_gemm_convolution_utils::im2col(jcp, _src, _col);
-                        else
-                            jit_gemm_convolution_utils::im2col_3d(jcp, _src,
-                                _col, od);
-                    }
-
-                    extended_sgemm(
-                        "T", "N", &M, &N, &k, &one,
-                        jcp.im2col_sz ? _col : _src + od * k,
-                        &LDA, _diff_dst, &K,
-                        mb == mb_start && od == 0 ? &zero : &one,
-                        _diff_weights, &M);
-                    }
-                }
-            }
-            if (need_reduction) {
-                OMP(barrier)//;
-                data_t *weights_base = diff_weights + g_start * weights_g_size;
-                jit_gemm_convolution_utils::bwd_weights_reduction_par(
-                    ithr_mb, nthr_mb, jcp, weights_reduce_base, weights_base);
-            }
-        } else
-            if (need_reduction) {
-                OMP(barrier)//;
-            }
-    }
-    if (jcp.with_bias) {
-        const size_t work_amount = jcp.ngroups * jcp.oc;
-        OMP(parallel)//;
-        {
-            const int ithr = omp_get_thread_num();
-            const int nthr = omp_get_num_threads();
-            int g{0}, oc{0};
-            size_t start = 0, end = 0;
-            balance211(work_amount, nthr, ithr, start, end);
-            nd_iterator_init(start, g, jcp.ngroups, oc, jcp.oc);
-            for (size_t iwork = start; iwork < end; ++iwork) {
-                data_t db = 0;
-                size_t offset_ = (size_t)g*dst_step + (size_t)oc * K;
-                for (int mb = 0; mb < jcp.mb; ++mb)
-                {
-                    size_t offset = offset_ + (size_t)mb*jcp.ngroups*dst_step;
-                    for (int od = 0; od < jcp.od; ++od)
-                    for (int oh = 0; oh < jcp.oh; ++oh)
-                    //OMPSIMD(reduction(+:db))//;
-                    PRAGMA_OMP_SIMD(reduction(+:db))
-                    for (int ow = 0; ow < jcp.ow; ++ow)
-                    {
-                        db += diff_dst[offset];
-                        offset ++;
-                    }
-                }
-                //diff_bias[diff_bias_d.off(g*jcp.oc+oc)] = db;
-                diff_bias[g*jcp.oc+oc] = db;
-                nd_iterator_step(g, jcp.ngroups, oc, jcp.oc);
-            }
-        }
-    }
-}
-#endif
+/* gemm_convolution_bwd_weights_t::execute_backward_weights() is in
+ * src/vanilla/gemm_convolution_bwd_w.cpp (ncc needs its first omp loop in a
+ * separate file) */
 #if VE_OPENMP_BUG
 void gemm_convolution_bwd_weights_t::execute_backward_weights_bias() {
     //auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
@@ -226,6 +226,8 @@ struct gemm_convolution_bwd_data_t: public cpu_primitive_t {
                         this->desc()->diff_src_desc.data_type,
                         this->desc()->weights_desc.data_type,
                         this->desc()->diff_dst_desc.data_type));
+            AND_(utils::implication(this->with_bias(),
+                        this->desc()->bias_desc.data_type == data_type::f32));
             AND_(this->diff_src_pd_.desc()->format == src_format());
             AND_(this->diff_dst_pd_.desc()->format == src_format());
             AND_(this->weights_pd_.desc()->format == wei_format());
@@ -233,6 +235,9 @@ struct gemm_convolution_bwd_data_t: public cpu_primitive_t {
             return ok ? status::success : status::unimplemented;
         }
 
+        /* the bias of a deconvolution, started from by col2im */
+        virtual bool support_bias() const override { return true; }
+
         jit_gemm_conv_conf_t jcp_;
 
     protected:
@@ -244,6 +249,8 @@ struct gemm_convolution_bwd_data_t: public cpu_primitive_t {
                 CHECK(this->diff_dst_pd_.set_format(src_format()));
             if (this->weights_pd_.desc()->format == any)
                 CHECK(this->weights_pd_.set_format(wei_format()));
+            if (this->bias_pd_.desc()->format == any)
+                CHECK(this->bias_pd_.set_format(x));
             return status::success;
         }
     };
@@ -364,14 +371,17 @@ struct gemm_convolution_bwd_weights_t: public cpu_primitive_t {
         jit_gemm_convolution_utils::init_conf(conf_.jcp_,
             *(conf_.desc()), conf_.src_pd(), conf_.diff_weights_pd(0),
             conf_.diff_dst_pd(), omp_get_max_threads());
-        const memory_desc_wrapper weights_d(conf_.diff_weights_pd(0));
+        const jit_gemm_conv_conf_t &jcp = conf_.jcp_;
 
-        size_t size = (size_t)conf_.jcp_.im2col_sz  * sizeof(data_t);
-        if (conf_.jcp_.need_wei_reduction)
-            size += (size_t)conf_.jcp_.ngroups * weights_d.size();
+        /* per thread: the columns of its ic slice and, when the minibatch
+         * is split, a partial sum of its weights slice */
+        const size_t ic_slice = utils::div_up(jcp.ic, jcp.nthr_ic);
+        col_per_thr_ = jcp.im2col_sz ? ic_slice * jcp.ks * jcp.os : 0;
+        wei_per_thr_ = jcp.need_wei_reduction ? ic_slice * jcp.ks * jcp.oc : 0;
 
         jit_gemm_convolution_utils::prepare_scratchpad(this->conf_.jcp_,
-                &this->scratchpad_, size, conf_.jcp_.nthr);
+                &this->scratchpad_,
+                (col_per_thr_ + wei_per_thr_) * sizeof(data_t), jcp.nthr);
     }
 
     ~gemm_convolution_bwd_weights_t() {
@@ -399,6 +409,7 @@ private:
 #endif
     pd_t conf_;
     scratchpad_t *scratchpad_;
+    size_t col_per_thr_, wei_per_thr_;
 };
 
 }
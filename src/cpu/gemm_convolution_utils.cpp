@@ -19,6 +19,7 @@
 #include "c_types_map.hpp"
 #include "utils.hpp"
 #include "type_helpers.hpp"
+#include "idiv.hpp"
 #include "gemm_convolution_utils.hpp"
 
 namespace mkldnn {
@@ -487,6 +488,45 @@ void im2col_u8(
     }
 }
 
+/* col[ic][kd][kh][kw][oh][ow] <-- im2col_bf16(im[ic][id][ih][iw]) for the
+ * output plane od; taps that fall into the padding are stored as zeros, so
+ * col needs no initialization */
+void im2col_bf16(jit_gemm_conv_conf_t &jcp, const bfloat16_t *im,
+        bfloat16_t *col, int od) {
+    const size_t im_step = (size_t)jcp.id * jcp.ih * jcp.iw;
+    const size_t col_step = (size_t)jcp.ks * jcp.os;
+    const bfloat16_t zero = bfloat16_t::from_bits(0);
+
+    OMP(parallel for)
+    for (int ic = 0; ic < jcp.ic; ++ic) {
+        const bfloat16_t *im_ = im + ic * im_step;
+        bfloat16_t *col_ = col + ic * col_step;
+        for (int kd = 0; kd < jcp.kd; ++kd)
+        for (int kh = 0; kh < jcp.kh; ++kh)
+        for (int kw = 0; kw < jcp.kw; ++kw) {
+            const int id = od * jcp.stride_d - jcp.f_pad
+                + kd * (1 + jcp.dilate_d);
+            const bool d_ok = id >= 0 && id < jcp.id;
+            bfloat16_t *c = col_
+                + ((size_t)(kd * jcp.kh + kh) * jcp.kw + kw) * jcp.os;
+            for (int oh = 0; oh < jcp.oh; ++oh) {
+                const int ih = oh * jcp.stride_h - jcp.t_pad
+                    + kh * (1 + jcp.dilate_h);
+                const bool h_ok = d_ok && ih >= 0 && ih < jcp.ih;
+                const bfloat16_t *i_row = im_
+                    + ((size_t)id * jcp.ih + ih) * jcp.iw;
+                bfloat16_t *c_row = c + oh * jcp.ow;
+                for (int ow = 0; ow < jcp.ow; ++ow) {
+                    const int iw = ow * jcp.stride_w - jcp.l_pad
+                        + kw * (1 + jcp.dilate_w);
+                    c_row[ow] = h_ok && iw >= 0 && iw < jcp.iw
+                        ? i_row[iw] : zero;
+                }
+            }
+        }
+    }
+}
+
 /* im[ih][iw][ic] <-- col2im_s32(col[oh][ow][kh][kw][ic]) */
 void col2im_s32(
     jit_gemm_conv_conf_t &jcp, const int32_t *col, int32_t *im) {
@@ -562,17 +602,23 @@ void col2im_3d(
         }
         float *im_ = im + id * jcp.ih * jcp.iw;
 
-        for (int oh = 0; oh < jcp.oh; ++oh) {
         for (int kh = 0; kh < jcp.kh; ++kh) {
+            const int oh_beg = window_o_beg(kh, jcp.stride_h, jcp.t_pad,
+                    1 + jcp.dilate_h);
+            const int oh_end = window_o_end(kh, jcp.oh, jcp.ih, jcp.stride_h,
+                    jcp.t_pad, 1 + jcp.dilate_h);
+        for (int oh = oh_beg; oh < oh_end; ++oh) {
             const int ih = oh * jcp.stride_h - jcp.t_pad
                 + kh * (1 + jcp.dilate_h);
-            if (ih < 0 || ih >= jcp.ih) continue;
 
-            for (int ow = 0; ow < jcp.ow; ++ow) {
             for (int kw = 0; kw < jcp.kw; ++kw) {
+                const int ow_beg = window_o_beg(kw, jcp.stride_w, jcp.l_pad,
+                        1 + jcp.dilate_w);
+                const int ow_end = window_o_end(kw, jcp.ow, jcp.iw,
+                        jcp.stride_w, jcp.l_pad, 1 + jcp.dilate_w);
+            for (int ow = ow_beg; ow < ow_end; ++ow) {
                 const int iw = ow * jcp.stride_w - jcp.l_pad
                     + kw * (1 + jcp.dilate_w);
-                if (iw < 0 || iw >= jcp.iw) continue;
 
                 const size_t col_idx = ((kh*jcp.kw + kw)*jcp.oh+oh)*jcp.ow+ow;
                 const size_t im_idx = ih*jcp.iw + iw;
@@ -590,7 +636,8 @@ void col2im_3d(
 }
 
 void col2im(
-    jit_gemm_conv_conf_t &jcp, const float *col, float *im) {
+    jit_gemm_conv_conf_t &jcp, const float *col, float *im,
+    const float *bias) {
 
     const size_t col_step = jcp.ks * jcp.os;
     const size_t im_step = jcp.ih * jcp.iw;
@@ -600,22 +647,32 @@ void col2im(
     for (int ic = 0; ic < jcp.ic; ++ic) {
         float *im_ = im + ic * im_step;
         const float *col_ = col + ic * col_step;
+        const float b = bias ? bias[ic] : 0.f;
         PRAGMA_OMP_SIMD()
-        for (int is = 0; is < iS; ++is) im_[is] = 0.;
+        for (int is = 0; is < iS; ++is) im_[is] = b;
 
+        /* only the (kh, oh) and (kw, ow) pairs that land inside the
+         * image: no bounds check per tap */
         for (int kh = 0; kh < jcp.kh; ++kh) {
-        for (int oh = 0; oh < jcp.oh; ++oh) {
+            const int oh_beg = window_o_beg(kh, jcp.stride_h, jcp.t_pad,
+                    1 + jcp.dilate_h);
+            const int oh_end = window_o_end(kh, jcp.oh, jcp.ih, jcp.stride_h,
+                    jcp.t_pad, 1 + jcp.dilate_h);
+        for (int oh = oh_beg; oh < oh_end; ++oh) {
             const int ih = oh * jcp.stride_h - jcp.t_pad + kh * (1 + jcp.dilate_h);
-            if (ih < 0 || ih >= jcp.ih) continue;
 
             for (int kw = 0; kw < jcp.kw; ++kw) {
-            for (int ow = 0; ow < jcp.ow; ++ow) {
-                const int iw = ow * jcp.stride_w - jcp.l_pad + kw * (1 + jcp.dilate_w);
-                if (iw < 0 || iw >= jcp.iw) continue;
-
-                const size_t col_idx = ((kh*jcp.kw + kw)*jcp.oh+oh)*jcp.ow+ow;
-                const size_t im_idx = ih*jcp.iw + iw;
-                im_[im_idx] += col_[col_idx];
+                const int ow_beg = window_o_beg(kw, jcp.stride_w, jcp.l_pad,
+                        1 + jcp.dilate_w);
+                const int ow_end = window_o_end(kw, jcp.ow, jcp.iw,
+                        jcp.stride_w, jcp.l_pad, 1 + jcp.dilate_w);
+                const int iw_beg = ow_beg * jcp.stride_w - jcp.l_pad
+                    + kw * (1 + jcp.dilate_w);
+                const float *c = col_ + ((kh*jcp.kw + kw)*jcp.oh+oh)*jcp.ow;
+                float *i = im_ + ih*jcp.iw + iw_beg;
+            for (int ow = ow_beg; ow < ow_end; ++ow) {
+                *i += c[ow];
+                i += jcp.stride_w;
             }
             }
         }
@@ -709,7 +766,21 @@ void init_conf(
     return status::success;
 #endif
     jcp.nthr = do_outer_threading ? max_threads : 1;
-    jcp.need_wei_reduction = (jcp.mb != 1 && jcp.nthr != 1);
+
+    /* backward weights: give each thread whole rows (ic slices) of a group's
+     * weights, and split the minibatch only when groups and ic slices do
+     * not keep all the threads busy; the minibatch split is reduced over
+     * nthr_mb - 1 slice-sized partial buffers */
+    jcp.nthr_g = nstl::min(jcp.ngroups, jcp.nthr);
+    jcp.nthr_ic = jcp.nthr_mb = 1;
+    if (jcp.prop_kind == backward_weights) {
+        const int nthr_rest = jcp.nthr / jcp.nthr_g;
+        const int min_rows = 32; /* keep the per-slice gemm reasonably tall */
+        jcp.nthr_ic = nstl::max(1, nstl::min(nthr_rest,
+                    nstl::min(jcp.ic, jcp.ic * jcp.ks / min_rows)));
+        jcp.nthr_mb = nstl::min(jcp.mb, nthr_rest / jcp.nthr_ic);
+    }
+    jcp.need_wei_reduction = jcp.nthr_mb > 1;
 }
 
 status_t prepare_scratchpad(jit_gemm_conv_conf_t &jcp,
@@ -723,30 +794,33 @@ status_t prepare_scratchpad(jit_gemm_conv_conf_t &jcp,
     return status::success;
 }
 
-void bwd_weights_balance(int ithr, int nthr, int ngroups, int mb, int &ithr_g,
-        int &nthr_g, int &ithr_mb, int &nthr_mb) {
-    nthr_g = nstl::min(ngroups, nthr);
-    nthr_mb = nstl::min(mb, nthr / nthr_g);
-    if (ithr / nthr_mb >= ngroups) {
-        ithr_g = ithr_mb = -1;
-    } else {
-        ithr_g = ithr / nthr_mb;
-        ithr_mb = ithr % nthr_mb;
+void bwd_weights_balance(int ithr, const jit_gemm_conv_conf_t &jcp,
+        int &ithr_g, int &ithr_ic, int &ithr_mb) {
+    const int nthr_team = jcp.nthr_ic * jcp.nthr_mb;
+    if (ithr >= jcp.nthr_g * nthr_team) {
+        ithr_g = ithr_ic = ithr_mb = -1;
+        return;
     }
+    ithr_g = ithr / nthr_team;
+    ithr_ic = (ithr % nthr_team) / jcp.nthr_mb;
+    ithr_mb = ithr % jcp.nthr_mb;
 }
 
-void bwd_weights_reduction_par(int ithr, int nthr, const jit_gemm_conv_conf_t &jcp,
-        const float *weights_reduce_ws, float *weights) {
-    const size_t weights_g_size = jcp.ic * jcp.oc * jcp.ks;
-
-    size_t weights_start{0}, weights_end{0};
-    balance211(weights_g_size, nthr, ithr, weights_start, weights_end);
+void bwd_weights_reduction_par(int ithr_mb, const jit_gemm_conv_conf_t &jcp,
+        int m, const float *partials, size_t partial_stride, int ld_partial,
+        float *weights, int ld_weights) {
+    size_t oc_start{0}, oc_end{0};
+    balance211((size_t)jcp.oc, jcp.nthr_mb, ithr_mb, oc_start, oc_end);
 
     // Note: no omp directive here (called from one of jcp.nthr)
-    for (int i = 0; i < nthr; ++i) {
-        const float *ws_i = weights_reduce_ws + i * weights_g_size;
-        for (size_t s = weights_start; s < weights_end; ++s)
-            weights[s] = (i == 0 ? 0 : weights[s]) + ws_i[s];
+    for (size_t oc = oc_start; oc < oc_end; ++oc) {
+        float *w = weights + oc * ld_weights;
+        for (int i = 1; i < jcp.nthr_mb; ++i) {
+            const float *p = partials + i * partial_stride + oc * ld_partial;
+            PRAGMA_OMP_SIMD()
+            for (int r = 0; r < m; ++r)
+                w[r] += p[r];
+        }
     }
 }
 
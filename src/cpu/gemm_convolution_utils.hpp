@@ -35,10 +35,13 @@ namespace jit_gemm_convolution_utils {
         int od);
     void im2col(jit_gemm_conv_conf_t &jcp, const float *im, float *col);
     void im2col_u8(jit_gemm_conv_conf_t &jcp, const uint8_t *im, uint8_t *col);
+    void im2col_bf16(jit_gemm_conv_conf_t &jcp, const bfloat16_t *im,
+        bfloat16_t *col, int od);
     void col2im_s32(jit_gemm_conv_conf_t &jcp, const int32_t *col, int32_t *im);
     void col2im_3d(jit_gemm_conv_conf_t &jcp, const float *col, float *im,
         int od);
-    void col2im(jit_gemm_conv_conf_t &jcp, const float *col, float *im);
+    void col2im(jit_gemm_conv_conf_t &jcp, const float *col, float *im,
+            const float *bias = nullptr);
 
     void init_conf(jit_gemm_conv_conf_t &jcp,
         const convolution_desc_t &cd, const memory_desc_wrapper &src_d,
@@ -48,12 +51,17 @@ namespace jit_gemm_convolution_utils {
     status_t prepare_scratchpad(jit_gemm_conv_conf_t &jcp,
                 scratchpad_t **col_scratchpad_, size_t size, const int nthr);
 
-    void bwd_weights_balance(int ithr, int nthr,
-        int ngroups, int mb, int &ithr_g, int &nthr_g, int &ithr_mb,
-            int &nthr_mb);
-    void bwd_weights_reduction_par(int ithr, int nthr,
-        const jit_gemm_conv_conf_t &jcp, const float *weights_reduce_ws,
-            float *weights);
+    /* position of thread ithr in the groups x ic slices x minibatch grid
+     * of jcp (all -1 for an idle thread) */
+    void bwd_weights_balance(int ithr, const jit_gemm_conv_conf_t &jcp,
+        int &ithr_g, int &ithr_ic, int &ithr_mb);
+    /* adds the partial sums 1 .. nthr_mb - 1 (m x oc each, partial i at
+     * partials + i * partial_stride) to the m x oc weights slice; the
+     * columns are split over the nthr_mb threads of the team */
+    void bwd_weights_reduction_par(int ithr_mb,
+        const jit_gemm_conv_conf_t &jcp, int m, const float *partials,
+        size_t partial_stride, int ld_partial, float *weights,
+        int ld_weights);
 };
 
 }
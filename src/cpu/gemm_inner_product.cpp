@@ -47,19 +47,13 @@ void gemm_inner_product_fwd_t<data_type>::execute_forward() {
 
     const auto &post_ops = conf_.attr()->post_ops_;
     const bool do_relu = post_ops.len_ == 1;
+    const float nslope = do_relu ? post_ops.entry_[0].eltwise.alpha : 0.f;
 
+    /* bias (one per oc, a row of C) and relu go with the store */
     float alpha = 1.0, beta = 0.0;
     extended_sgemm(wei_tr ? "T" : "N", "N", &OC, &MB, &IC, &alpha, weights,
-            wei_tr ? &IC : &OC, src, &IC, &beta, dst, &OC, bias);
-
-    if (do_relu) {
-        float nslope = post_ops.entry_[0].eltwise.alpha;
-        parallel_nd(MB, OC, [&](int mb, int oc) {
-            size_t dst_off = mb * OC + oc;
-            if (dst[dst_off] < 0)
-                dst[dst_off] *= nslope;
-        });
-    }
+            wei_tr ? &IC : &OC, src, &IC, &beta, dst, &OC,
+            gemm_epilogue_t(bias, nullptr, do_relu, nslope));
 }
 
 template <impl::data_type_t data_type>
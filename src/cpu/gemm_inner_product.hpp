@@ -118,6 +118,9 @@ struct gemm_inner_product_bwd_data_t: public cpu_primitive_t {
         e->set_state(event_t::ready);
     }
 
+    /* the gemm also computes the padded input channels */
+    virtual bool preserves_zero_padding() const { return false; }
+
 private:
     void execute_backward_data();
     pd_t conf_;
@@ -162,6 +165,9 @@ struct gemm_inner_product_bwd_weights_t: public cpu_primitive_t {
         e->set_state(event_t::ready);
     }
 
+    /* the gemm also computes the padded input channels */
+    virtual bool preserves_zero_padding() const { return false; }
+
 private:
     void execute_backward_weights();
     pd_t conf_;
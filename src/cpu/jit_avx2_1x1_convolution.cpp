@@ -421,6 +421,11 @@ void jit_avx2_1x1_convolution_bwd_weights_t::execute_backward_weights() {
         }
     };
 
+    /* the partial results of the call (outside of the parallel region) */
+    data_t *rw_workspace = reducer_weights_->get_workspace();
+    data_t *rb_workspace = conf_.with_bias()
+        ? reducer_bias_->get_workspace() : nullptr;
+
     auto ker = [&](const int ithr, const int nthr) {
         auto rw = this->reducer_weights_;
         assert(nthr == rw->balancer_.nthr_);
@@ -461,7 +466,7 @@ void jit_avx2_1x1_convolution_bwd_weights_t::execute_backward_weights() {
                 store_to_ld = jcp.ic * jcp.oc_block;
             } else {
                 const size_t off = iwork * rw->balancer_.job_size_;
-                store_to = &rw->get_local_ptr(ithr, nullptr)[off];
+                store_to = &rw->get_local_ptr(ithr, nullptr, rw_workspace)[off];
                 store_to_ld = nb_ic_blocking * jcp.ic_block * jcp.oc_block;
             }
 
@@ -485,7 +490,7 @@ void jit_avx2_1x1_convolution_bwd_weights_t::execute_backward_weights() {
             nd_iterator_step(g, jcp.ngroups, load_i, load_work, bcast_i,
                              bcast_work);
         }
-        rw->reduce(ithr, diff_weights);
+        rw->reduce(ithr, diff_weights, rw_workspace);
     };
 
     auto ker_bias = [&](int ithr, int nthr) {
@@ -512,7 +517,8 @@ void jit_avx2_1x1_convolution_bwd_weights_t::execute_backward_weights() {
                 const size_t _oc = g * nb_oc + ocb;
 
                 const data_t *d_dst = &diff_dst[diff_dst_d.blk_off(img, _oc)];
-                data_t *d_bias = &rb->get_local_ptr(ithr, diff_bias)[
+                data_t *d_bias = &rb->get_local_ptr(ithr, diff_bias,
+                        rb_workspace)[
                     b_job_loc * rb->balancer_.job_size_];
 
                 if (img == img_start)
@@ -528,7 +534,7 @@ void jit_avx2_1x1_convolution_bwd_weights_t::execute_backward_weights() {
                 nd_iterator_step(g, jcp.ngroups, ocb, nb_oc);
             }
         }
-        rb->reduce(ithr, diff_bias);
+        rb->reduce(ithr, diff_bias, rb_workspace);
     };
 
 #   pragma omp parallel
@@ -268,6 +268,11 @@ void jit_avx2_convolution_bwd_weights_t::execute_backward_weights() {
 
     const auto &jcp = kernel_->jcp;
 
+    /* the partial results of the call (outside of the parallel region) */
+    data_t *rw_workspace = reducer_weights_->get_workspace();
+    data_t *rb_workspace = conf_.with_bias()
+        ? reducer_bias_->get_workspace() : nullptr;
+
     auto ker = [&](int ithr, int nthr) {
         auto rw = this->reducer_weights_;
         assert(nthr == rw->balancer_.nthr_);
@@ -306,9 +311,9 @@ void jit_avx2_convolution_bwd_weights_t::execute_backward_weights() {
 
                 /* TODO: put dw <-- 0 in kernel */
                 if (img == img_first)
-                    array_set((data_t *)&rw->get_local_ptr(ithr, diff_weights)[
-                        w_job_loc * rw->balancer_.job_size_], 0,
-                            rw->balancer_.job_size_);
+                    array_set((data_t *)&rw->get_local_ptr(ithr, diff_weights,
+                            rw_workspace)[w_job_loc * rw->balancer_.job_size_],
+                            0, rw->balancer_.job_size_);
 
                 for (int od = od_s; od < od_e; ++od) {
                     const int id = od * jcp.stride_d;
@@ -318,8 +323,8 @@ void jit_avx2_convolution_bwd_weights_t::execute_backward_weights() {
                     par_conv.src = &src[src_blk_off(src_d, img, _ic, id, 0, 0)];
                     par_conv.dst =
                         &diff_dst[src_blk_off(diff_dst_d, img, _oc, od, 0, 0)];
-                    par_conv.filt = &rw->get_local_ptr(ithr, diff_weights)[
-                        w_job_loc * rw->balancer_.job_size_];
+                    par_conv.filt = &rw->get_local_ptr(ithr, diff_weights,
+                            rw_workspace)[w_job_loc * rw->balancer_.job_size_];
 
                     kernel_->jit_ker(&par_conv);
                 }
@@ -328,7 +333,7 @@ void jit_avx2_convolution_bwd_weights_t::execute_backward_weights() {
             }
             nd_iterator_jump(img_start, img_end, img, jcp.mb, od_s, jcp.od);
         }
-        rw->reduce(ithr, diff_weights);
+        rw->reduce(ithr, diff_weights, rw_workspace);
     };
 
     auto ker_bias = [&](int ithr, int nthr) {
@@ -356,7 +361,8 @@ void jit_avx2_convolution_bwd_weights_t::execute_backward_weights() {
                 const size_t _oc = g * jcp.nb_oc + ocb;
 
                 const data_t *d_dst = &diff_dst[diff_dst_d.blk_off(img, _oc)];
-                data_t *d_bias = &rb->get_local_ptr(ithr, diff_bias)[
+                data_t *d_bias = &rb->get_local_ptr(ithr, diff_bias,
+                        rb_workspace)[
                     b_job_loc * rb->balancer_.job_size_];
 
                 if (img == img_start)
@@ -373,7 +379,7 @@ void jit_avx2_convolution_bwd_weights_t::execute_backward_weights() {
                 nd_iterator_step(g, jcp.ngroups, ocb, jcp.nb_oc);
             }
         }
-        rb->reduce(ithr, diff_bias);
+        rb->reduce(ithr, diff_bias, rb_workspace);
     };
 
 #   pragma omp parallel
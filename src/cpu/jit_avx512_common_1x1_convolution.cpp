@@ -735,6 +735,10 @@ void jit_avx512_common_1x1_convolution_bwd_weights_t::execute_backward_weights()
             }
         }
     };
+    /* the partial results of the call (outside of the parallel region) */
+    data_t *rb_workspace = reducer_bias_
+        ? reducer_bias_->get_workspace() : nullptr;
+
     auto ker_bias = [&](int ithr, int nthr) {
         auto rb = this->reducer_bias_;
         assert(nthr == rb->balancer_.nthr_);
@@ -762,8 +766,8 @@ void jit_avx512_common_1x1_convolution_bwd_weights_t::execute_backward_weights()
                 const size_t _oc = g * jcp.nb_load + ocb;
 
                 const data_t *d_dst = &diff_dst[diff_dst_d.blk_off(img, _oc)];
-                data_t *d_bias = &rb->get_local_ptr(
-                        ithr, diff_bias)[b_job_loc * rb->balancer_.job_size_];
+                data_t *d_bias = &rb->get_local_ptr(ithr, diff_bias,
+                        rb_workspace)[b_job_loc * rb->balancer_.job_size_];
 
                 if (img == img_start)
                     for (int o = 0; o < 16; ++o)
@@ -779,7 +783,7 @@ void jit_avx512_common_1x1_convolution_bwd_weights_t::execute_backward_weights()
                 nd_iterator_step(g, jcp.ngroups, ocb, jcp.nb_load);
             }
         }
-        rb->reduce(ithr, diff_bias);
+        rb->reduce(ithr, diff_bias, rb_workspace);
     };
 
 #pragma omp parallel num_threads(jcp.nthr)
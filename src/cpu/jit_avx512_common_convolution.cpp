@@ -731,6 +731,7 @@ struct jit_avx512_common_convolution_bwd_weights_t<src_type, diff_dst_type,
     const diff_dst_data_t *diff_dst;
     const diff_weights_data_t *diff_weights;
     diff_weights_data_t *diff_bias;
+    diff_weights_data_t *bias_workspace; /* of reducer_bias_, for the call */
 
     int ithr;
     int ithr_ic_b, ithr_oc_b, ithr_g, ithr_mb;
@@ -743,7 +744,8 @@ struct jit_avx512_common_convolution_bwd_weights_t<src_type, diff_dst_type,
     int ic_b_start, ic_b_end, ic_b_work;
 
     thread_info_t(const jit_avx512_common_convolution_bwd_weights_t *self,
-            int ithr): ithr(ithr) {
+            int ithr, diff_weights_data_t *bias_workspace)
+        : bias_workspace(bias_workspace), ithr(ithr) {
 
         src = reinterpret_cast<const src_data_t *>(self->input_memory(0));
         diff_dst = reinterpret_cast<const diff_dst_data_t *>(
@@ -1289,7 +1291,7 @@ void jit_avx512_common_convolution_bwd_weights_t<src_type, diff_dst_type,
             const diff_dst_data_t *d_dst
                 = &ti->diff_dst[diff_dst_d.blk_off(img, _oc)];
             diff_weights_data_t *d_bias = &rb->get_local_ptr(ti->ithr,
-                (diff_weights_data_t *)ti->diff_bias)[
+                (diff_weights_data_t *)ti->diff_bias, ti->bias_workspace)[
                 b_job_loc * rb->balancer_.job_size_];
 
             if (img == img_start)
@@ -1306,7 +1308,7 @@ void jit_avx512_common_convolution_bwd_weights_t<src_type, diff_dst_type,
         }
     }
 
-    rb->reduce(ti->ithr, ti->diff_bias);
+    rb->reduce(ti->ithr, ti->diff_bias, ti->bias_workspace);
 }
 
 template <data_type_t src_type, data_type_t diff_dst_type,
@@ -1337,12 +1339,16 @@ template <data_type_t src_type, data_type_t diff_dst_type,
           data_type_t diff_weights_type>
 void jit_avx512_common_convolution_bwd_weights_t<src_type, diff_dst_type,
     diff_weights_type>::execute_backward_weights() {
+    /* the partial results of the call (outside of the parallel region) */
+    diff_weights_data_t *bias_workspace = reducer_bias_
+        ? reducer_bias_->get_workspace() : nullptr;
+
 #   pragma omp parallel num_threads(nthr_)
     {
         int ithr = omp_get_thread_num();
         assert(nthr_ == omp_get_num_threads());
 
-        thread_info_t thread_info(this, ithr);
+        thread_info_t thread_info(this, ithr, bias_workspace);
 
         if (conf_.ndims() == 4) {
             compute_diff_weights(&thread_info);
@@ -355,6 +355,8 @@ struct jit_gemm_conv_conf_t {
     int nthr;
     ptrdiff_t im2col_sz;
     bool need_wei_reduction;
+    /* backward weights: threads over groups x ic slices x minibatch */
+    int nthr_g, nthr_ic, nthr_mb;
 };
 #endif
 
@@ -257,6 +257,8 @@ inline void init_rtus_driver(conv_t *self) {
     size_t typesize = sizeof(decltype(*self->scratch_));
 
     self->ws_per_thread_ = factor * conf.jcp_.is * conf.jcp_.ic_block;
+    /* XXX: the rtus buffer is shared by all the calls, so unlike the
+     * scratchpads it does not allow a concurrent execution */
     self->scratch_ = (decltype(self->scratch_))malloc(
             max_threads * self->ws_per_thread_ * typesize, 64);
 
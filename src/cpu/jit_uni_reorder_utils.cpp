@@ -68,6 +68,7 @@ status_t cvt_mem_desc_to_layout_desc(const memory_desc_t &md_,
     case memory_format::undef:
     case memory_format::any:
     case wino_fmt:
+    case bcsr_fmt:
         return invalid_arguments;
     case OIhw4i16o4i:
         P(0, bd.padding_dims[0] / 16, bd.strides[0][0]);
@@ -38,26 +38,18 @@ namespace cpu {
 typedef float data_t;
 ncsp_batch_normalization_fwd_t::ncsp_batch_normalization_fwd_t(const pd_t *pd,
         const input_vector &inputs, const output_vector &outputs)
-    : cpu_primitive_t(&conf_, inputs, outputs), stats_reduction_(nullptr),
-    tmp_mean_(nullptr), tmp_variance_(nullptr), conf_(*pd) {
+    : cpu_primitive_t(&conf_, inputs, outputs), scratchpad_(nullptr),
+    tmp_stats_off_(0), conf_(*pd) {
     if (!conf_.stats_is_src()) {
-        this->stats_reduction_ = (data_t *)malloc(
-                conf_.C() * omp_get_max_threads() * sizeof(data_t), 64);
-        if (!conf_.is_training()) {
-            this->tmp_mean_ = (data_t *)malloc(conf_.C() * sizeof(data_t), 64);
-            this->tmp_variance_
-                    = (data_t *)malloc(conf_.C() * sizeof(data_t), 64);
-        }
+        tmp_stats_off_ = 3 * conf_.C() * omp_get_max_threads();
+        size_t size = tmp_stats_off_;
+        if (!conf_.is_training())
+            size += 2 * conf_.C();
+        scratchpad_ = create_scratchpad(size * sizeof(data_t));
     }
 }
 ncsp_batch_normalization_fwd_t::~ncsp_batch_normalization_fwd_t() {
-    if (!conf_.stats_is_src()) {
-        free(this->stats_reduction_);
-        if (!conf_.is_training()) {
-            free(this->tmp_mean_);
-            free(this->tmp_variance_);
-        }
-    }
+    delete scratchpad_;
 }
 
 void ncsp_batch_normalization_fwd_t::execute_forward() {
@@ -67,6 +59,7 @@ void ncsp_batch_normalization_fwd_t::execute_forward() {
     const bool save_stats = conf_.is_training();
     const bool is_training = conf_.is_training();
     const bool fuse_bn_relu = conf_.fuse_bn_relu();
+    data_t *ws_reduce = scratchpad_ ? (data_t *)scratchpad_->get() : nullptr;
 
     data_t *mean, *variance;
     if (!calculate_stats) {
@@ -79,15 +72,14 @@ void ncsp_batch_normalization_fwd_t::execute_forward() {
             mean = reinterpret_cast<data_t *>(this->memory(1));
             variance = reinterpret_cast<data_t *>(this->memory(2));
         } else {
-            mean = this->tmp_mean_;
-            variance = this->tmp_variance_;
+            mean = ws_reduce + tmp_stats_off_;
+            variance = mean + conf_.C();
         }
     }
     auto idx_scale_shift = 1 + 2 * conf_.stats_is_src();
     auto scaleshift = reinterpret_cast<const data_t *>(
             this->input_memory(idx_scale_shift));
     auto ws = reinterpret_cast<uint8_t *>(this->memory(conf_.ws_idx()));
-    data_t *ws_reduce = this->stats_reduction_;
 
     const float eps = conf_.desc()->batch_norm_epsilon;
     const bool use_scaleshift = conf_.use_scaleshift();
@@ -137,44 +129,36 @@ void ncsp_batch_normalization_fwd_t::execute_forward() {
             }
             size_t C_off = it * C_blks_per_iter;
             if (calculate_stats) {
+                // single sweep: per-thread (count, mean, m2) partials over
+                // this thread's N x SP chunk, then a Chan merge per channel
                 data_t *mean_blk = mean + C_off;
                 data_t *variance_blk = variance + C_off;
+                const size_t red_sz = (size_t)SP_N_nthr * C_blks_per_iter;
+                data_t *ws_n = ws_reduce;
+                data_t *ws_mean = ws_reduce + red_sz;
+                data_t *ws_m2 = ws_reduce + 2 * red_sz;
                 for (int c = C_blk_s; c < C_blk_e; c++) {
                     size_t off = (c + C_off) * SP;
-                    data_t sum = 0;
-                    for (int n = N_s; n < N_e; ++n)
-                        PRAGMA_OMP_SIMD(reduction(+ : sum))
-                        for (int sp = S_s; sp < S_e; ++sp) {
-                            sum += src[off + n * C * SP + sp];
-                        }
-                    ws_reduce[SP_N_ithr * C_blks_per_iter + c] = sum;
-                }
-#pragma omp barrier
-                for (int c = C_blk_gl_s; c < C_blk_gl_e; c++) {
-                    mean_blk[c] = 0.;
-                    for (int n = 0; n < SP_N_nthr; n++)
-                        mean_blk[c] += ws_reduce[n * C_blks_per_iter + c];
-                    mean_blk[c] /= (N * SP);
-                }
-#pragma omp barrier
-                for (int c = C_blk_s; c < C_blk_e; c++) {
-                    size_t off = c + C_off;
-                    data_t sum = 0.;
+                    data_t cnt = 0, v_mean = 0, m2 = 0;
                     for (int n = N_s; n < N_e; ++n)
-                        PRAGMA_OMP_SIMD(reduction(+ : sum))
-                        for (int sp = S_s; sp < S_e; ++sp) {
-                            data_t m = src[off * SP + n * C * SP + sp]
-                                    - mean[off];
-                            sum += m * m;
-                        }
-                    ws_reduce[SP_N_ithr * C_blks_per_iter + c] = sum;
+                        bnorm_utils::moments_accumulate(
+                                &src[off + n * C * SP + S_s], S_e - S_s,
+                                cnt, v_mean, m2);
+                    const size_t r_off = SP_N_ithr * C_blks_per_iter + c;
+                    ws_n[r_off] = cnt;
+                    ws_mean[r_off] = v_mean;
+                    ws_m2[r_off] = m2;
                 }
 #pragma omp barrier
                 for (int c = C_blk_gl_s; c < C_blk_gl_e; c++) {
-                    variance_blk[c] = 0.;
-                    for (int n = 0; n < SP_N_nthr; n++)
-                        variance_blk[c] += ws_reduce[n * C_blks_per_iter + c];
-                    variance_blk[c] /= (N * SP);
+                    data_t cnt = 0, v_mean = 0, m2 = 0;
+                    for (int n = 0; n < SP_N_nthr; n++) {
+                        const size_t r_off = n * C_blks_per_iter + c;
+                        bnorm_utils::moments_merge(cnt, v_mean, m2,
+                                ws_n[r_off], ws_mean[r_off], ws_m2[r_off]);
+                    }
+                    mean_blk[c] = v_mean;
+                    variance_blk[c] = m2 / (N * SP);
                 }
 #pragma omp barrier
             }
@@ -213,18 +197,17 @@ void ncsp_batch_normalization_fwd_t::execute_forward() {
 ncsp_batch_normalization_bwd_t::ncsp_batch_normalization_bwd_t(const pd_t *pd,
         const input_vector &inputs, const output_vector &outputs)
     : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
-    , stats_reduction_(nullptr), tmp_diff_scaleshift_(nullptr) {
-    this->stats_reduction_ = (data_t *)malloc(
-            conf_.C() * 2 * omp_get_max_threads() * sizeof(data_t), 64);
+    , scratchpad_(nullptr), tmp_diff_ss_off_(0) {
+    tmp_diff_ss_off_ = conf_.C() * 2 * omp_get_max_threads();
+    size_t size = tmp_diff_ss_off_;
     if (!(conf_.use_scaleshift()
                 && conf_.desc()->prop_kind == prop_kind::backward))
-        this->tmp_diff_scaleshift_
-                = (data_t *)malloc(conf_.C() * 2 * sizeof(data_t), 64);
+        size += conf_.C() * 2;
+    scratchpad_ = create_scratchpad(size * sizeof(data_t));
 }
 
 ncsp_batch_normalization_bwd_t::~ncsp_batch_normalization_bwd_t() {
-    free(this->stats_reduction_);
-    free(this->tmp_diff_scaleshift_);
+    delete scratchpad_;
 }
 
 void ncsp_batch_normalization_bwd_t::execute_backward() {
@@ -234,12 +217,12 @@ void ncsp_batch_normalization_bwd_t::execute_backward() {
     auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(3));
     auto scaleshift = reinterpret_cast<const data_t *>(this->input_memory(4));
     auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+    data_t *ws_reduce = (data_t *)scratchpad_->get();
     auto diff_scaleshift = (this->memory(1)) ?
             reinterpret_cast<data_t *>(this->memory(1)) :
-            this->tmp_diff_scaleshift_;
+            ws_reduce + tmp_diff_ss_off_;
     auto ws = reinterpret_cast<const uint8_t *>(
             this->input_memory(conf_.ws_idx()));
-    data_t *ws_reduce = this->stats_reduction_;
 
     const bool has_spatial = utils::one_of(conf_.ndims(), 4, 5);
     int SP = (has_spatial) ? conf_.H() * conf_.W() * conf_.D() : 1;
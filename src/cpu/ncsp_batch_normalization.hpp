@@ -22,6 +22,7 @@
 #include "c_types_map.hpp"
 #include "cpu_batch_normalization_pd.hpp"
 #include "cpu_engine.hpp"
+#include "scratchpad.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 
@@ -84,7 +85,9 @@ struct ncsp_batch_normalization_fwd_t : public cpu_primitive_t {
     }
 
 private:
-    data_t *stats_reduction_, *tmp_mean_, *tmp_variance_;
+    /* the reduction space, then the statistics when they are not outputs */
+    scratchpad_t *scratchpad_;
+    size_t tmp_stats_off_;
     void execute_forward();
     pd_t conf_;
 };
@@ -146,7 +149,9 @@ private:
     void execute_backward();
     pd_t conf_;
 
-    data_t *stats_reduction_, *tmp_diff_scaleshift_;
+    /* the reduction space, then diff_scaleshift when it is not an output */
+    scratchpad_t *scratchpad_;
+    size_t tmp_diff_ss_off_;
 };
 }
 }
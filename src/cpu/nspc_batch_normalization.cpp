@@ -17,6 +17,7 @@
 #include <assert.h>
 #include <math.h>
 
+#include "cpu_batch_normalization_utils.hpp"
 #include "c_types_map.hpp"
 #include "nspc_batch_normalization.hpp"
 #include "type_helpers.hpp"
@@ -37,24 +38,18 @@ namespace cpu {
 typedef float data_t;
 nspc_batch_normalization_fwd_t::nspc_batch_normalization_fwd_t(const pd_t *pd,
         const input_vector &inputs, const output_vector &outputs)
-    : cpu_primitive_t(&conf_, inputs, outputs), stats_reduction_(nullptr),
-    tmp_mean_(nullptr), tmp_variance_(nullptr), conf_(*pd) {
+    : cpu_primitive_t(&conf_, inputs, outputs), scratchpad_(nullptr),
+    tmp_mean_off_(0), tmp_variance_off_(0), conf_(*pd) {
     if (!conf_.stats_is_src()) {
-        this->stats_reduction_ = (data_t *)malloc(
-                nstl::max(conf_.C(), 16) * omp_get_max_threads() * sizeof(data_t), 64);
-        this->tmp_mean_ = (data_t *)malloc(omp_get_max_threads() *
-                nstl::max(conf_.C(), 16) * sizeof(data_t), 64);
-        this->tmp_variance_
-                = (data_t *)malloc(omp_get_max_threads() *
-                       nstl::max(conf_.C(), 16) * sizeof(data_t), 64);
+        const size_t C_nthr = (size_t)nstl::max(conf_.C(), 16)
+            * omp_get_max_threads();
+        tmp_mean_off_ = 2 * C_nthr;
+        tmp_variance_off_ = 3 * C_nthr;
+        scratchpad_ = create_scratchpad(4 * C_nthr * sizeof(data_t));
     }
 }
 nspc_batch_normalization_fwd_t::~nspc_batch_normalization_fwd_t() {
-    if (!conf_.stats_is_src()) {
-        free(this->stats_reduction_);
-        free(this->tmp_mean_);
-        free(this->tmp_variance_);
-    }
+    delete scratchpad_;
 }
 
 void nspc_batch_normalization_fwd_t::execute_forward() {
@@ -64,6 +59,9 @@ void nspc_batch_normalization_fwd_t::execute_forward() {
     const bool fuse_bn_relu = conf_.fuse_bn_relu();
     const bool calculate_stats = !conf_.stats_is_src();
     const bool with_relu = conf_.with_relu_post_op();
+    data_t *ws_reduce = scratchpad_ ? (data_t *)scratchpad_->get() : nullptr;
+    data_t *tmp_mean = ws_reduce + tmp_mean_off_;
+    data_t *tmp_variance = ws_reduce + tmp_variance_off_;
     data_t *mean, *variance;
     if (!calculate_stats) {
         mean = reinterpret_cast<data_t *>(
@@ -75,8 +73,8 @@ void nspc_batch_normalization_fwd_t::execute_forward() {
             mean = reinterpret_cast<data_t *>(this->memory(1));
             variance = reinterpret_cast<data_t *>(this->memory(2));
         } else {
-            mean = this->tmp_mean_;
-            variance = this->tmp_variance_;
+            mean = tmp_mean;
+            variance = tmp_variance;
         }
     }
     auto idx_scaleshift = 1 + 2 * conf_.stats_is_src();
@@ -85,7 +83,6 @@ void nspc_batch_normalization_fwd_t::execute_forward() {
 
     auto dst = reinterpret_cast<data_t *>(this->memory(0));
     auto ws = reinterpret_cast<uint8_t *>(this->memory(conf_.ws_idx()));
-    auto ws_reduce = this->stats_reduction_;
 
     const int N = conf_.MB();
     const int C = conf_.C();
@@ -102,51 +99,50 @@ void nspc_batch_normalization_fwd_t::execute_forward() {
         int N_s = 0, N_e = 0, C_s = 0, C_e = 0;
         balance211(N, nthr, ithr, N_s, N_e);
         balance211(C, nthr, ithr, C_s, C_e);
-        data_t *mean_loc = this->tmp_mean_ + nstl::max(C, 16)*ithr;
-        data_t *variance_loc = this->tmp_variance_ + nstl::max(C,16)*ithr;
+        data_t *mean_loc = tmp_mean + nstl::max(C, 16)*ithr;
+        data_t *variance_loc = tmp_variance + nstl::max(C,16)*ithr;
 
         if (calculate_stats) {
-            for (int c = 0; c < C; c++)
-                ws_reduce[C * ithr + c] = 0.;
-
-            for (int n = N_s; n < N_e; n++)
-                for (int sp = 0; sp < SP; sp++)
-                    PRAGMA_OMP_SIMD()
-                    for (int c = 0; c < C; c++)
-                        ws_reduce[C * ithr + c] += src[(size_t)n * SP * C
-                            + sp * C + c];
-
-#pragma omp barrier
-            for (int c = C_s; c < C_e; c++) {
-                mean[c] = 0;
-                for (int n = 0; n < nthr; n++)
-                    mean[c] += ws_reduce[C * n + c];
-                mean[c] /= SP * N;
-            }
-#pragma omp barrier
+            // single sweep: running (mean, m2) per channel over this
+            // thread's minibatch chunk, then a Chan merge across threads
+            data_t *mean_red = ws_reduce + C * ithr;
+            data_t *m2_red = ws_reduce + C * nthr + C * ithr;
             for (int c = 0; c < C; c++) {
-                mean_loc[c] = mean[c];
-                ws_reduce[C * ithr + c] = 0.;
+                mean_red[c] = 0.;
+                m2_red[c] = 0.;
             }
 
+            size_t cnt = 0;
             for (int n = N_s; n < N_e; n++)
-                for (int sp = 0; sp < SP; sp++)
+                for (int sp = 0; sp < SP; sp++) {
+                    const data_t *s = &src[(size_t)n * SP * C + sp * C];
+                    const data_t inv_cnt = 1.f / (data_t)(++cnt);
                     PRAGMA_OMP_SIMD()
                     for (int c = 0; c < C; c++) {
-                        data_t m = src[(size_t)n * SP * C + sp * C + c]
-                            - mean_loc[c];
-                        ws_reduce[C * ithr + c] += m * m;
+                        data_t delta = s[c] - mean_red[c];
+                        mean_red[c] += delta * inv_cnt;
+                        m2_red[c] += delta * (s[c] - mean_red[c]);
                     }
+                }
+
 #pragma omp barrier
             for (int c = C_s; c < C_e; c++) {
-                variance[c] = 0;
-                for (int n = 0; n < nthr; n++)
-                    variance[c] += ws_reduce[C * n + c];
-                variance[c] /= SP * N;
+                data_t n_acc = 0, v_mean = 0, m2 = 0;
+                for (int n = 0; n < nthr; n++) {
+                    int n_s = 0, n_e = 0;
+                    balance211(N, nthr, n, n_s, n_e);
+                    bnorm_utils::moments_merge(n_acc, v_mean, m2,
+                            (data_t)(n_e - n_s) * SP, ws_reduce[C * n + c],
+                            ws_reduce[C * nthr + C * n + c]);
+                }
+                mean[c] = v_mean;
+                variance[c] = m2 / (SP * N);
             }
 #pragma omp barrier
-            for (int c = 0; c < C; c++)
+            for (int c = 0; c < C; c++) {
+                mean_loc[c] = mean[c];
                 variance_loc[c] = variance[c];
+            }
         } else {
             variance_loc = variance;
             mean_loc = mean;
@@ -184,16 +180,15 @@ void nspc_batch_normalization_fwd_t::execute_forward() {
 
 nspc_batch_normalization_bwd_t::nspc_batch_normalization_bwd_t(const pd_t *pd,
         const input_vector &inputs, const output_vector &outputs)
-    : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {
-    this->stats_reduction_ = (data_t *)malloc(
-            conf_.C() * 2 * omp_get_max_threads() * sizeof(data_t), 64);
-    this->tmp_diff_scaleshift_
-            = (data_t *)malloc((omp_get_max_threads() + 1) * conf_.C() * 2 *
-                    sizeof(data_t), 64);
+    : cpu_primitive_t(&conf_, inputs, outputs), scratchpad_(nullptr)
+    , tmp_diff_ss_off_(0), conf_(*pd) {
+    tmp_diff_ss_off_ = (size_t)conf_.C() * 2 * omp_get_max_threads();
+    scratchpad_ = create_scratchpad((tmp_diff_ss_off_
+                + (omp_get_max_threads() + 1) * conf_.C() * 2)
+            * sizeof(data_t));
 }
 nspc_batch_normalization_bwd_t::~nspc_batch_normalization_bwd_t() {
-    free(this->stats_reduction_);
-    free(this->tmp_diff_scaleshift_);
+    delete scratchpad_;
 }
 
 
@@ -207,16 +202,17 @@ void nspc_batch_normalization_bwd_t::execute_backward() {
             this->input_memory(conf_.ws_idx()));
 
     auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
+    data_t *ws_reduce = (data_t *)scratchpad_->get();
+    data_t *tmp_diff_scaleshift = ws_reduce + tmp_diff_ss_off_;
     auto diff_scaleshift = (this->memory(1)) ?
             reinterpret_cast<data_t *>(this->memory(1)) :
-            this->tmp_diff_scaleshift_;
+            tmp_diff_scaleshift;
 
     const int N = conf_.MB();
     const int C = conf_.C();
     int SP = conf_.D() * conf_.H() * conf_.W();
     int nthr = omp_get_max_threads();
     data_t *diff_gamma = diff_scaleshift, *diff_beta = diff_scaleshift + C;
-    data_t *ws_reduce = this->stats_reduction_;
 
     const float eps = conf_.desc()->batch_norm_epsilon;
     const bool use_scaleshift = conf_.use_scaleshift();
@@ -229,8 +225,8 @@ void nspc_batch_normalization_bwd_t::execute_backward() {
         balance211(N, nthr, ithr, N_s, N_e);
         balance211(C, nthr, ithr, C_s, C_e);
 
-        data_t *diff_gamma_loc = this->tmp_diff_scaleshift_ + 2*C + C*ithr;
-        data_t *diff_beta_loc = this->tmp_diff_scaleshift_ + 2*C + C*nthr
+        data_t *diff_gamma_loc = tmp_diff_scaleshift + 2*C + C*ithr;
+        data_t *diff_beta_loc = tmp_diff_scaleshift + 2*C + C*nthr
             + C*ithr;
 
         for (int c = 0; c < C; c++) {
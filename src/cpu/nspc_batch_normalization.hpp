@@ -22,6 +22,7 @@
 #include "c_types_map.hpp"
 #include "cpu_batch_normalization_pd.hpp"
 #include "cpu_engine.hpp"
+#include "scratchpad.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
 #include "consistency.hpp"
@@ -83,8 +84,9 @@ struct nspc_batch_normalization_fwd_t : public cpu_primitive_t {
     }
 
 private:
-    data_t *stats_reduction_;
-    data_t *tmp_mean_, *tmp_variance_;
+    /* the reduction space, then the per thread statistics */
+    scratchpad_t *scratchpad_;
+    size_t tmp_mean_off_, tmp_variance_off_;
     void execute_forward();
     pd_t conf_;
 };
@@ -143,8 +145,9 @@ struct nspc_batch_normalization_bwd_t : public cpu_primitive_t {
     }
 
 private:
-    data_t *stats_reduction_;
-    data_t *tmp_diff_scaleshift_;
+    /* the reduction space, then the per thread diff_scaleshift */
+    scratchpad_t *scratchpad_;
+    size_t tmp_diff_ss_off_;
     void execute_backward();
     pd_t conf_;
 };
@@ -30,19 +30,19 @@ template <impl::data_type_t data_type>
 void ref_batch_normalization_fwd_t<data_type>::execute_forward() {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
     /* FIXME: check this */
-    data_t* mean = conf_.stats_is_src() ?
-        const_cast<data_t*>(reinterpret_cast<const data_t*>(
+    acc_data_t* mean = conf_.stats_is_src() ?
+        const_cast<acc_data_t*>(reinterpret_cast<const acc_data_t*>(
                this->input_memory(1))) :
-        reinterpret_cast<data_t*>(this->memory(1));
+        reinterpret_cast<acc_data_t*>(this->memory(1));
 
-    data_t* variance = conf_.stats_is_src() ?
-        const_cast<data_t*>(reinterpret_cast<const data_t*>(
+    acc_data_t* variance = conf_.stats_is_src() ?
+        const_cast<acc_data_t*>(reinterpret_cast<const acc_data_t*>(
                 this->input_memory(2))) :
-        reinterpret_cast<data_t*>(this->memory(2));
+        reinterpret_cast<acc_data_t*>(this->memory(2));
 
     auto idx_scaleshift = 1 + 2*conf_.stats_is_src();
-    auto scaleshift =
-        reinterpret_cast<const data_t *>(this->input_memory(idx_scaleshift));
+    auto scaleshift = reinterpret_cast<const acc_data_t *>(
+            this->input_memory(idx_scaleshift));
 
     auto dst = reinterpret_cast<data_t*>(this->memory(0));
     auto ws = reinterpret_cast<uint8_t *>(this->memory(conf_.ws_idx()));
@@ -72,7 +72,7 @@ void ref_batch_normalization_fwd_t<data_type>::execute_forward() {
     const bool calculate_stats = !conf_.stats_is_src();
 
     const bool with_relu = conf_.with_relu_post_op();
-    auto maybe_post_op = [&](data_t res) {
+    auto maybe_post_op = [&](acc_data_t res) {
         return (with_relu && res < 0) ? 0 : res;
     };
     const bool is_3d = data_d.ndims() == 5;
@@ -89,38 +89,36 @@ void ref_batch_normalization_fwd_t<data_type>::execute_forward() {
 
     OMP(parallel for schedule(static))//;
     for (int c = 0; c < C; ++c) {
-        data_t v_mean = calculate_stats ? 0 : mean[c];
-        data_t v_variance = calculate_stats ? 0 : variance[c];
+        acc_data_t v_mean = calculate_stats ? 0 : mean[c];
+        acc_data_t v_variance = calculate_stats ? 0 : variance[c];
 
-        data_t sm = use_scaleshift ? scaleshift[scaleshift_d.off(0, c)] : 1;
-        data_t sv = use_scaleshift ? scaleshift[scaleshift_d.off(1, c)] : 0;
+        acc_data_t sm = use_scaleshift ? scaleshift[scaleshift_d.off(0, c)] : 1;
+        acc_data_t sv = use_scaleshift ? scaleshift[scaleshift_d.off(1, c)] : 0;
         if (calculate_stats) {
-            for (int n = 0; n < N; ++n)
-            for (int d = 0; d < D; ++d)
-            for (int h = 0; h < H; ++h)
-            for (int w = 0; w < W; ++w)
-                v_mean += src[data_offset(data_d, n, c, d, h, w)];
-            v_mean /= W*N*H*D;
-
+            /* single-pass Welford update of mean and sum of squares */
+            int cnt = 0;
             for (int n = 0; n < N; ++n)
             for (int d = 0; d < D; ++d)
             for (int h = 0; h < H; ++h)
             for (int w = 0; w < W; ++w) {
-                data_t m = src[data_offset(data_d,n,c,d,h,w)] - v_mean;
-                v_variance += m*m;
+                acc_data_t s = src[data_offset(data_d, n, c, d, h, w)];
+                acc_data_t delta = s - v_mean;
+                v_mean += delta / ++cnt;
+                v_variance += delta * (s - v_mean);
             }
             v_variance /= W*H*N*D;
         }
 
-        data_t sqrt_variance =
-            static_cast<data_t>(1.0f / sqrtf(v_variance + eps));
+        acc_data_t sqrt_variance =
+            static_cast<acc_data_t>(1.0f / sqrtf(v_variance + eps));
 
         for (int n = 0; n < N; ++n)
         for (int d = 0; d < D; ++d)
         for (int h = 0; h < H; ++h)
         for (int w = 0; w < W; ++w) {
             auto d_off = data_offset(data_d,n,c,d,h,w);
-            data_t bn_res = sm * (src[d_off] - v_mean) * sqrt_variance + sv;
+            acc_data_t bn_res
+                = sm * (src[d_off] - v_mean) * sqrt_variance + sv;
             if (fuse_bn_relu) {
                 if (bn_res <= 0) {
                     bn_res = 0;
@@ -144,19 +142,22 @@ void ref_batch_normalization_fwd_t<data_type>::execute_forward() {
 }
 
 template struct ref_batch_normalization_fwd_t<data_type::f32>;
+template struct ref_batch_normalization_fwd_t<data_type::bf16>;
 
 template <impl::data_type_t data_type>
 void ref_batch_normalization_bwd_t<data_type>::execute_backward() {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
-    auto mean = reinterpret_cast<const data_t *>(this->input_memory(1));
-    auto variance = reinterpret_cast<const data_t *>(this->input_memory(2));
+    auto mean = reinterpret_cast<const acc_data_t *>(this->input_memory(1));
+    auto variance = reinterpret_cast<const acc_data_t *>(
+            this->input_memory(2));
     auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(3));
-    auto scaleshift = reinterpret_cast<const data_t *>(this->input_memory(4));
+    auto scaleshift = reinterpret_cast<const acc_data_t *>(
+            this->input_memory(4));
     auto ws = reinterpret_cast<const uint8_t *>(
             this->input_memory(conf_.ws_idx()));
 
     auto diff_src = reinterpret_cast<data_t*>(this->memory(0));
-    auto diff_scaleshift = reinterpret_cast<data_t *>(this->memory(1));
+    auto diff_scaleshift = reinterpret_cast<acc_data_t *>(this->memory(1));
 
     const memory_desc_wrapper data_d(conf_.src_pd());
     const memory_desc_wrapper diff_data_d(conf_.diff_src_pd());
@@ -207,12 +208,14 @@ void ref_batch_normalization_bwd_t<data_type>::execute_backward() {
 
     OMP(parallel for schedule(static))//;
     for (int c = 0; c < C; ++c) {
-        data_t v_mean = mean[mean_d.off(c)];
-        data_t v_variance = variance[variance_d.off(c)];
-        data_t sqrt_variance = static_cast<data_t>(1.0f / sqrtf(v_variance + eps));
-        data_t gamma = use_scaleshift ? scaleshift[scaleshift_d.off(0, c)] : 1;
-        data_t diff_gamma = data_t(0);
-        data_t diff_beta = data_t(0);
+        acc_data_t v_mean = mean[mean_d.off(c)];
+        acc_data_t v_variance = variance[variance_d.off(c)];
+        acc_data_t sqrt_variance
+            = static_cast<acc_data_t>(1.0f / sqrtf(v_variance + eps));
+        acc_data_t gamma
+            = use_scaleshift ? scaleshift[scaleshift_d.off(0, c)] : 1;
+        acc_data_t diff_gamma = acc_data_t(0);
+        acc_data_t diff_beta = acc_data_t(0);
         diff_gamma = 0.0;
         diff_beta = 0.0;
 
@@ -221,7 +224,7 @@ void ref_batch_normalization_bwd_t<data_type>::execute_backward() {
         for (int h = 0; h < H; ++h)
         for (int w = 0; w < W; ++w) {
             const size_t s_off = data_offset(data_d, n, c, d, h, w);
-            data_t dd = diff_dst[data_offset(diff_data_d, n, c, d, h, w)];
+            acc_data_t dd = diff_dst[data_offset(diff_data_d, n, c, d, h, w)];
             if (fuse_bn_relu && !ws[s_off])
                 dd = 0;
 
@@ -241,11 +244,11 @@ void ref_batch_normalization_bwd_t<data_type>::execute_backward() {
         for (int w = 0; w < W; ++w) {
             const size_t s_off = data_offset(data_d, n, c, d, h, w);
             const size_t dd_off = data_offset(diff_data_d, n, c, d, h, w);
-            data_t dd = diff_dst[dd_off];
+            acc_data_t dd = diff_dst[dd_off];
             if (fuse_bn_relu && !ws[s_off])
                 dd = 0;
 
-            data_t v_diff_src = dd;
+            acc_data_t v_diff_src = dd;
             if (calculate_diff_stats) {
                 v_diff_src -= diff_beta/(D*W*H*N) +
                     (src[s_off] - v_mean) *
@@ -258,6 +261,7 @@ void ref_batch_normalization_bwd_t<data_type>::execute_backward() {
 }
 
 template struct ref_batch_normalization_bwd_t<data_type::f32>;
+template struct ref_batch_normalization_bwd_t<data_type::bf16>;
 
 }
 }
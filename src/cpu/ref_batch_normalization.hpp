@@ -29,6 +29,7 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
+/* data may be bf16; statistics, scale and shift are always f32 */
 template <impl::data_type_t data_type>
 struct ref_batch_normalization_fwd_t: public cpu_primitive_t {
     struct pd_t: public cpu_batch_normalization_fwd_pd_t {
@@ -46,16 +47,16 @@ struct ref_batch_normalization_fwd_t: public cpu_primitive_t {
             bool ok = true
                 && utils::one_of(desc()->prop_kind, forward_training,
                         forward_inference)
-                && utils::everyone_is(data_type, desc()->data_desc.data_type,
-                        desc()->data_scaleshift_desc.data_type)
+                && desc()->data_desc.data_type == data_type
+                && desc()->data_scaleshift_desc.data_type == impl::data_type::f32
                 && (attr()->has_default_values() || this->with_relu_post_op());
             if (!ok) return status::unimplemented;
 
             if (stats_is_src() || is_training()) {
                 memory_desc_t stats_d;
                 dims_t stats_dims = { C() };
-                mkldnn_memory_desc_init(&stats_d, 1, stats_dims, data_type,
-                        memory_format::x);
+                mkldnn_memory_desc_init(&stats_d, 1, stats_dims,
+                        impl::data_type::f32, memory_format::x);
                 mean_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
                 variance_pd_ = cpu_memory_t::pd_t(engine_, &stats_d);
             }
@@ -71,6 +72,7 @@ struct ref_batch_normalization_fwd_t: public cpu_primitive_t {
             const output_vector &outputs)
         : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {}
     typedef typename prec_traits<data_type>::type data_t;
+    typedef typename prec_traits<impl::data_type::f32>::type acc_data_t;
 
     virtual void execute(event_t *e) {
         execute_forward();
@@ -99,9 +101,8 @@ struct ref_batch_normalization_bwd_t: public cpu_primitive_t {
             bool ok = true
                 && utils::one_of(desc()->prop_kind, backward, backward_data)
                 && utils::everyone_is(data_type, desc()->data_desc.data_type,
-                        desc()->diff_data_desc.data_type,
-                        desc()->data_desc.data_type,
-                        desc()->data_scaleshift_desc.data_type)
+                        desc()->diff_data_desc.data_type)
+                && desc()->data_scaleshift_desc.data_type == impl::data_type::f32
                 && attr()->has_default_values()
                 && hint_fwd_pd_ != nullptr;
             if (!ok) return status::unimplemented;
@@ -122,10 +123,12 @@ struct ref_batch_normalization_bwd_t: public cpu_primitive_t {
             bool stats_ok = true
                 && hint_fwd_pd_->mean_pd()->desc()->ndims == 1
                 && hint_fwd_pd_->mean_pd()->desc()->format == memory_format::x
-                && hint_fwd_pd_->mean_pd()->desc()->data_type == data_type
+                && hint_fwd_pd_->mean_pd()->desc()->data_type
+                        == impl::data_type::f32
                 && hint_fwd_pd_->variance_pd()->desc()->ndims == 1
                 && hint_fwd_pd_->variance_pd()->desc()->format == memory_format::x
-                && hint_fwd_pd_->variance_pd()->desc()->data_type == data_type;
+                && hint_fwd_pd_->variance_pd()->desc()->data_type
+                        == impl::data_type::f32;
             if (!stats_ok) return status::unimplemented;
 
             return status::success;
@@ -136,6 +139,7 @@ struct ref_batch_normalization_bwd_t: public cpu_primitive_t {
             const output_vector &outputs)
         : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {}
     typedef typename prec_traits<data_type>::type data_t;
+    typedef typename prec_traits<impl::data_type::f32>::type acc_data_t;
 
     virtual void execute(event_t *e) {
         execute_backward();
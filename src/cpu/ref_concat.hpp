@@ -75,6 +75,8 @@ struct ref_concat_t: public cpu_primitive_t {
                 printf("mkldnn_verbose,create,%s,%g\n", this->info(), ms);
                 fflush(0);
             }
+            if (profiling_enabled())
+                profiling_record(mkldnn_profiling_create, this, ms);
             return ret;
         }
         virtual pd_t *clone() const override { return nullptr; }
@@ -118,6 +120,7 @@ struct ref_concat_t: public cpu_primitive_t {
 
     virtual void execute(event_t *e) {
         for (size_t i = 0; i < reorders_.size(); ++i) {
+            if (conf_.src_is_dst_image(this, (int)i)) continue;
             event_t ei;
             reorders_[i]->execute(&ei);
         }
@@ -16,6 +16,8 @@
 
 #include "ref_convolution.hpp"
 #include "mkldnn_thread.hpp"
+#include "offset_calc.hpp"
+#include "idiv.hpp"
 #include "mkldnn_traits.hpp"
 #include "math_utils.hpp"
 
@@ -156,10 +158,10 @@ void _ref_convolution_fwd_t<with_relu, src_type, wei_type, dst_type, acc_type>
     auto bias = reinterpret_cast<const char *>(this->input_memory(2));
     auto dst = reinterpret_cast<dst_data_t *>(this->memory());
 
-    const memory_desc_wrapper src_d(conf_.src_pd());
-    const memory_desc_wrapper dst_d(conf_.dst_pd());
-    const memory_desc_wrapper weights_d(conf_.weights_pd(0));
-    const memory_desc_wrapper bias_d(conf_.weights_pd(1));
+    const offset_calc_t src_d(conf_.src_pd());
+    const offset_calc_t dst_d(conf_.dst_pd());
+    const offset_calc_t weights_d(conf_.weights_pd(0));
+    const offset_calc_t bias_d(conf_.weights_pd(1));
 
     const bool with_groups = conf_.with_groups();
 
@@ -194,20 +196,20 @@ void _ref_convolution_fwd_t<with_relu, src_type, wei_type, dst_type, acc_type>
 
     const int ndims = conf_.cdesc()->src_desc.ndims;
 
-    auto ker = [=](acc_data_t &d, int g, int mb, int oc, int od, int oh,
+    const window_taps_t taps_d(OD, ID, KD, KSD, padFront, 1 + KDD);
+    const window_taps_t taps_h(OH, IH, KH, KSH, padT, 1 + KDH);
+    const window_taps_t taps_w(OW, IW, KW, KSW, padL, 1 + KDW);
+
+    auto ker = [&](acc_data_t &d, int g, int mb, int oc, int od, int oh,
             int ow) {
         for (int ic = 0; ic < IC; ++ic) {
-            for (int kd = 0; kd < KD; ++kd)
-            for (int kh = 0; kh < KH; ++kh)
-            for (int kw = 0; kw < KW; ++kw) {
+            for (int kd = taps_d.k_beg(od); kd < taps_d.k_end(od); ++kd)
+            for (int kh = taps_h.k_beg(oh); kh < taps_h.k_end(oh); ++kh)
+            for (int kw = taps_w.k_beg(ow); kw < taps_w.k_end(ow); ++kw) {
                 const int id = od * KSD - padFront + kd * (1 + KDD);
                 const int ih = oh * KSH - padT + kh * (1 + KDH);
                 const int iw = ow * KSW - padL + kw * (1 + KDW);
 
-                if (id < 0 || id >= ID) continue;
-                if (ih < 0 || ih >= IH) continue;
-                if (iw < 0 || iw >= IW) continue;
-
                 if (ndims == 5)
                 d += (acc_data_t)src[src_d.off(mb, g*IC + ic, id, ih, iw)]
                     * (with_groups
@@ -282,10 +284,10 @@ void ref_convolution_bwd_data_t<diff_src_type, wei_type, diff_dst_type,
     auto bias = reinterpret_cast<const char *>(this->input_memory(2));
     auto diff_src = reinterpret_cast<diff_src_data_t*>(this->memory());
 
-    const memory_desc_wrapper diff_dst_d(conf_.diff_dst_pd());
-    const memory_desc_wrapper diff_src_d(conf_.diff_src_pd());
-    const memory_desc_wrapper weights_d(conf_.weights_pd(0));
-    const memory_desc_wrapper bias_d(conf_.weights_pd(1));
+    const offset_calc_t diff_dst_d(conf_.diff_dst_pd());
+    const offset_calc_t diff_src_d(conf_.diff_src_pd());
+    const offset_calc_t weights_d(conf_.weights_pd(0));
+    const offset_calc_t bias_d(conf_.weights_pd(1));
 
     const bool with_groups = conf_.with_groups();
 
@@ -318,39 +320,37 @@ void ref_convolution_bwd_data_t<diff_src_type, wei_type, diff_dst_type,
 
     const int ndims = conf_.cdesc()->diff_src_desc.ndims;
 
-    auto ker = [=](acc_data_t &d, int g, int mb, int ic, int id, int ih,
+    /* the taps reaching (id, ih, iw) and the outputs they come from; no
+     * divisibility test on the strides per tap */
+    const window_taps_t taps_d(OD, ID, KD, KSD, padFront, 1 + KDD);
+    const window_taps_t taps_h(OH, IH, KH, KSH, padT, 1 + KDH);
+    const window_taps_t taps_w(OW, IW, KW, KSW, padL, 1 + KDW);
+
+    auto ker = [&](acc_data_t &d, int g, int mb, int ic, int id, int ih,
             int iw) {
         for (int oc = 0; oc < OC; ++oc) {
-            for (int kd = 0; kd < KD; ++kd) {
-                for (int kh = 0; kh < KH; ++kh) {
-                    for (int kw = 0; kw < KW; ++kw) {
-                        if (iw + padL < kw * (1 + KDW)
-                            || ih + padT < kh * (1 + KDH)
-                            || id + padFront < kd * (1 + KDD))
-                            continue;
-                        int ow = iw - kw * (1 + KDW) + padL;
-                        int oh = ih - kh * (1 + KDH) + padT;
-                        int od = id - kd * (1 + KDD) + padFront;
-                        if (ow % KSW != 0 || oh % KSH != 0 || od % KSD != 0 )
-                            continue;
-
-                        ow /= KSW;
-                        oh /= KSH;
-                        od /= KSD;
-
-                        if (od < OD && oh < OH && ow < OW) {
-                            if (ndims == 5)
-                            d += (acc_data_t)diff_dst[diff_dst_d.off(mb, g*OC
-                                + oc, od, oh, ow)] * (with_groups
-                                ? weights[weights_d.off(g, oc, ic, kd, kh, kw)]
-                                : weights[weights_d.off(oc, ic, kd, kh, kw)]);
-                            else
-                            d += (acc_data_t)diff_dst[diff_dst_d.off(mb, g*OC
-                                + oc, oh, ow)] * (with_groups
-                                ? weights[weights_d.off(g, oc, ic, kh, kw)]
-                                : weights[weights_d.off(oc, ic, kh, kw)]);
+            for (int td = 0; td < taps_d.bn(id); ++td) {
+                const int kd = taps_d.bk_beg(id) + td * taps_d.bk_step();
+                const int od = taps_d.bo_beg(id) - td * taps_d.bo_step();
+                for (int th = 0; th < taps_h.bn(ih); ++th) {
+                    const int kh = taps_h.bk_beg(ih) + th * taps_h.bk_step();
+                    const int oh = taps_h.bo_beg(ih) - th * taps_h.bo_step();
+                    for (int tw = 0; tw < taps_w.bn(iw); ++tw) {
+                        const int kw = taps_w.bk_beg(iw)
+                            + tw * taps_w.bk_step();
+                        const int ow = taps_w.bo_beg(iw)
+                            - tw * taps_w.bo_step();
 
-                        }
+                        if (ndims == 5)
+                        d += (acc_data_t)diff_dst[diff_dst_d.off(mb, g*OC
+                            + oc, od, oh, ow)] * (with_groups
+                            ? weights[weights_d.off(g, oc, ic, kd, kh, kw)]
+                            : weights[weights_d.off(oc, ic, kd, kh, kw)]);
+                        else
+                        d += (acc_data_t)diff_dst[diff_dst_d.off(mb, g*OC
+                            + oc, oh, ow)] * (with_groups
+                            ? weights[weights_d.off(g, oc, ic, kh, kw)]
+                            : weights[weights_d.off(oc, ic, kh, kw)]);
                     }
                 }
             }
@@ -409,10 +409,10 @@ void ref_convolution_bwd_weights_t<src_type, diff_wei_type, diff_dst_type,
     auto diff_weights = reinterpret_cast<diff_wei_data_t*>(this->memory(0));
     auto diff_bias = reinterpret_cast<diff_wei_data_t *>(this->memory(1));
 
-    const memory_desc_wrapper src_d(conf_.src_pd());
-    const memory_desc_wrapper diff_dst_d(conf_.diff_dst_pd());
-    const memory_desc_wrapper diff_weights_d(conf_.diff_weights_pd(0));
-    const memory_desc_wrapper diff_bias_d(conf_.diff_weights_pd(1));
+    const offset_calc_t src_d(conf_.src_pd());
+    const offset_calc_t diff_dst_d(conf_.diff_dst_pd());
+    const offset_calc_t diff_weights_d(conf_.diff_weights_pd(0));
+    const offset_calc_t diff_bias_d(conf_.diff_weights_pd(1));
 
     const bool with_groups = conf_.with_groups();
 
@@ -445,19 +445,16 @@ void ref_convolution_bwd_weights_t<src_type, diff_wei_type, diff_dst_type,
 
     const int ndims = conf_.cdesc()->src_desc.ndims;
 
-    auto ker = [=](acc_data_t &d, int g, int oc, int ic, int kd, int kh, int kw) {
-        for (int mb = 0; mb < MB; ++mb) {
-            for (int od = 0; od < OD; ++od) {
-                for (int oh = 0; oh < OH; ++oh) {
-                    for (int ow = 0; ow < OW; ++ow) {
-                        if (ow*KSW + kw * (1 + KDW) < padL
-                            || oh*KSH + kh * (1 + KDH) < padT
-                            || od*KSD + kd * (1 + KDD) < padFront
-                            || ow*KSW + kw * (1 + KDW) >= IW + padL
-                            || oh*KSH + kh * (1 + KDH) >= IH + padT
-                            || od*KSD + kd * (1 + KDD) >= ID + padFront)
-                            continue;
+    const window_taps_t taps_d(OD, ID, KD, KSD, padFront, 1 + KDD);
+    const window_taps_t taps_h(OH, IH, KH, KSH, padT, 1 + KDH);
+    const window_taps_t taps_w(OW, IW, KW, KSW, padL, 1 + KDW);
 
+    auto ker = [&](acc_data_t &d, int g, int oc, int ic, int kd, int kh, int kw) {
+        for (int mb = 0; mb < MB; ++mb) {
+            for (int od = taps_d.o_beg(kd); od < taps_d.o_end(kd); ++od) {
+                for (int oh = taps_h.o_beg(kh); oh < taps_h.o_end(kh); ++oh) {
+                    for (int ow = taps_w.o_beg(kw); ow < taps_w.o_end(kw);
+                            ++ow) {
                         int id = od*KSD - padFront + kd * (1 + KDD);
                         int ih = oh*KSH - padT + kh * (1 + KDH);
                         int iw = ow*KSW - padL + kw * (1 + KDW);
@@ -554,6 +551,9 @@ template struct _ref_convolution_fwd_t<true, u8, s8, s8, s32>;
 template struct _ref_convolution_fwd_t<false, u8, s8, u8, s32>;
 template struct _ref_convolution_fwd_t<true, u8, s8, u8, s32>;
 
+template struct _ref_convolution_fwd_t<false, bf16, bf16, f32, f32>;
+template struct _ref_convolution_fwd_t<false, bf16, bf16, bf16, f32>;
+
 template struct ref_convolution_bwd_data_t<f32, f32, f32, f32>;
 template struct ref_convolution_bwd_data_t<s32, s16, s16, s32>;
 
@@ -562,9 +562,15 @@ template struct ref_convolution_bwd_data_t<s32, s8, u8, s32>;
 template struct ref_convolution_bwd_data_t<s8, s8, u8, s32>;
 template struct ref_convolution_bwd_data_t<u8, s8, u8, s32>;
 
+template struct ref_convolution_bwd_data_t<f32, bf16, bf16, f32>;
+template struct ref_convolution_bwd_data_t<bf16, bf16, bf16, f32>;
+
 template struct ref_convolution_bwd_weights_t<f32, f32, f32, f32>;
 template struct ref_convolution_bwd_weights_t<s16, s32, s16, s32>;
 
+template struct ref_convolution_bwd_weights_t<bf16, f32, bf16, f32>;
+template struct ref_convolution_bwd_weights_t<bf16, bf16, bf16, f32>;
+
 }
 }
 }
@@ -66,13 +66,16 @@ struct _ref_convolution_fwd_t: public cpu_primitive_t {
             AND_(this->cdesc_().alg_kind == alg_kind::convolution_direct);
             AND_(this->cdesc_().src_desc.data_type == src_type);
             AND_(this->cdesc_().weights_desc.data_type == wei_type);
+            AND_(this->cdesc_().weights_desc.format
+                    != memory_format::bcsr_fmt);
             AND_(this->cdesc_().accum_data_type == acc_type);
             AND_(this->cdesc_().dst_desc.data_type == dst_type);
             AND_(utils::implication(this->with_bias(), true
                         && utils::implication(src_type == u8,
                             utils::one_of(this->cdesc_().bias_desc.data_type,
                                 f32, s32, s8, u8))
-                        && utils::implication(src_type == f32,
+                        && utils::implication(utils::one_of(src_type, f32,
+                                bf16),
                             this->cdesc_().bias_desc.data_type == f32)));
             AND_(this->attr()->has_default_values());
 #undef AND_
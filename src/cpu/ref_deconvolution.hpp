@@ -54,6 +54,8 @@
                         printf("mkldnn_verbose,create,%s,%g\n", this->info(), ms); \
                         fflush(0); \
                     } \
+        if (profiling_enabled()) \
+            profiling_record(mkldnn_profiling_create, this, ms); \
         return ret; \
     } \
 virtual const char *name() const override { return impl_name; }
@@ -20,6 +20,7 @@
 #include "type_helpers.hpp"
 #include "math_utils.hpp"
 #include "mkldnn_thread.hpp"
+#include "offset_calc.hpp"
 
 #include "ref_eltwise.hpp"
 
@@ -48,7 +49,7 @@ void ref_eltwise_fwd_t<data_type>::execute_forward_nCspBc_padded() {
     const float alpha = conf_.desc()->alpha;
     const float beta = conf_.desc()->beta;
 
-    auto ker = [=] (data_t &d, data_t s) {
+    auto ker = [=] (data_t &d, compute_t s) {
         switch (alg_kind) {
             case eltwise_linear: d = linear_fwd(s, alpha, beta); break;
             case eltwise_bounded_relu:
@@ -82,7 +83,7 @@ void ref_eltwise_fwd_t<data_type>::execute_forward_generic() {
     /* fast return */
     if (conf_.has_zero_dim_memory()) return;
 
-    const memory_desc_wrapper data_d(conf_.src_pd());
+    const offset_calc_t data_d(conf_.src_pd());
 
     const int MB = conf_.MB();
     const int C = conf_.C();
@@ -104,7 +105,7 @@ void ref_eltwise_fwd_t<data_type>::execute_forward_generic() {
             for (int w = 0; w < W; ++w) {
                 auto d_off = is_3d
                     ? data_d.off(n, c, id, h, w) : data_d.off(n, c, h, w);
-                data_t s = src[d_off];
+                compute_t s = src[d_off];
                 data_t &d = dst[d_off];
                 switch (alg_kind) {
                 case eltwise_relu: d = relu_fwd(s, alpha); break;
@@ -128,7 +129,7 @@ void ref_eltwise_fwd_t<data_type>::execute_forward_generic() {
         [&](int n, int c, int id, int h, int w) {
         auto d_off = is_3d
             ? data_d.off(n, c, id, h, w) : data_d.off(n, c, h, w);
-        data_t s = src[d_off];
+        compute_t s = src[d_off];
         data_t &d = dst[d_off];
         switch (alg_kind) {
             case eltwise_relu: d = relu_fwd(s, alpha); break;
@@ -174,7 +175,7 @@ void ref_eltwise_fwd_t<data_type>::execute_forward_dense() {
     OMP(parallel for schedule(static))//;
     for (ptrdiff_t e = 0; e < nelems; ++e) {
     //for (size_t e = 0; e < nelems; ++e) {
-        const data_t s = src[e];
+        const compute_t s = src[e];
         data_t &d = dst[e];
 
         switch (alg_kind) {
@@ -201,8 +202,8 @@ void ref_eltwise_bwd_t<data_type>::execute_backward_generic() {
     /* fast return */
     if (conf_.has_zero_dim_memory()) return;
 
-    const memory_desc_wrapper data_d(conf_.src_pd());
-    const memory_desc_wrapper diff_data_d(conf_.diff_src_pd());
+    const offset_calc_t data_d(conf_.src_pd());
+    const offset_calc_t diff_data_d(conf_.diff_src_pd());
 
     const int MB = conf_.MB();
     const int C = conf_.C();
@@ -226,8 +227,8 @@ void ref_eltwise_bwd_t<data_type>::execute_backward_generic() {
                 auto diff_data_off = is_3d
                     ? diff_data_d.off(n, c, d, h, w)
                     : diff_data_d.off(n, c, h, w);
-                data_t s = src[data_off];
-                data_t dd = diff_dst[diff_data_off];
+                compute_t s = src[data_off];
+                compute_t dd = diff_dst[diff_data_off];
                 data_t &ds = diff_src[diff_data_off];
                 switch (alg_kind) {
                 case eltwise_relu: ds = relu_bwd(dd, s, alpha); break;
@@ -255,8 +256,8 @@ void ref_eltwise_bwd_t<data_type>::execute_backward_generic() {
         auto diff_data_off = is_3d
             ? diff_data_d.off(n, c, d, h, w)
             : diff_data_d.off(n, c, h, w);
-        data_t s = src[data_off];
-        data_t dd = diff_dst[diff_data_off];
+        compute_t s = src[data_off];
+        compute_t dd = diff_dst[diff_data_off];
         data_t &ds = diff_src[diff_data_off];
         switch (alg_kind) {
             case eltwise_relu: ds = relu_bwd(dd, s, alpha); break;
@@ -298,8 +299,8 @@ void ref_eltwise_bwd_t<data_type>::execute_backward_dense() {
     OMP(parallel for schedule(static))//;
     for (ptrdiff_t e = 0; e < nelems; ++e) {
     //for (size_t e = 0; e < nelems; ++e) {
-        const data_t dd = diff_dst[e];
-        const data_t s = src[e];
+        const compute_t dd = diff_dst[e];
+        const compute_t s = src[e];
         data_t &ds = diff_src[e];
 
         switch (alg_kind) {
@@ -323,10 +324,12 @@ template struct ref_eltwise_fwd_t<data_type::s32>;
 template struct ref_eltwise_fwd_t<data_type::s16>;
 template struct ref_eltwise_fwd_t<data_type::s8>;
 template struct ref_eltwise_fwd_t<data_type::u8>;
+template struct ref_eltwise_fwd_t<data_type::bf16>;
 
 template struct ref_eltwise_bwd_t<data_type::f32>;
 template struct ref_eltwise_bwd_t<data_type::s32>;
 template struct ref_eltwise_bwd_t<data_type::s16>;
+template struct ref_eltwise_bwd_t<data_type::bf16>;
 
 }
 }
@@ -81,6 +81,9 @@ struct ref_eltwise_fwd_t: public cpu_primitive_t {
             const output_vector &outputs)
         : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {}
     typedef typename prec_traits<data_type>::type data_t;
+    /* bf16 is a storage type: the math is done in f32 */
+    typedef typename utils::conditional<data_type == impl::data_type::bf16,
+            float, data_t>::type compute_t;
 
     virtual void execute(event_t *e) {
         if (conf_.use_dense_)
@@ -150,6 +153,9 @@ struct ref_eltwise_bwd_t: public cpu_primitive_t {
             const output_vector &outputs)
         : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {}
     typedef typename prec_traits<data_type>::type data_t;
+    /* bf16 is a storage type: the math is done in f32 */
+    typedef typename utils::conditional<data_type == impl::data_type::bf16,
+            float, data_t>::type compute_t;
 
     virtual void execute(event_t *e) {
         if (conf_.use_dense_) execute_backward_dense();
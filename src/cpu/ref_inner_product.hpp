@@ -55,6 +55,7 @@ struct ref_inner_product_fwd_t: public cpu_primitive_t {
                     forward_inference));
                 AND_(desc()->src_desc.data_type == src_type);
                 AND_(desc()->weights_desc.data_type == wei_type);
+                AND_(desc()->weights_desc.format != memory_format::bcsr_fmt);
                 AND_(desc()->accum_data_type == acc_type);
                 AND_(desc()->dst_desc.data_type == dst_type);
                 AND_(utils::implication(with_bias(),
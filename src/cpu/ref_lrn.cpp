@@ -19,6 +19,7 @@
 
 #include "c_types_map.hpp"
 #include "mkldnn_thread.hpp"
+#include "offset_calc.hpp"
 #include "type_helpers.hpp"
 
 #include "ref_lrn.hpp"
@@ -48,7 +49,7 @@ void ref_lrn_fwd_t<data_type>::execute_forward() {
     auto dst = reinterpret_cast<data_t*>(this->memory(0));
     auto ws = reinterpret_cast<data_t*>(this->memory(1));
 
-    const memory_desc_wrapper data_d(conf_.src_pd());
+    const offset_calc_t data_d(conf_.src_pd());
     const memory_desc_wrapper ws_d(conf_.workspace_pd());
     MAYBE_UNUSED(ws_d);
 
@@ -156,8 +157,8 @@ void ref_lrn_bwd_t<data_type>::execute_backward() {
     auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
     auto diff_src = reinterpret_cast<data_t*>(this->memory(0));
 
-    const memory_desc_wrapper data_d(conf_.src_pd());
-    const memory_desc_wrapper diff_data_d(conf_.diff_dst_pd());
+    const offset_calc_t data_d(conf_.src_pd());
+    const offset_calc_t diff_data_d(conf_.diff_dst_pd());
     MAYBE_UNUSED(diff_data_d);
 
     const int MB = conf_.MB();
@@ -20,6 +20,7 @@
 #include "c_types_map.hpp"
 #include "math_utils.hpp"
 #include "mkldnn_thread.hpp"
+#include "offset_calc.hpp"
 #include "nstl.hpp"
 #include "type_helpers.hpp"
 
@@ -41,9 +42,9 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward() {
     auto ws = alg == pooling_max && conf_.desc()->prop_kind == forward_training
         ? reinterpret_cast<unsigned char *>(this->memory(1)) : nullptr;
 
-    const memory_desc_wrapper src_d(conf_.src_pd());
-    const memory_desc_wrapper dst_d(conf_.dst_pd());
-    const memory_desc_wrapper ws_d(conf_.workspace_pd());
+    const offset_calc_t src_d(conf_.src_pd());
+    const offset_calc_t dst_d(conf_.dst_pd());
+    const offset_calc_t ws_d(conf_.workspace_pd());
     const data_type_t ws_dt = ws ? ws_d.data_type() : data_type::undef;
 
     const int ID = conf_.ID();
@@ -236,9 +237,9 @@ void ref_pooling_bwd_t<data_type, acc_type>::execute_backward() {
         : reinterpret_cast<const unsigned char *>(this->input_memory(1));
     auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
 
-    const memory_desc_wrapper diff_dst_d(conf_.diff_dst_pd());
-    const memory_desc_wrapper ws_d(conf_.workspace_pd());
-    const memory_desc_wrapper diff_src_d(conf_.diff_src_pd());
+    const offset_calc_t diff_dst_d(conf_.diff_dst_pd());
+    const offset_calc_t ws_d(conf_.workspace_pd());
+    const offset_calc_t diff_src_d(conf_.diff_src_pd());
 
     const int ID = conf_.ID();
     const int IH = conf_.IH();
@@ -443,10 +444,12 @@ template struct ref_pooling_fwd_t<data_type::s32>;
 template struct ref_pooling_fwd_t<data_type::s16, data_type::s32>;
 template struct ref_pooling_fwd_t<data_type::s8, data_type::s32>;
 template struct ref_pooling_fwd_t<data_type::u8, data_type::s32>;
+template struct ref_pooling_fwd_t<data_type::bf16, data_type::f32>;
 
 template struct ref_pooling_bwd_t<data_type::f32>;
 template struct ref_pooling_bwd_t<data_type::s32>;
 template struct ref_pooling_bwd_t<data_type::s16, data_type::s32>;
+template struct ref_pooling_bwd_t<data_type::bf16, data_type::f32>;
 
 }
 }
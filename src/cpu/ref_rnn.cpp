@@ -1102,23 +1102,24 @@ void _ref_rnn_common_t<aprop>::execute_() {
             reinterpret_cast<const float *>(this->input_memory(input_idx++));
 
     // if no workspace was provided we use the scratchpad
+    float *ws_gates, *ws_states, *ws_diff_states, *ws_grid, *ws_cell;
     if (use_scratchpad_for_ws_) {
-        ws_gates_ = ((float *)scratchpad_->get());
-        ws_states_ = ((float *)scratchpad_->get()) + ws_states_offset_;
-        ws_diff_states_
+        ws_gates = ((float *)scratchpad_->get());
+        ws_states = ((float *)scratchpad_->get()) + ws_states_offset_;
+        ws_diff_states
                 = ((float *)scratchpad_->get()) + ws_diff_states_offset_;
-        ws_grid_ = ((float *)scratchpad_->get()) + ws_grid_comp_offset_;
-        ws_cell_ = ((float *)scratchpad_->get()) + ws_cell_comp_offset_;
+        ws_grid = ((float *)scratchpad_->get()) + ws_grid_comp_offset_;
+        ws_cell = ((float *)scratchpad_->get()) + ws_cell_comp_offset_;
     } else {
         float *ws_ptr = is_fwd ?
                 reinterpret_cast<float *>(this->memory(output_idx++)) :
                 const_cast<float *>(reinterpret_cast<const float *>(
                         this->input_memory(input_idx++)));
-        ws_gates_ = ws_ptr + ws_gates_offset_;
-        ws_states_ = ws_ptr + ws_states_offset_;
-        ws_diff_states_ = ws_ptr + ws_diff_states_offset_;
-        ws_grid_ = ws_ptr + ws_grid_comp_offset_;
-        ws_cell_ = use_scratchpad_ ? ((float *)scratchpad_->get()) : nullptr;
+        ws_gates = ws_ptr + ws_gates_offset_;
+        ws_states = ws_ptr + ws_states_offset_;
+        ws_diff_states = ws_ptr + ws_diff_states_offset_;
+        ws_grid = ws_ptr + ws_grid_comp_offset_;
+        ws_cell = use_scratchpad_ ? ((float *)scratchpad_->get()) : nullptr;
     }
 
     auto diff_src_layer = is_fwd ?
@@ -1139,46 +1140,54 @@ void _ref_rnn_common_t<aprop>::execute_() {
 
     // initialize diff_states to 0
     if (aprop == prop_kind::backward)
-        array_set(ws_diff_states_, 0.0f, conf_.ws_diff_states_size());
+        array_set(ws_diff_states, 0.0f, conf_.ws_diff_states_size());
 
     // TODO: implement without copies
     bool is_lr = !one_of(exec_dir, b2t_r2l, t2b_r2l);
     bool is_rl = !one_of(exec_dir, b2t_l2r, t2b_l2r);
 
+    // the weights pointer tables are filled by every call, so they live on
+    // the call rather than on the primitive (see mkldnn_primitive_execute())
+    const int ptr_wei_sz = n_layer * n_direction * n_parts_wei_st;
+    nstl::vector<float *> wei_input_ptrs(ptr_wei_sz),
+        wei_state_ptrs(ptr_wei_sz);
+    float **ptr_wei_input = &wei_input_ptrs[0];
+    float **ptr_wei_state = &wei_state_ptrs[0];
+
     // we pack the weights if we are using the packed API
     (this->*weights_state_pack_func)(n_layer, n_direction, n_weights_state,
-            n_gates, batch, dic, sic, ptr_wei_state_, n_parts_wei_st,
+            n_gates, batch, dic, sic, ptr_wei_state, n_parts_wei_st,
             (is_orig_gru ? parts_wei_st_gru : &parts_wei_st), w_state);
     (this->*weights_input_pack_func)(n_layer, n_direction, n_weights_input,
-            n_gates, batch, dic, slc, ptr_wei_input_, n_parts_wei_i,
+            n_gates, batch, dic, slc, ptr_wei_input, n_parts_wei_i,
             &parts_wei_i, w_input);
 
     // we first need to copy the initial states and input into ws
     copy_init_layer(is_lr, is_rl, n_layer, n_direction, n_iter, batch, slc, dic,
-            dlc, wic, n_states, ws_states_, ws_diff_states_, input,
+            dlc, wic, n_states, ws_states, ws_diff_states, input,
             diff_dst_layer);
     copy_init_iter(n_layer, n_direction, n_states, batch, sic, dic, wic, n_iter,
-            ws_states_, ws_diff_states_, states, diff_dst_iter);
+            ws_states, ws_diff_states, states, diff_dst_iter);
 
     // run the execution on the grid
     (this->*grid_computation)(dic, slc, sic, wic, batch, n_layer, n_direction,
-            n_iter, n_gates, n_states, n_bias, ptr_wei_input_, n_parts_wei_i,
-            ptr_wei_state_, n_parts_wei_st, (float *)bias, ws_states_,
-            ws_diff_states_, ws_gates_, ws_cell_, ws_grid_, ws_per_cell,
+            n_iter, n_gates, n_states, n_bias, ptr_wei_input, n_parts_wei_i,
+            ptr_wei_state, n_parts_wei_st, (float *)bias, ws_states,
+            ws_diff_states, ws_gates, ws_cell, ws_grid, ws_per_cell,
             diff_weights_layer, diff_weights_iter, diff_bias);
 
     // Finally we copy the results to the result buffers
     copy_res_layer(is_lr, is_rl, n_layer, n_direction, n_iter, batch,
             n_output_features, slc, dic, wic, n_states, conf_.direction(),
-            dst_last_layer, diff_src_layer, ws_states_, ws_diff_states_);
+            dst_last_layer, diff_src_layer, ws_states, ws_diff_states);
     copy_res_iter(n_layer, n_direction, n_states, batch, sic, dic, wic, n_iter,
-            dst_last_iter, diff_src_iter, ws_states_, ws_diff_states_);
+            dst_last_iter, diff_src_iter, ws_states, ws_diff_states);
 
     // We free the packed weights if they were packed internally
     (this->*weights_state_free_packed_func)(n_layer, n_direction,
-            n_parts_wei_st, ptr_wei_state_);
+            n_parts_wei_st, ptr_wei_state);
     (this->*weights_input_free_packed_func)(n_layer, n_direction,
-            n_parts_wei_i, ptr_wei_input_);
+            n_parts_wei_i, ptr_wei_input);
 };
 
 template struct _ref_rnn_common_t<prop_kind::forward>;
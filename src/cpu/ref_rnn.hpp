@@ -293,17 +293,10 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
         if (use_scratchpad_)
             scratchpad_ =
                 create_scratchpad(conf_.get_scratchpad_size() * sizeof(float));
-
-        int max_nparts = (conf_.cell_kind() == alg_kind::vanilla_gru) ? 2 : 1;
-        int ptr_wei_sz = conf_.L() * conf_.D() * max_nparts;
-        ptr_wei_input_ = (float **)malloc(sizeof(float *) * ptr_wei_sz, 64);
-        ptr_wei_state_ = (float **)malloc(sizeof(float *) * ptr_wei_sz, 64);
     }
     ~_ref_rnn_common_t() {
         if (use_scratchpad_)
             delete scratchpad_;
-        free(ptr_wei_input_);
-        free(ptr_wei_state_);
     }
 
     // typedef typename prec_traits::type data_t;
@@ -362,16 +355,8 @@ private:
     size_t ws_grid_comp_offset_;
     size_t ws_cell_comp_offset_;
 
-    float *ws_gates_;
-    float *ws_states_;
-    float *ws_diff_states_;
-    float *ws_cell_;
-    float *ws_grid_;
     int n_output_features;
 
-    float **ptr_wei_input_;
-    float **ptr_wei_state_;
-
     execution_direction exec_dir;
     grid_execution_f grid_computation;
     cell_execution_f cell_func;
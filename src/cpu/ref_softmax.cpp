@@ -20,6 +20,7 @@
 
 #include "c_types_map.hpp"
 #include "type_helpers.hpp"
+#include "offset_calc.hpp"
 
 #include "ref_softmax.hpp"
 
@@ -56,30 +57,35 @@ void ref_softmax_fwd_t<data_type>::execute_forward_generic() {
     auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto dst = reinterpret_cast<data_t *>(this->memory(0));
 
-    const memory_desc_wrapper data_d(conf_.src_pd());
+    const offset_calc_t data_d(conf_.src_pd());
+
+    /* fast return */
+    if (data_d.has_zero_dim()) return;
+
     const size_t dim = channels_ * inner_size_;
+    const int axis = conf_.desc()->softmax_axis;
 
+    /* off_l() is only needed once per (ou, in): moving along the axis
+     * adds dim_off(axis, c) to the offset of c == 0 */
     for (int ou = 0; ou < outer_size_; ou++) {
         utils::array_set(max_, -FLT_MAX, inner_size_);
         utils::array_set(denom_, 0, inner_size_);
 
-        for (int c = 0; c < channels_; c++) {
-            for(int in = 0; in < inner_size_; in++) {
-                size_t off = data_d.off_l(ou * dim + c * inner_size_ + in);
+        for (int in = 0; in < inner_size_; in++) {
+            const size_t off_in = data_d.off_l(ou * dim + in);
+
+            for (int c = 0; c < channels_; c++) {
+                size_t off = off_in + data_d.dim_off(axis, c);
                 max_[in] = nstl::max(max_[in], src[off]);
             }
-        }
 
-        for (int c = 0; c < channels_; c++) {
-            for(int in = 0; in < inner_size_; in++) {
-                size_t off = data_d.off_l(ou * dim + c * inner_size_ + in);
+            for (int c = 0; c < channels_; c++) {
+                size_t off = off_in + data_d.dim_off(axis, c);
                 denom_[in] += dst[off] = exp(src[off] - max_[in]);
             }
-        }
 
-        for (int c = 0; c < channels_; c++) {
-            for (int in = 0; in < inner_size_; in++) {
-                size_t off = data_d.off_l(ou * dim + c * inner_size_ + in);
+            for (int c = 0; c < channels_; c++) {
+                size_t off = off_in + data_d.dim_off(axis, c);
                 dst[off] /= denom_[in];
             }
         }
@@ -170,22 +176,31 @@ void ref_softmax_bwd_t<data_type>::execute_backward_generic() {
     auto data = reinterpret_cast<const data_t *>(this->input_memory(0));
     auto diff_dst = reinterpret_cast<const data_t *>(this->input_memory(1));
     auto diff_src = reinterpret_cast<data_t *>(this->memory(0));
-    const memory_desc_wrapper diff_d(conf_.diff_src_pd());
-    const memory_desc_wrapper data_d(conf_.dst_pd());
+
+    const offset_calc_t diff_d(conf_.diff_src_pd());
+    const offset_calc_t data_d(conf_.dst_pd());
+
+    /* fast return */
+    if (data_d.has_zero_dim()) return;
+
+    const int axis = conf_.desc()->softmax_axis;
 
 #   pragma omp parallel for schedule(static)
     for (int ou = 0; ou < outer_size_; ou++) {
         for (int in = 0; in < inner_size_; in++) {
+            const size_t off_diff_in = diff_d.off_l(ou * dim + in);
+            const size_t off_data_in = data_d.off_l(ou * dim + in);
+
             data_t sbr = 0;
             for (int c = 0; c < channels_; c++) {
-                size_t off_diff = diff_d.off_l(ou * dim + c * inner_size_ + in);
-                size_t off_data = diff_d.off_l(ou * dim + c * inner_size_ + in);
+                size_t off_diff = off_diff_in + diff_d.dim_off(axis, c);
+                size_t off_data = off_diff_in + diff_d.dim_off(axis, c);
                 sbr += diff_dst[off_diff]*data[off_data];
             }
 
             for(int c=0; c < channels_ ; ++c) {
-              size_t off_diff = diff_d.off_l(ou * dim + c * inner_size_ + in);
-              size_t off_data = data_d.off_l(ou * dim + c * inner_size_ + in);
+              size_t off_diff = off_diff_in + diff_d.dim_off(axis, c);
+              size_t off_data = off_data_in + data_d.dim_off(axis, c);
               diff_src[off_diff] = data[off_data]*(diff_dst[off_diff] - sbr);
             }
         }
@@ -76,6 +76,8 @@ struct ref_sum_t: public cpu_primitive_t {
                 printf("mkldnn_verbose,create,%s,%g\n", this->info(), ms);
                 fflush(0);
             }
+            if (profiling_enabled())
+                profiling_record(mkldnn_profiling_create, this, ms);
             return ret;
         }
         virtual pd_t *clone() const override { return nullptr; /* FIXME */ }
@@ -14,6 +14,8 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <string.h>
+
 #include "mkldnn_thread.hpp"
 
 #include "simple_concat.hpp"
@@ -28,7 +30,7 @@ void simple_concat_t<data_type>::execute() {
     const data_t *input_ptrs[max_num_arrs];
     data_t *output_ptrs[max_num_arrs];
     size_t nelems_to_copy[max_num_arrs];
-    strides_t is[max_num_arrs];
+    strides_t is[max_num_arrs] = { { 0 } };
     int *perm = conf_.perm_, *iperm = conf_.iperm_;
     int concat_dim = conf_.concat_dim();
     auto o_base_ptr = reinterpret_cast<data_t *>(this->memory());
@@ -40,7 +42,9 @@ void simple_concat_t<data_type>::execute() {
         input_ptrs[a] = reinterpret_cast<const data_t *>(
                 this->input_memory(a)) + i_d.blk_off(0);
         output_ptrs[a] = o_base_ptr + o_d.blk_off(0);
-        nelems_to_copy[a] = nelems_to_concat(concat_dim, perm, iperm, i_d);
+        /* an input written in place by its producer needs no copy */
+        nelems_to_copy[a] = conf_.src_is_dst_image(this, a)
+            ? 0 : nelems_to_concat(concat_dim, perm, iperm, i_d);
         for (int i = 0; i < perm[concat_dim]; i++)
             is[a][i] = size_t(i_d.blocking_desc().strides[0][iperm[i]]);
     }
@@ -56,35 +60,65 @@ void simple_concat_t<data_type>::execute() {
                 o_d.dims()[iperm[i]] / blk.block_dims[iperm[i]] :
                 1;
 
-    //OMP(parallel for collapse(2) schedule(static))//;
-    //for (int n = 0; n < N; ++n) {
-    switch (perm[concat_dim]) {
-    case (0): {
-        for (int a = 0; a < num_arrs; ++a) {
-            const data_t *i = &input_ptrs[a][0];
-            data_t *o = &output_ptrs[a][0];
-            OMP(parallel for)
-            for (ptrdiff_t e = 0; e < (ptrdiff_t)nelems_to_copy[a]; ++e)
-                o[e] = i[e];
-        }
-        break;
-    }
-    default:
-        parallel_nd(phys_dims[0], phys_dims[1], phys_dims[2], phys_dims[3],
-            phys_dims[4], num_arrs,
-            [&](int n0, int n1, int n2, int n3, int n4, int a) {
-            size_t in_off = is[a][0] * n0 + is[a][1] * n1
-                    + is[a][2] * n2 + is[a][3] * n3
-                    + is[a][4] * n4;
-            size_t out_off = os[0] * n0 + os[1] * n1
+    /* The output is a sequence of `outer` rows (one per point of the physical
+     * dimensions above the concat dimension), each row being the
+     * concatenation of nelems_to_copy[a] contiguous elements of every input.
+     * The total amount of data is split evenly between the threads of a
+     * single parallel region, so that a thread may copy a part of an input,
+     * several inputs or several rows. */
+    size_t outer = 1;
+    for (int i = 0; i < perm[concat_dim]; i++)
+        outer *= phys_dims[i];
+    size_t row_off[max_num_arrs + 1] = { 0 };
+    for (int a = 0; a < num_arrs; ++a)
+        row_off[a + 1] = row_off[a] + nelems_to_copy[a];
+    const size_t row = row_off[num_arrs];
+    const size_t work_amount = outer * row;
+    if (work_amount == 0) return;
+
+    const int nthr = (int)nstl::min((size_t)omp_get_max_threads(),
+            utils::div_up(work_amount * sizeof(data_t), min_thr_bytes));
+
+    OMP(parallel num_threads(nthr))
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+        size_t start{0}, end{0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        size_t n = start / row, e = start % row;
+        int a = 0;
+        while (e >= row_off[a + 1]) ++a;
+        e -= row_off[a];
+        int n0{0}, n1{0}, n2{0}, n3{0}, n4{0};
+        utils::nd_iterator_init(n, n0, phys_dims[0], n1, phys_dims[1],
+                n2, phys_dims[2], n3, phys_dims[3], n4, phys_dims[4]);
+
+        for (size_t pos = start; pos < end;) {
+            const size_t len = nstl::min(nelems_to_copy[a] - e, end - pos);
+            const size_t in_off = is[a][0] * n0 + is[a][1] * n1
+                    + is[a][2] * n2 + is[a][3] * n3 + is[a][4] * n4;
+            const size_t out_off = os[0] * n0 + os[1] * n1
                     + os[2] * n2 + os[3] * n3 + os[4] * n4;
-            const data_t *i = &input_ptrs[a][in_off];
-            data_t *o = &output_ptrs[a][out_off];
+            const data_t *i = &input_ptrs[a][in_off + e];
+            data_t *o = &output_ptrs[a][out_off + e];
 
-            PRAGMA_OMP_SIMD()
-            for (size_t e = 0; e < nelems_to_copy[a]; ++e)
-                o[e] = i[e];
-        });
+            if (len * sizeof(data_t) >= memcpy_bytes) {
+                memcpy(o, i, len * sizeof(data_t));
+            } else {
+                PRAGMA_OMP_SIMD()
+                for (size_t k = 0; k < len; ++k)
+                    o[k] = i[k];
+            }
+
+            pos += len;
+            e = 0;
+            if (++a == num_arrs) {
+                a = 0;
+                utils::nd_iterator_step(n0, phys_dims[0], n1, phys_dims[1],
+                        n2, phys_dims[2], n3, phys_dims[3], n4, phys_dims[4]);
+            }
+        }
     }
 }
 template struct simple_concat_t<data_type::f32>;
@@ -62,7 +62,7 @@ struct simple_concat_t: public cpu_primitive_t {
                             o_d.data_type())
                     && i_d.format() == o_d.format()
                     && !utils::one_of(i_d.format(), memory_format::blocked,
-                        memory_format::wino_fmt);
+                        memory_format::wino_fmt, memory_format::bcsr_fmt);
             }
 
             if (!ok)
@@ -93,6 +93,9 @@ struct simple_concat_t: public cpu_primitive_t {
     }
 
     enum { max_num_arrs = 16 };
+    /* minimal amount of data per thread, and the size of a contiguous chunk
+     * from which memcpy() is used instead of an element-wise loop */
+    enum { min_thr_bytes = 32 * 1024, memcpy_bytes = 4 * 1024 };
     typedef typename prec_traits<data_type>::type data_t;
 
 private:
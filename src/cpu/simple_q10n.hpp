@@ -40,6 +40,12 @@ inline out_t round_and_saturate(float f, round_mode_t rmode) {
     return math::saturate<out_t>(f);
 }
 
+/* bf16 is a storage format for f32: no integer rounding, only the
+ * round-to-nearest-even truncation of the mantissa */
+template <>
+inline bfloat16_t round_and_saturate<bfloat16_t>(float f, round_mode_t rmode)
+{ UNUSED(rmode); return bfloat16_t(f); }
+
 /* Quantization with alpha == 1 and beta == 0 */
 template <typename in_t, typename out_t, typename enabled = void>
 struct qz_a1b0 {
@@ -2214,11 +2214,8 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
 
             i = scale * i + (beta ? beta * (float)o : 0);
             if (type_o != f32) {
-                switch (pd->attr()->round_mode_) {
-                case round_mode::down: i = floorf(i); break;
-                case round_mode::nearest: i = nearbyintf(i); break;
-                }
-                o = saturate<data_t<type_o>>(i);
+                o = round_and_saturate<data_t<type_o>>(i,
+                        pd->attr()->round_mode_);
             } else {
                 o = (data_t<type_o>)i;
             }
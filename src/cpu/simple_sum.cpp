@@ -15,14 +15,29 @@
 *******************************************************************************/
 
 #include "mkldnn_thread.hpp"
+#include "simple_q10n.hpp"
 #include "simple_sum.hpp"
 
 namespace mkldnn {
 namespace impl {
 namespace cpu {
 
+/* Every output tile is computed in a single pass: all the inputs are
+ * accumulated in f32 into a small buffer which is then converted (with
+ * saturation for integer types) and stored once. As an input is only read
+ * before the corresponding output is written, dst may share its memory with
+ * the first input (in-place accumulation). */
+
 template <data_type_t data_type>
 void simple_sum_t<data_type>::execute() {
+    if (conf_.same_dense_)
+        execute_dense();
+    else
+        execute_rows();
+}
+
+template <data_type_t data_type>
+void simple_sum_t<data_type>::execute_dense() {
     auto output = reinterpret_cast<data_t *>(this->memory());
     const int num_arrs = conf_.n_inputs();
     const memory_desc_wrapper o_d(conf_.dst_pd());
@@ -37,9 +52,8 @@ void simple_sum_t<data_type>::execute() {
                 this->input_memory(a)) + i_d.blk_off(0);
     }
 
-    const size_t block_size = 16 * 1024 / sizeof(data_type);
-    const size_t blocks_number = nelems / block_size;
-    const size_t tail = nelems % block_size;
+    const size_t block_size = 16 * 1024 / sizeof(acc_data_t);
+    const size_t blocks_number = utils::div_up(nelems, block_size);
 
     const auto &scales = conf_.scales_;
     OMP(parallel)//;
@@ -49,41 +63,109 @@ void simple_sum_t<data_type>::execute() {
         size_t start{0}, end{0};
         balance211(blocks_number, nthr, ithr, start, end);
 
+        acc_data_t acc[block_size];
         for (size_t nb = start; nb < end; ++nb) {
-            size_t start_e = nb * block_size;
-            size_t end_e = start_e + block_size;
+            const size_t start_e = nb * block_size;
+            const size_t len = nstl::min(block_size, nelems - start_e);
 
+            const data_t *i0 = &input_ptrs[0][start_e];
             PRAGMA_OMP_SIMD()
-            for (size_t e = start_e; e < end_e; e++) {
-                output[e] = data_t(scales[0] * input_ptrs[0][e]);
-            }
+            for (size_t e = 0; e < len; e++)
+                acc[e] = scales[0] * i0[e];
             for (int a = 1; a < num_arrs; a++) {
+                const data_t *i = &input_ptrs[a][start_e];
                 PRAGMA_OMP_SIMD()
-                for (size_t e = start_e; e < end_e; e++) {
-                    output[e] += data_t(scales[a] * input_ptrs[a][e]);
-                }
+                for (size_t e = 0; e < len; e++)
+                    acc[e] += scales[a] * i[e];
             }
+
+            data_t *o = &output[start_e];
+            PRAGMA_OMP_SIMD()
+            for (size_t e = 0; e < len; e++)
+                o[e] = qz_a1b0<acc_data_t, data_t>()(acc[e],
+                        round_mode::nearest);
         }
+    }
+}
 
-        if (tail != 0 && ithr == nthr - 1) {
-            size_t start_e = nelems - tail;
-            size_t end_e = nelems;
+template <data_type_t data_type>
+void simple_sum_t<data_type>::execute_rows() {
+    auto output = reinterpret_cast<data_t *>(this->memory());
+    const int num_arrs = conf_.n_inputs();
+    const memory_desc_wrapper o_d(conf_.dst_pd());
+    const int ndims = o_d.ndims();
+    const int last = ndims - 1;
+    const size_t nelems = o_d.nelems();
+    if (nelems == 0) return;
 
-            PRAGMA_OMP_SIMD()
-            for (size_t e = start_e; e < end_e; e++) {
-                output[e] = data_t(scales[0] * input_ptrs[0][e]);
+    const int W = o_d.dims()[last];
+    const size_t rows = nelems / W;
+    const ptrdiff_t o_str = o_d.blocking_desc().strides[0][last];
+
+    const data_t *input_ptrs[max_num_arrs];
+    ptrdiff_t i_str[max_num_arrs];
+    for (int a = 0; a < num_arrs; ++a) {
+        const memory_desc_wrapper i_d(conf_.src_pd(a));
+        input_ptrs[a] = reinterpret_cast<const data_t *>(
+                this->input_memory(a));
+        i_str[a] = i_d.blocking_desc().strides[0][last];
+    }
+
+    const int tile = 1024;
+
+    const auto &scales = conf_.scales_;
+    OMP(parallel)//;
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+        size_t start{0}, end{0};
+        balance211(rows, nthr, ithr, start, end);
+
+        acc_data_t acc[tile];
+        dims_t pos = {0};
+        for (size_t r = start; r < end; ++r) {
+            size_t rr = r;
+            for (int d = last - 1; d >= 0; --d) {
+                pos[d] = (int)(rr % o_d.dims()[d]);
+                rr /= o_d.dims()[d];
             }
-            for (int a = 1; a < num_arrs; a++) {
+
+            const data_t *in[max_num_arrs];
+            for (int a = 0; a < num_arrs; ++a)
+                in[a] = input_ptrs[a]
+                    + memory_desc_wrapper(conf_.src_pd(a)).off_v(pos);
+            data_t *out = output + o_d.off_v(pos);
+
+            for (int w0 = 0; w0 < W; w0 += tile) {
+                const int len = nstl::min(tile, W - w0);
+
+                const data_t *i0 = in[0] + w0 * i_str[0];
+                const ptrdiff_t is0 = i_str[0];
                 PRAGMA_OMP_SIMD()
-                for (size_t e = start_e; e < end_e; e++) {
-                    output[e] += data_t(scales[a] * input_ptrs[a][e]);
+                for (int w = 0; w < len; w++)
+                    acc[w] = scales[0] * i0[w * is0];
+                for (int a = 1; a < num_arrs; a++) {
+                    const data_t *i = in[a] + w0 * i_str[a];
+                    const ptrdiff_t is = i_str[a];
+                    PRAGMA_OMP_SIMD()
+                    for (int w = 0; w < len; w++)
+                        acc[w] += scales[a] * i[w * is];
                 }
+
+                data_t *o = out + w0 * o_str;
+                PRAGMA_OMP_SIMD()
+                for (int w = 0; w < len; w++)
+                    o[w * o_str] = qz_a1b0<acc_data_t, data_t>()(acc[w],
+                            round_mode::nearest);
             }
         }
     }
 }
 
 template struct simple_sum_t<data_type::f32>;
+template struct simple_sum_t<data_type::s32>;
+template struct simple_sum_t<data_type::s8>;
+template struct simple_sum_t<data_type::u8>;
 
 }
 }
@@ -43,19 +43,36 @@ struct simple_sum_t: public cpu_primitive_t {
             const memory_desc_wrapper o_d(&dst_pd_);
             ok = ok
                 && o_d.data_type() == data_type
-                && o_d.is_dense();
+                && o_d.is_blocking_desc()
+                && o_d.ndims() > 0;
 
+            same_dense_ = o_d.is_dense();
             const auto n = src_pds_.size();
             for (size_t i = 0; i < n; ++i) {
                 const memory_desc_wrapper i_d(&src_pds_[i]);
                 ok = ok
                     && utils::everyone_is(data_type, i_d.data_type())
+                    && i_d.is_blocking_desc();
+                same_dense_ = same_dense_
                     && i_d.format() == o_d.format()
                     && i_d.is_dense();
             }
+            if (!ok) return unimplemented;
+            if (same_dense_) return success;
+
+            /* otherwise the data is summed row by row along the innermost
+             * logical dimension, which must not be blocked */
+            const int last = o_d.ndims() - 1;
+            ok = o_d.blocking_desc().block_dims[last] == 1;
+            for (size_t i = 0; i < n; ++i) {
+                const memory_desc_wrapper i_d(&src_pds_[i]);
+                ok = ok && i_d.blocking_desc().block_dims[last] == 1;
+            }
 
             return ok ? success : unimplemented;
         }
+
+        bool same_dense_;
     };
 
     simple_sum_t(const pd_t *conf, const input_vector &inputs,
@@ -69,9 +86,12 @@ struct simple_sum_t: public cpu_primitive_t {
 
     enum {max_num_arrs = 16 };
     typedef typename prec_traits<data_type>::type data_t;
+    typedef float acc_data_t;
 
 private:
     void execute();
+    void execute_dense();
+    void execute_rows();
     pd_t conf_;
 };
 
@@ -0,0 +1,250 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "mkldnn_thread.hpp"
+#include "mkldnn_traits.hpp"
+
+#include "gemm/gemm.hpp"
+#include "idiv.hpp"
+#include "subpixel_deconvolution.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::utils;
+
+subpixel_deconvolution_fwd_t::phases_t::phases_t(int O, int I, int K, int S,
+        int P, int DD)
+    : o_beg(S), n_o(S), tap_beg(S + 1)
+{
+    tap_beg[0] = 0;
+    for (int p = 0; p < S; ++p) {
+        /* the first output with o + P = p (mod S) */
+        o_beg[p] = rem_floor(p - P, S);
+        n_o[p] = o_beg[p] < O ? div_up(O - o_beg[p], S) : 0;
+        for (int k = 0; k < K; ++k) {
+            if (rem_floor(k * DD, S) != p) continue;
+            tap.push_back(k);
+            /* exact: o_beg[p] + P - k * DD is a multiple of S */
+            shift.push_back((o_beg[p] + P - k * DD) / S);
+        }
+        tap_beg[p + 1] = (int)tap.size();
+    }
+}
+
+subpixel_deconvolution_fwd_t::subpixel_deconvolution_fwd_t(const pd_t *pd,
+        const input_vector &inputs, const output_vector &outputs)
+    : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd)
+    , ph_d_(conf_.OD(), conf_.ID(), conf_.KD(), conf_.KSD(), conf_.padFront(),
+            conf_.KDD() + 1)
+    , ph_h_(conf_.OH(), conf_.IH(), conf_.KH(), conf_.KSH(), conf_.padT(),
+            conf_.KDH() + 1)
+    , ph_w_(conf_.OW(), conf_.IW(), conf_.KW(), conf_.KSW(), conf_.padL(),
+            conf_.KDW() + 1)
+    , nthr_(1), col_size_(0), res_size_(0), scratchpad_(nullptr)
+{
+    const int G = conf_.G();
+    const int OC = conf_.OC() / G, IC = conf_.IC() / G;
+    const size_t KS = (size_t)conf_.KD() * conf_.KH() * conf_.KW();
+
+    wei_off_.push_back(0);
+    for (int pd = 0; pd < ph_d_.n(); ++pd)
+    for (int ph = 0; ph < ph_h_.n(); ++ph)
+    for (int pw = 0; pw < ph_w_.n(); ++pw) {
+        const size_t n_sp = (size_t)ph_d_.n_o[pd] * ph_h_.n_o[ph]
+            * ph_w_.n_o[pw];
+        const size_t k = (size_t)IC * ph_d_.n_taps(pd) * ph_h_.n_taps(ph)
+            * ph_w_.n_taps(pw);
+        col_size_ = nstl::max(col_size_, k * n_sp);
+        res_size_ = nstl::max(res_size_, (size_t)OC * n_sp);
+        wei_off_.push_back(wei_off_[wei_off_.size() - 1] + OC * k);
+    }
+
+    /* the phases of the images are independent gemms: with enough of them
+     * each thread runs its own, otherwise they run one after the other with
+     * a threaded gemm */
+    const int n_phases = ph_d_.n() * ph_h_.n() * ph_w_.n();
+    const int max_nthr = omp_get_max_threads();
+    if (conf_.MB() * G * n_phases >= max_nthr) nthr_ = max_nthr;
+
+    scratchpad_ = create_scratchpad(sizeof(data_t) * ((size_t)G * OC * IC * KS
+                + nthr_ * (col_size_ + res_size_)));
+}
+
+void subpixel_deconvolution_fwd_t::execute_forward() {
+    auto src = reinterpret_cast<const data_t *>(this->input_memory(0));
+    auto weights = reinterpret_cast<const data_t *>(this->input_memory(1));
+    auto bias = conf_.with_bias()
+        ? reinterpret_cast<const data_t *>(this->input_memory(2)) : nullptr;
+    auto dst = reinterpret_cast<data_t *>(this->memory());
+
+    const int G = conf_.G();
+    const int MB = conf_.MB();
+    const int OC = conf_.OC() / G;
+    const int IC = conf_.IC() / G;
+    const int OH = conf_.OH(), OW = conf_.OW();
+    const int ID = conf_.ID(), IH = conf_.IH(), IW = conf_.IW();
+    const int KH = conf_.KH(), KW = conf_.KW();
+    const int KSD = conf_.KSD(), KSH = conf_.KSH(), KSW = conf_.KSW();
+
+    const size_t src_c = (size_t)ID * IH * IW;
+    const size_t dst_c = (size_t)conf_.OD() * OH * OW;
+    const size_t KS = (size_t)conf_.KD() * KH * KW;
+    const size_t wei_g_size = (size_t)OC * IC * KS;
+
+    const int n_ph_h = ph_h_.n(), n_ph_w = ph_w_.n();
+    const int n_phases = ph_d_.n() * n_ph_h * n_ph_w;
+
+    data_t *scratch = (data_t *)scratchpad_->get();
+    data_t *wei_p = scratch;
+    data_t *col = wei_p + G * wei_g_size;
+    data_t *res = col + nthr_ * col_size_;
+
+    auto phase_taps = [&](int p, int &pd, int &ph, int &pw) {
+        pw = p % n_ph_w;
+        ph = (p / n_ph_w) % n_ph_h;
+        pd = p / (n_ph_w * n_ph_h);
+        return ph_d_.n_taps(pd) * ph_h_.n_taps(ph) * ph_w_.n_taps(pw);
+    };
+
+    parallel_nd(G, n_phases, OC, [&](int g, int p, int oc) {
+        int pd, ph, pw;
+        const int n_taps = phase_taps(p, pd, ph, pw);
+        data_t *w_p = wei_p + g * wei_g_size + wei_off_[p]
+            + (size_t)oc * IC * n_taps;
+        for (int ic = 0; ic < IC; ++ic) {
+            const data_t *w = weights + ((size_t)g * OC + oc) * IC * KS
+                + ic * KS;
+            for (int td = ph_d_.tap_beg[pd]; td < ph_d_.tap_beg[pd + 1]; ++td)
+            for (int th = ph_h_.tap_beg[ph]; th < ph_h_.tap_beg[ph + 1]; ++th)
+            for (int tw = ph_w_.tap_beg[pw]; tw < ph_w_.tap_beg[pw + 1]; ++tw)
+                *w_p++ = w[(ph_d_.tap[td] * KH + ph_h_.tap[th]) * KW
+                    + ph_w_.tap[tw]];
+        }
+    });
+
+    /* one phase of one image: im2col of the taps of the phase (row r holds
+     * the source of one (ic, tap) for all the outputs of the phase), a gemm
+     * into res (OC x n_sp) and the store of res into the strided outputs */
+    auto phase = [&](int mb, int g, int p, data_t *_col, data_t *_res,
+            bool threaded) {
+        int pd, ph, pw;
+        const int n_taps = phase_taps(p, pd, ph, pw);
+        const int nd = ph_d_.n_o[pd], nh = ph_h_.n_o[ph], nw = ph_w_.n_o[pw];
+        const int n_sp = nd * nh * nw;
+        if (n_sp == 0) return;
+        const int K = IC * n_taps;
+        const int taps_h = ph_h_.n_taps(ph), taps_w = ph_w_.n_taps(pw);
+
+        auto im2col_row = [&](int r) {
+            const int ic = r / n_taps;
+            const int td = ph_d_.tap_beg[pd] + r % n_taps / (taps_h * taps_w);
+            const int th = ph_h_.tap_beg[ph] + r % (taps_h * taps_w) / taps_w;
+            const int tw = ph_w_.tap_beg[pw] + r % taps_w;
+            const data_t *s = src + ((size_t)mb * G * IC + g * IC + ic)
+                * src_c;
+            const int sw = ph_w_.shift[tw];
+            const int jw_s = nstl::max(0, -sw);
+            const int jw_e = nstl::max(jw_s, nstl::min(nw, IW - sw));
+            data_t *c = _col + (size_t)r * n_sp;
+            for (int jd = 0; jd < nd; ++jd) {
+                const int id = jd + ph_d_.shift[td];
+                for (int jh = 0; jh < nh; ++jh, c += nw) {
+                    const int ih = jh + ph_h_.shift[th];
+                    if (id < 0 || id >= ID || ih < 0 || ih >= IH) {
+                        PRAGMA_OMP_SIMD()
+                        for (int jw = 0; jw < nw; ++jw) c[jw] = 0;
+                        continue;
+                    }
+                    const data_t *s_row = s + ((size_t)id * IH + ih) * IW + sw;
+                    for (int jw = 0; jw < jw_s; ++jw) c[jw] = 0;
+                    PRAGMA_OMP_SIMD()
+                    for (int jw = jw_s; jw < jw_e; ++jw) c[jw] = s_row[jw];
+                    for (int jw = jw_e; jw < nw; ++jw) c[jw] = 0;
+                }
+            }
+        };
+
+        auto store = [&](int oc) {
+            const data_t *r = _res + (size_t)oc * n_sp;
+            data_t *d = dst + ((size_t)mb * G * OC + g * OC + oc) * dst_c;
+            for (int jd = 0; jd < nd; ++jd) {
+                const int od = ph_d_.o_beg[pd] + jd * KSD;
+                for (int jh = 0; jh < nh; ++jh, r += nw) {
+                    const int oh = ph_h_.o_beg[ph] + jh * KSH;
+                    data_t *d_row = d + ((size_t)od * OH + oh) * OW
+                        + ph_w_.o_beg[pw];
+                    PRAGMA_OMP_SIMD()
+                    for (int jw = 0; jw < nw; ++jw) d_row[jw * KSW] = r[jw];
+                }
+            }
+        };
+
+        const data_t *b = bias ? bias + g * OC : nullptr;
+        if (K == 0) {
+            /* no tap reaches this phase: the outputs are the bias */
+            for (int oc = 0; oc < OC; ++oc)
+                for (int j = 0; j < n_sp; ++j)
+                    _res[(size_t)oc * n_sp + j] = b ? b[oc] : data_t(0);
+        } else {
+            OMP(parallel for if(threaded))//;
+            for (int r = 0; r < K; ++r) im2col_row(r);
+
+            const data_t one = 1.0, zero = 0.0;
+            extended_sgemm("N", "N", &n_sp, &OC, &K, &one, _col, &n_sp,
+                    wei_p + g * wei_g_size + wei_off_[p], &K, &zero,
+                    _res, &n_sp, gemm_epilogue_t(nullptr, b));
+        }
+
+        OMP(parallel for if(threaded))//;
+        for (int oc = 0; oc < OC; ++oc) store(oc);
+    };
+
+    const size_t work_amount = (size_t)MB * G * n_phases;
+    if (nthr_ == 1) {
+        for (int mb = 0; mb < MB; ++mb)
+        for (int g = 0; g < G; ++g)
+        for (int p = 0; p < n_phases; ++p)
+            phase(mb, g, p, col, res, true);
+        return;
+    }
+
+    OMP(parallel num_threads(nthr_))//;
+    {
+        const int ithr = omp_get_thread_num();
+        const int nthr = omp_get_num_threads();
+        data_t *_col = col + ithr * col_size_;
+        data_t *_res = res + ithr * res_size_;
+
+        size_t start = 0, end = 0;
+        int mb = 0, g = 0, p = 0;
+        balance211(work_amount, nthr, ithr, start, end);
+        nd_iterator_init(start, mb, MB, g, G, p, n_phases);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            phase(mb, g, p, _col, _res, false);
+            nd_iterator_step(mb, MB, g, G, p, n_phases);
+        }
+    }
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,146 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_SUBPIXEL_DECONVOLUTION_HPP
+#define CPU_SUBPIXEL_DECONVOLUTION_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "cpu_deconvolution_pd.hpp"
+#include "cpu_engine.hpp"
+#include "nstl.hpp"
+#include "scratchpad.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/** Strided deconvolution by sub-pixel (phase) decomposition.
+ *
+ * With stride S an output point o only receives the kernel taps k with
+ * k * DD = o + P (mod S), so the outputs of one phase (o + P mod S, per
+ * spatial dimension) are a dense stride-1 correlation of the source with the
+ * subset of the taps of that phase. Each of the S^ndims_sp phases is computed
+ * as an im2col of the source followed by one gemm with the packed taps of the
+ * phase (bias in the gemm epilogue), and its rows are stored once into the
+ * interleaved destination. Compared to the reference deconvolution (a gemm
+ * over all taps followed by a col2im scatter-add), there is no accumulation
+ * into the destination at all.
+ *
+ * Only 2D problems are taken: on the 3D ones measured the gemms of the
+ * phases are not faster than the reference deconvolution.
+ *
+ * Backward data of a deconvolution is a plain strided convolution, which
+ * ref_deconvolution already runs through the gemm convolution. */
+struct subpixel_deconvolution_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_deconvolution_fwd_pd_t {
+        pd_t(engine_t *engine,
+                const deconvolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const deconvolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_deconvolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+        {}
+
+        DECLARE_COMMON_PD_T("subpixel:gemm", subpixel_deconvolution_fwd_t);
+
+        virtual status_t init() override {
+            using namespace prop_kind;
+            using namespace data_type;
+            assert(this->engine()->kind() == engine_kind::cpu);
+            bool ok = true
+                && utils::one_of(desc()->prop_kind, forward_training,
+                        forward_inference)
+                && desc()->alg_kind == alg_kind::deconvolution_direct
+                && utils::everyone_is(f32, desc()->src_desc.data_type,
+                        desc()->weights_desc.data_type,
+                        desc()->dst_desc.data_type)
+                && utils::implication(with_bias(),
+                        desc()->bias_desc.data_type == f32)
+                && ndims() == 4
+                && (KSH() > 1 || KSW() > 1)
+                && set_default_params() == status::success
+                && src_pd_.desc()->format == data_format()
+                && dst_pd_.desc()->format == data_format()
+                && weights_pd_.desc()->format == weights_format()
+                && attr()->has_default_values();
+            return ok ? status::success : status::unimplemented;
+        }
+
+    protected:
+        memory_format_t data_format() const { return memory_format::nchw; }
+
+        memory_format_t weights_format() const {
+            using namespace memory_format;
+            return with_groups() ? goihw : oihw;
+        }
+
+        status_t set_default_params() {
+            using namespace memory_format;
+            if (src_pd_.desc()->format == any)
+                CHECK(src_pd_.set_format(data_format()));
+            if (dst_pd_.desc()->format == any)
+                CHECK(dst_pd_.set_format(data_format()));
+            if (weights_pd_.desc()->format == any)
+                CHECK(weights_pd_.set_format(weights_format()));
+            if (bias_pd_.desc()->format == any)
+                CHECK(bias_pd_.set_format(x));
+            return status::success;
+        }
+    };
+
+    /** the phases of one spatial dimension: the outputs of phase p are
+     * o = o_beg[p] + j * S for j in [0, n_o[p]); its taps are
+     * tap[tap_beg[p] .. tap_beg[p + 1]) and the tap k = tap[t] of a
+     * phase reads the source at i = j + shift[t] */
+    struct phases_t {
+        phases_t(int O, int I, int K, int S, int P, int DD);
+        int n() const { return (int)o_beg.size(); }
+        int n_taps(int p) const { return tap_beg[p + 1] - tap_beg[p]; }
+        nstl::vector<int> o_beg, n_o, tap_beg, tap, shift;
+    };
+
+    subpixel_deconvolution_fwd_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs);
+    ~subpixel_deconvolution_fwd_t() { delete scratchpad_; }
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual void execute(event_t *e) {
+        execute_forward();
+        e->set_state(event_t::ready);
+    }
+
+private:
+    void execute_forward();
+    pd_t conf_;
+    const phases_t ph_d_, ph_h_, ph_w_;
+    /* the taps of phase p of group g, packed as an OC x (IC x taps)
+     * row-major matrix, start at wei_off_[p] in the packed weights of g */
+    nstl::vector<size_t> wei_off_;
+    int nthr_;
+    size_t col_size_, res_size_;
+    scratchpad_t *scratchpad_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
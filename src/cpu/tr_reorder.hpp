@@ -0,0 +1,213 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_TR_REORDER_HPP
+#define CPU_TR_REORDER_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_primitive.hpp"
+#include "cpu_reorder_pd.hpp"
+#include "jit_uni_reorder.hpp" /* tr::prb_t and its utilities are jit-free */
+#include "simple_q10n.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace tr {
+
+/** moves the node with unit input stride right after the innermost output
+ * node, so that the two innermost nodes form a tile which is contiguous on
+ * the output side along node 0 and on the input side along node 1 */
+inline void prb_tile_for_transpose(prb_t &p) {
+    if (p.ndims < 2 || p.nodes[0].is == 1) return;
+    int j = 1;
+    for (; j < p.ndims && p.nodes[j].is != 1; ++j);
+    if (j == p.ndims || j == 1) return;
+    prb_node_move(p, j, 1);
+}
+
+}
+
+/** Portable reorder for any pair of blocked formats with equal padded dims.
+ * The problem is decomposed into a nest of strided loops (tr::prb_t, as for
+ * jit:uni), the two innermost loops are tiled and the rest are distributed
+ * among the threads. */
+template <data_type_t type_i, data_type_t type_o>
+struct tr_reorder_t : public cpu_primitive_t {
+    struct pd_t : public cpu_reorder_pd_t {
+        pd_t(const cpu_memory_pd_t *input_pd, const cpu_memory_pd_t *output_pd,
+                const primitive_attr_t *attr)
+            : cpu_reorder_pd_t(input_pd, output_pd, attr) {}
+
+        DECLARE_COMMON_PD_T("simple:tr", tr_reorder_t);
+
+        static status_t create(reorder_pd_t **reorder_pd,
+                const memory_pd_t *input_pd, const memory_pd_t *output_pd,
+                const primitive_attr_t *attr) {
+            assert(input_pd->engine()->kind() == engine_kind::cpu);
+            assert(output_pd->engine()->kind() == engine_kind::cpu);
+            bool args_ok = true
+                && input_pd->desc()->data_type == type_i
+                && output_pd->desc()->data_type == type_o;
+            if (!args_ok)
+                return invalid_arguments;
+
+            auto prb = tr::prb_t();
+            status_t status = tr::prb_init(prb, *input_pd->desc(),
+                    *output_pd->desc(), attr);
+            if (status != success) return status;
+
+            tr::prb_normalize(prb);
+            tr::prb_simplify(prb);
+            tr::prb_tile_for_transpose(prb);
+
+            auto _pd = new pd_t((const cpu_memory_pd_t *)input_pd,
+                    (const cpu_memory_pd_t *)output_pd, attr);
+            if (_pd == nullptr) return out_of_memory;
+            if (_pd->init() != success) { delete _pd; return unimplemented; }
+            _pd->prb_ = prb;
+            return safe_ptr_assign<reorder_pd_t>(*reorder_pd, _pd);
+        }
+
+        tr::prb_t prb_;
+    };
+
+    typedef typename prec_traits<type_i>::type in_data_t;
+    typedef typename prec_traits<type_o>::type out_data_t;
+
+    tr_reorder_t(const pd_t *pd, const input_vector &inputs,
+            const output_vector &outputs)
+        : cpu_primitive_t(&conf_, inputs, outputs), conf_(*pd) {}
+
+    virtual void execute(event_t *e) {
+        auto input = reinterpret_cast<const in_data_t *>(
+                this->input_memory(0));
+        auto output = reinterpret_cast<out_data_t *>(this->memory());
+        const bool with_scales
+            = conf_.prb_.scale_type != tr::scale_type_t::NONE;
+        const bool with_beta = conf_.prb_.beta != 0.f;
+        if (with_scales) {
+            if (with_beta) execute_reorder<true, true>(input, output);
+            else execute_reorder<true, false>(input, output);
+        } else {
+            if (with_beta) execute_reorder<false, true>(input, output);
+            else execute_reorder<false, false>(input, output);
+        }
+        e->set_state(event_t::ready);
+    }
+
+private:
+    enum { tile_transpose = 16, tile_copy = 1024 };
+
+    template <bool with_scales, bool with_beta>
+    void execute_reorder(const in_data_t *input, out_data_t *output) {
+        const tr::prb_t &prb = conf_.prb_;
+        const round_mode_t rmode = conf_.attr()->round_mode_;
+        const float beta = prb.beta;
+        const float *scales = conf_.attr()->output_scales_.scales_;
+
+        input += prb.ioff;
+        output += prb.ooff;
+
+        const int ndims = prb.ndims;
+        const tr::node_t n_unit = { 1, 0, 0, 0 };
+        const tr::node_t &n0 = ndims > 0 ? prb.nodes[0] : n_unit;
+        const tr::node_t &n1 = ndims > 1 ? prb.nodes[1] : n_unit;
+        const int ndims_ker = nstl::min(ndims, 2);
+
+        /* contiguous rows are copied in long chunks, transposed tiles are
+         * kept small enough to stay in L1 on both sides */
+        const bool is_transpose = n0.is != 1;
+        const size_t t0 = is_transpose ? tile_transpose
+            : nstl::min<size_t>(n0.n, tile_copy);
+        const size_t t1 = is_transpose ? tile_transpose
+            : nstl::max<size_t>(1, tile_copy / t0);
+        const size_t nb0 = utils::div_up(n0.n, t0);
+        const size_t nb1 = utils::div_up(n1.n, t1);
+
+        size_t work_amount = nb0 * nb1;
+        for (int d = ndims_ker; d < ndims; ++d)
+            work_amount *= prb.nodes[d].n;
+
+        auto ker = [&](const in_data_t *i, out_data_t *o, const float *s,
+                size_t b0, size_t b1) {
+            const size_t e0 = nstl::min(b0 + t0, n0.n);
+            const size_t e1 = nstl::min(b1 + t1, n1.n);
+            for (size_t i1 = b1; i1 < e1; ++i1) {
+                const in_data_t *ip = i + i1 * n1.is;
+                out_data_t *op = o + i1 * n1.os;
+                const float *sp = s + i1 * n1.ss;
+                PRAGMA_OMP_SIMD()
+                for (size_t i0 = b0; i0 < e0; ++i0) {
+                    const in_data_t x = ip[i0 * n0.is];
+                    out_data_t &y = op[i0 * n0.os];
+                    if (with_scales && with_beta)
+                        y = qz<in_data_t, out_data_t>()(x, y,
+                                sp[i0 * n0.ss], beta, rmode);
+                    else if (with_scales)
+                        y = qz_b0<in_data_t, out_data_t>()(x,
+                                sp[i0 * n0.ss], rmode);
+                    else if (with_beta)
+                        y = qz_a1<in_data_t, out_data_t>()(x, y, beta, rmode);
+                    else
+                        y = qz_a1b0<in_data_t, out_data_t>()(x, rmode);
+                }
+            }
+        };
+
+        OMP(parallel)//;
+        {
+            const int ithr = omp_get_thread_num();
+            const int nthr = omp_get_num_threads();
+            size_t start{0}, end{0};
+            balance211(work_amount, nthr, ithr, start, end);
+
+            for (size_t iwork = start; iwork < end; ++iwork) {
+                size_t w = iwork;
+                const size_t b0 = (w % nb0) * t0; w /= nb0;
+                const size_t b1 = (w % nb1) * t1; w /= nb1;
+                ptrdiff_t i_off = 0, o_off = 0, s_off = 0;
+                for (int d = ndims_ker; d < ndims; ++d) {
+                    const tr::node_t &n = prb.nodes[d];
+                    const ptrdiff_t pos = (ptrdiff_t)(w % n.n);
+                    w /= n.n;
+                    i_off += pos * n.is;
+                    o_off += pos * n.os;
+                    s_off += pos * n.ss;
+                }
+                ker(input + i_off, output + o_off, scales + s_off, b0, b1);
+            }
+        }
+    }
+
+    pd_t conf_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -347,6 +347,9 @@ NAMEENUM_T(query){
 
       case(mkldnn_query_impl_info_str): ret = "query:impl_info_str"; break;
 
+      case(mkldnn_query_flops_f64): ret = "query:flops_f64"; break;
+      case(mkldnn_query_bytes_f64): ret = "query:bytes_f64"; break;
+
                                                  /* memory and op descriptor section */
       case(mkldnn_query_some_d): ret = "query:some_d"; break;
       case(mkldnn_query_memory_d): ret = "query:memory_d"; break;
@@ -371,6 +374,7 @@ NAMEENUM_T(query){
       case(mkldnn_query_dst_pd): ret = "query:dst_pd"; break;
       case(mkldnn_query_diff_dst_pd): ret = "query:diff_dst_pd"; break;
       case(mkldnn_query_workspace_pd): ret = "query:workspace_pd"; break;
+      case(mkldnn_query_src_image_pd): ret = "query:src_image_pd"; break;
     }
     return ret;
 }
@@ -0,0 +1 @@
+../cpu/bcsr_gemm.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/bcsr_gemm.hpp
\ No newline at end of file
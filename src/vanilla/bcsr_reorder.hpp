@@ -0,0 +1 @@
+../cpu/bcsr_reorder.hpp
\ No newline at end of file
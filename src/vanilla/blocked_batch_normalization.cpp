@@ -0,0 +1 @@
+../cpu/blocked_batch_normalization.cpp
\ No newline at end of file
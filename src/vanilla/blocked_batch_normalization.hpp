@@ -0,0 +1 @@
+../cpu/blocked_batch_normalization.hpp
\ No newline at end of file
@@ -19,9 +19,12 @@
 
 #include <assert.h>
 
+#include <atomic>
+
 #include "c_types_map.hpp"
 #include "cpu_primitive.hpp"
 #include "event.hpp"
+#include "exec_args.hpp"
 #include "memory_pd.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
@@ -63,7 +66,7 @@ struct cpu_memory_t: public cpu_primitive_t {
 
     cpu_memory_t(const pd_t *mpd)
         : cpu_primitive_t(&conf_, input_vector(), output_vector(1, this))
-        , conf_(*mpd), data_(nullptr) {}
+        , conf_(*mpd), data_(nullptr), padding_dirty_(false) {}
     virtual ~cpu_memory_t() {}
 
     virtual void execute(mkldnn::impl::event_t *e)
@@ -73,13 +76,38 @@ struct cpu_memory_t: public cpu_primitive_t {
         *handle = static_cast<void *>(data_);
         return success;
     }
+    /** the padding of the buffer is zeroed right away, even if it is the
+     * current one: the user may have written to it since (see
+     * mkldnn_memory_set_data_handle()) */
     virtual mkldnn::impl::status_t set_data_handle(void *handle) {
         data_ = static_cast<char *>(handle);
+        padding_dirty_ = false;
         return zero_pad();
     }
 
+    /** a buffer bound by mkldnn_primitive_execute() is not tracked: its
+     * padding is zero on entry and is zeroed again right after a writer that
+     * does not preserve it */
+    virtual mkldnn::impl::status_t ensure_zero_padding(
+            size_t output_index = 0) const {
+        assert(output_index == 0);
+        UNUSED(output_index);
+        if (exec_args_t::handle(this) != nullptr) return success;
+        if (!padding_dirty_.exchange(false)) return success;
+        return zero_pad();
+    }
+    virtual void set_zero_padding_dirty(size_t output_index = 0) const {
+        assert(output_index == 0);
+        UNUSED(output_index);
+        if (exec_args_t::handle(this) != nullptr) {
+            zero_pad();
+            return;
+        }
+        padding_dirty_ = true;
+    }
+
     virtual char *memory(size_t output_index = 0) const
-    { assert(output_index == 0); return data_; }
+    { assert(output_index == 0); return data(); }
     virtual const char* const_memory(size_t output_index = 0) const
     //{ assert(output_index == 0); return data_; }
     {
@@ -106,16 +134,23 @@ struct cpu_memory_t: public cpu_primitive_t {
 #endif // CPU_MEMORY_HPP_DBG
         assert(conf_.kind() == mkldnn_memory);
         assert(output_index == 0);
-        return data_;
+        return data();
     }
 
 private:
     pd_t conf_;
     char *data_;
+    mutable std::atomic<bool> padding_dirty_;
+
+    /** the buffer bound to the memory on this thread, or the own one */
+    char *data() const {
+        void *bound = exec_args_t::handle(this);
+        return bound ? static_cast<char *>(bound) : data_;
+    }
 
     template <mkldnn::impl::data_type_t>
-    mkldnn::impl::status_t typed_zero_pad();
-    mkldnn::impl::status_t zero_pad();
+    mkldnn::impl::status_t typed_zero_pad() const;
+    mkldnn::impl::status_t zero_pad() const;
 };
 
 #if 0 // old
@@ -201,7 +236,8 @@ struct cpu_view_t: public cpu_primitive_t {
 
             src_pd_ = *src_pd;
             const memory_desc_t &src_d = *src_pd_.desc();
-            if (src_d.format == wino_fmt) return unimplemented;
+            if (utils::one_of(src_d.format, wino_fmt, bcsr_fmt))
+                return unimplemented;
             const auto &src_d_blk = src_d.layout_desc.blocking;
 
             memory_desc_t dst_d = src_d;
@@ -287,6 +323,15 @@ struct cpu_view_t: public cpu_primitive_t {
     virtual const char* const_memory(size_t output_index = 0) const
     { assert(output_index == 0); return input_memory(); }
 
+    /** the padding belongs to the viewed memory */
+    virtual status_t ensure_zero_padding(size_t output_index = 0) const {
+        assert(output_index == 0);
+        UNUSED(output_index);
+        auto src = static_cast<const cpu_primitive_t *>(
+                this->inputs()[0].primitive);
+        return src->ensure_zero_padding(this->inputs()[0].output_index);
+    }
+
 private:
     pd_t conf_;
 };
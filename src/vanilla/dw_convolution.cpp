@@ -0,0 +1 @@
+../cpu/dw_convolution.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/dw_convolution.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/gemm_bcsr_convolution.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/gemm_bcsr_convolution.hpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/gemm_bcsr_inner_product.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/gemm_bcsr_inner_product.hpp
\ No newline at end of file
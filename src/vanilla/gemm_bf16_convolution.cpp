@@ -0,0 +1 @@
+../cpu/gemm_bf16_convolution.cpp
\ No newline at end of file
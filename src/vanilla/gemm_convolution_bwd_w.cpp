@@ -58,82 +58,85 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights() {
     const int LDA = jcp.im2col_sz ? k : K;
     const data_t zero = 0.0, one = 1.0;
 
-    data_t *col = nullptr, *wei_reduction = nullptr;
-    ptrdiff_t wei_offset = 0;
-    if (jcp.im2col_sz) {
-        col = (data_t *)this->scratchpad_->get();
-        wei_offset = jcp.im2col_sz * jcp.nthr;
-    }
-    if (jcp.need_wei_reduction)
-        wei_reduction = (data_t *)this->scratchpad_->get() + wei_offset;
+    const size_t im_step = (size_t)jcp.ih * jcp.iw * jcp.id;
+    const size_t ws_per_thr = col_per_thr_ + wei_per_thr_;
+    data_t *ws = ws_per_thr ? (data_t *)this->scratchpad_->get() : nullptr;
 
-    do{
     OMP(parallel num_threads(jcp.nthr))
     {
         const int ithr = omp_get_thread_num();
-        const int nthr = omp_get_num_threads();
-
-        int ithr_g, nthr_g, ithr_mb, nthr_mb;
-        size_t g_start{0}, g_end{0}, mb_start{0}, mb_end{0};
-
-        jit_gemm_convolution_utils::bwd_weights_balance(ithr, nthr,
-                jcp.ngroups, jcp.mb, ithr_g, nthr_g, ithr_mb, nthr_mb);
-
-        const int need_reduction = nthr_mb != 1;
-
-        if (ithr_g != -1 && ithr_mb != -1) {
-            balance211((size_t)jcp.ngroups, nthr_g, ithr_g, g_start, g_end);
-            balance211((size_t)jcp.mb, nthr_mb, ithr_mb, mb_start, mb_end);
-
-            assert(implication((g_end - g_start) > 1, need_reduction == 0));
-
-            data_t *_col = col + (ptrdiff_t)ithr * jcp.im2col_sz;
-            data_t *weights_reduce_base = wei_reduction
-                    + ithr_g * nthr_mb * weights_g_size;
-            data_t *weights_reduce = weights_reduce_base
-                    + ithr_mb * weights_g_size;
-
-            //# pragma omp parallel for if(jcp.nthr == 1)
-            for (ptrdiff_t i = 0; i < jcp.im2col_sz; ++i) _col[i] = (data_t)0;
-
-            for (size_t g = g_start; g < g_end; ++g) {
-                data_t *_diff_weights = need_reduction
-                        ? weights_reduce : (diff_weights + g * weights_g_size);
-                for (size_t mb = mb_start; mb < mb_end; ++mb) {
-                    const data_t *_src = src + (mb*jcp.ngroups+g)*src_step;
-                    for (int od = 0; od < jcp.od; ++od) {
-                    const data_t *_diff_dst = diff_dst
-                            + (mb*jcp.ngroups+g)*dst_step + od * k;
-
-                    if (jcp.im2col_sz) {
-                        if (jcp.id == 1)
-                            jit_gemm_convolution_utils::im2col(jcp, _src, _col);
-                        else
-                            jit_gemm_convolution_utils::im2col_3d(jcp, _src,
-                                _col, od);
-                    }
 
-                    extended_sgemm(
-                        "T", "N", &M, &N, &k, &one,
-                        jcp.im2col_sz ? _col : _src + od * k,
-                        &LDA, _diff_dst, &K,
-                        mb == mb_start && od == 0 ? &zero : &one,
-                        _diff_weights, &M);
-                    }
+        int ithr_g, ithr_ic, ithr_mb;
+        jit_gemm_convolution_utils::bwd_weights_balance(ithr, jcp,
+                ithr_g, ithr_ic, ithr_mb);
+
+        /* slice of the weights: rows [ic_start * ks, ic_end * ks) of the
+         * M x N matrix of each group */
+        size_t g_start{0}, g_end{0}, ic_start{0}, ic_end{0};
+        size_t mb_start{0}, mb_end{0};
+        data_t *_ws = ws + (ptrdiff_t)ithr * ws_per_thr;
+        data_t *_col = _ws;
+        data_t *_wei_partial = _ws + col_per_thr_;
+
+        if (ithr_g != -1) {
+            balance211((size_t)jcp.ngroups, jcp.nthr_g, ithr_g, g_start, g_end);
+            balance211((size_t)jcp.ic, jcp.nthr_ic, ithr_ic, ic_start, ic_end);
+            balance211((size_t)jcp.mb, jcp.nthr_mb, ithr_mb, mb_start, mb_end);
+            assert(implication((g_end - g_start) > 1,
+                        !jcp.need_wei_reduction));
+        }
+
+        /* the convolution restricted to this ic slice */
+        jit_gemm_conv_conf_t jcp_ic = jcp;
+        jcp_ic.ic = (int)(ic_end - ic_start);
+        const int m = jcp_ic.ic * jcp.ks;
+        const int ld_wei = ithr_mb > 0 ? m : M;
+
+        for (ptrdiff_t i = 0; i < (ptrdiff_t)col_per_thr_; ++i)
+            _col[i] = (data_t)0;
+
+        for (size_t g = g_start; g < g_end && m > 0; ++g) {
+            data_t *_diff_weights = ithr_mb > 0 ? _wei_partial
+                : diff_weights + g * weights_g_size + ic_start * jcp.ks;
+            for (size_t mb = mb_start; mb < mb_end; ++mb) {
+                const data_t *_src = src + (mb*jcp.ngroups+g)*src_step
+                    + ic_start * im_step;
+                for (int od = 0; od < jcp.od; ++od) {
+                const data_t *_diff_dst = diff_dst
+                        + (mb*jcp.ngroups+g)*dst_step + od * k;
+
+                if (jcp.im2col_sz) {
+                    if (jcp.id == 1)
+                        jit_gemm_convolution_utils::im2col(jcp_ic, _src, _col);
+                    else
+                        jit_gemm_convolution_utils::im2col_3d(jcp_ic, _src,
+                            _col, od);
+                }
+
+                extended_sgemm(
+                    "T", "N", &m, &N, &k, &one,
+                    jcp.im2col_sz ? _col : _src + od * k,
+                    &LDA, _diff_dst, &K,
+                    mb == mb_start && od == 0 ? &zero : &one,
+                    _diff_weights, &ld_wei);
                 }
             }
-            if (need_reduction) {
-                OMP(barrier)//;
-                data_t *weights_base = diff_weights + g_start * weights_g_size;
+        }
+
+        if (jcp.need_wei_reduction) {
+            OMP(barrier)//;
+            if (ithr_g != -1 && m > 0) {
+                /* the team shares g and the ic slice; its first thread
+                 * wrote diff_weights directly */
+                const data_t *team_ws = ws
+                    + (ptrdiff_t)(ithr - ithr_mb) * ws_per_thr + col_per_thr_;
                 jit_gemm_convolution_utils::bwd_weights_reduction_par(
-                    ithr_mb, nthr_mb, jcp, weights_reduce_base, weights_base);
-            }
-        } else
-            if (need_reduction) {
-                OMP(barrier)//;
+                    ithr_mb, jcp, m, team_ws, ws_per_thr, m,
+                    diff_weights + g_start * weights_g_size
+                        + ic_start * jcp.ks, M);
             }
+        }
     }
-    }while(0);
 #if VE_OPENMP_BUG
     if (jcp.with_bias) {
         execute_backward_weights_bias();
@@ -0,0 +1 @@
+../cpu/jit_uni_reorder.hpp
\ No newline at end of file
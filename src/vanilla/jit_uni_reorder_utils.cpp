@@ -0,0 +1 @@
+../cpu/jit_uni_reorder_utils.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/subpixel_deconvolution.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../cpu/subpixel_deconvolution.hpp
\ No newline at end of file
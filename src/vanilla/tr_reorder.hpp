@@ -0,0 +1 @@
+../cpu/tr_reorder.hpp
\ No newline at end of file
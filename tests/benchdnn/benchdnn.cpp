@@ -51,8 +51,32 @@ double max_ms_per_prb {3e3};
 int min_times_per_prb {5};
 int fix_times_per_prb {0};
 
+static mkldnn_hugepages_policy_t str2hugepages(const char *str) {
+    if (!strcmp("thp", str)) return mkldnn_hugepages_thp;
+    if (!strcmp("hugetlb", str)) return mkldnn_hugepages_hugetlb;
+    if (strcmp("none", str))
+        fprintf(stderr, "warning: unknown hugepages policy '%s'\n", str);
+    return mkldnn_hugepages_none;
+}
+
+static mkldnn_numa_policy_t str2numa(const char *str, int *node) {
+    *node = 0;
+    if (!strcmp("interleave", str)) return mkldnn_numa_interleave;
+    if (str[0] >= '0' && str[0] <= '9') {
+        *node = atoi(str);
+        return mkldnn_numa_bind;
+    }
+    if (strcmp("default", str))
+        fprintf(stderr, "warning: unknown numa policy '%s'\n", str);
+    return mkldnn_numa_default;
+}
+
 int main(int argc, char **argv) {
     prim_t prim = DEF;
+    mkldnn_hugepages_policy_t hugepages = mkldnn_hugepages_none;
+    mkldnn_numa_policy_t numa = mkldnn_numa_default;
+    int numa_node = 0;
+    bool mem_policy_set = false;
     --argc; ++argv;
 
     while (argc > 0) {
@@ -69,6 +93,13 @@ int main(int argc, char **argv) {
             verbose = atoi(argv[0] + 2);
         else if (!strncmp("--verbose=", argv[0], 10))
             verbose = atoi(argv[0] + 10);
+        else if (!strncmp("--hugepages=", argv[0], 12)) {
+            hugepages = str2hugepages(argv[0] + 12);
+            mem_policy_set = true;
+        } else if (!strncmp("--numa=", argv[0], 7)) {
+            numa = str2numa(argv[0] + 7, &numa_node);
+            mem_policy_set = true;
+        }
         else break;
 
         --argc;
@@ -83,6 +114,10 @@ int main(int argc, char **argv) {
                 bench_mode2str(bench_mode), verbose, omp_max_thr);
     fflush(stdout);
 
+    if (mem_policy_set && mkldnn_memory_policy_set(hugepages, numa, numa_node)
+            != mkldnn_success)
+        fprintf(stderr, "warning: invalid memory policy, ignored\n");
+
     init();
 
     switch (prim) {
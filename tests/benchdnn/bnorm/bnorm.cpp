@@ -660,6 +660,7 @@ int doit(const prb_t *p, res_t *r) {
     }
 
     if (bench_mode & PERF) {
+        query_cost(b, r);
         auto &t = r->timer;
         t.reset();
         while (true) {
@@ -40,7 +40,11 @@ See modifiers at the same place.
 | %f            | flags
 | %q            | data type (precision)
 | %f            | data format (layout)
+| %@O           | number of ops (as reported by the library)
 | %@t           | time in ms
+| %@p           | ops per second
+| %@B           | bytes read and written (sizes of all the primitive memories)
+| %@b           | bytes per second
 
 The definition of expanded problem descriptor is: `mb,ic,ih,iw,eps`.
 #endif
@@ -108,6 +112,14 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%s", fmt2str(p->fmt));
         else if (c == 't')
             DPRINT("%g", t.ms(mode) / unit);
+        else if (c == 'O')
+            DPRINT("%g", r->flops / unit);
+        else if (c == 'p')
+            DPRINT("%g", r->flops / t.ms(mode) / unit * 1e3);
+        else if (c == 'B')
+            DPRINT("%g", r->bytes / unit);
+        else if (c == 'b')
+            DPRINT("%g", r->bytes / t.ms(mode) / unit * 1e3);
         else
             []() { SAFE(FAIL, CRIT); return 0; }();
     }
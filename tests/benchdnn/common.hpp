@@ -156,6 +156,7 @@ struct res_t {
     res_state_t state;
     size_t errors, total;
     benchdnn_timer_t timer;
+    double flops, bytes; /** analytic cost of one execution (see query_cost) */
 };
 
 void parse_result(res_t &res, bool &want_perf_report, bool allow_unimpl,
@@ -288,6 +288,7 @@ int doit(const prb_t *p, res_t *r) {
     }
 
     if (bench_mode & PERF) {
+        query_cost(c, r);
         auto &t = r->timer;
         t.reset();
         while (true) {
@@ -48,6 +48,8 @@ table of modifiers below.
 | %@t           | time in ms
 | %@c           | time in clocks
 | %@p           | ops per second
+| %@B           | bytes read and written (sizes of all the primitive memories)
+| %@b           | bytes per second
 
 | modifier  | description
 |:--------  |:-----------
@@ -129,6 +131,10 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", t.ticks(mode) / unit);
         else if (c == 'p')
             DPRINT("%g", p->ops / t.ms(mode) / unit * 1e3);
+        else if (c == 'B')
+            DPRINT("%g", r->bytes / unit);
+        else if (c == 'b')
+            DPRINT("%g", r->bytes / t.ms(mode) / unit * 1e3);
         else
             []() { SAFE(FAIL, CRIT); return 0; }();
     }
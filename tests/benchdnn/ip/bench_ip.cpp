@@ -32,7 +32,7 @@ dir_t dir = FWD_B;
 int mb = 0;
 attr_t attr;
 bool allow_unimpl = false;
-const char *perf_template = "perf,%D,%n,%z,%q,%-t,%-Gp,%0t,%0Gp";
+const char *perf_template = "perf,%D,%n,%z,%q,%-t,%-Gp,%0t,%0Gp,%-Gb";
 
 void reset_parameters() {
     cfg = conf_f32;
@@ -362,6 +362,7 @@ int doit(const prb_t *p, res_t *r) {
     }
 
     if (bench_mode & PERF) {
+        query_cost(ip, r);
         auto &t = r->timer;
         t.reset();
         while (true) {
@@ -43,6 +43,8 @@ table of modifiers below.
 | %q            | data type (precision)
 | %@t           | time in ms
 | %@p           | elements per second
+| %@B           | bytes read and written (sizes of all the primitive memories)
+| %@b           | bytes per second
 
 | modifier  | description
 |:--------  |:-----------
@@ -120,6 +122,10 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", t.ms(mode) / unit);
         else if (c == 'p')
             DPRINT("%g", ops / t.ms(mode) / unit * 1e3);
+        else if (c == 'B')
+            DPRINT("%g", r->bytes / unit);
+        else if (c == 'b')
+            DPRINT("%g", r->bytes / t.ms(mode) / unit * 1e3);
         else
             []() { SAFE(FAIL, CRIT); return 0; }();
     }
@@ -100,4 +100,15 @@ inline const char *query_impl_info(const_mkldnn_primitive_desc_t pd) {
     return str;
 }
 
+/* number of operations and of bytes read/written by one execution of the
+ * primitive, as reported by the library (used for GFLOP/s and GB/s) */
+inline void query_cost(const_mkldnn_primitive_t p, res_t *r) {
+    r->flops = r->bytes = 0;
+    const_mkldnn_primitive_desc_t pd;
+    if (mkldnn_primitive_get_primitive_desc(p, &pd) != mkldnn_success)
+        return;
+    mkldnn_primitive_desc_query(pd, mkldnn_query_flops_f64, 0, &r->flops);
+    mkldnn_primitive_desc_query(pd, mkldnn_query_bytes_f64, 0, &r->bytes);
+}
+
 #endif
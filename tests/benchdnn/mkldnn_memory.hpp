@@ -160,7 +160,7 @@ private:
         if (data == NULL) {
             const size_t alignment = 1024 * 1024 * 2;
             size_t sz = mkldnn_memory_primitive_desc_get_size(mpd_);
-            data_ = zmalloc(sz, alignment);
+            data_ = mkldnn_malloc(sz, alignment);
             DNN_SAFE(data_ == NULL ? mkldnn_out_of_memory : mkldnn_success,
                     WARN);
         } else {
@@ -187,7 +187,7 @@ private:
         if (!active_) return OK;
         DNN_SAFE(mkldnn_primitive_desc_destroy(mpd_), CRIT);
         DNN_SAFE(mkldnn_primitive_destroy(p_), CRIT);
-        if (is_data_owner_) zfree(data_);
+        if (is_data_owner_) mkldnn_free(data_);
         return OK;
     }
 };
@@ -30,7 +30,7 @@ attr_t attr;
 bool allow_unimpl = false;
 bool both_dir_dt = false;
 bool both_dir_fmt = false;
-const char *perf_template = "perf,%n,%D,%O,%-t,%-Gp,%0t,%0Gp";
+const char *perf_template = "perf,%n,%D,%O,%-t,%-Gp,%0t,%0Gp,%-Gb";
 
 std::vector<mkldnn_data_type_t> v_idt, v_odt;
 std::vector<mkldnn_memory_format_t> v_ifmt, v_ofmt;
@@ -336,6 +336,7 @@ int check_reorder(const prb_t *p, res_t *res) {
         DNN_SAFE(mkldnn_primitive_create(&perf_r, perf_r_pd, &i, &o), WARN);
         DNN_SAFE_V(mkldnn_primitive_desc_destroy(perf_r_pd));
 
+        query_cost(perf_r, res);
         auto &t = res->timer;
         t.reset();
         while (true) {
@@ -43,7 +43,9 @@ void perf_report(const rnn_prb_t *p, const res_t *r, const char *pstr) {
     DPRINT("time(ms):");
     DPRINT("min=%g,", t.ms(benchdnn_timer_t::min));
     DPRINT("max=%g,", t.ms(benchdnn_timer_t::max));
-    DPRINT("avg=%g", t.ms(benchdnn_timer_t::avg));
+    DPRINT("avg=%g,", t.ms(benchdnn_timer_t::avg));
+    DPRINT("GFLOP/s=%g,", r->flops / t.ms(benchdnn_timer_t::min) / 1e6);
+    DPRINT("GB/s=%g", r->bytes / t.ms(benchdnn_timer_t::min) / 1e6);
 
 #   undef DPRINT
     print(0, "%s\n", buffer);
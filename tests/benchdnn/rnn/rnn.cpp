@@ -494,6 +494,9 @@ int doit(const rnn_prb_t *p, res_t *r) {
     }
 
     if (bench_mode & PERF) {
+#ifdef CALL_MKLDNN_RNN
+        query_cost(c, r);
+#endif
         auto &t = r->timer;
         t.reset();
         while (true) {
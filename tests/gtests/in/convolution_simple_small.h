@@ -154,6 +154,36 @@ INST_TEST_CASE(SimpleSmall_Regression,
     PARAMS(FMT_DATA_BLOCKED16, FMT_WEIGHTS_BLOCKED16, FMT_BIAS, FMT_DATA_BLOCKED16,
         2, 1, 32, 34, 34, 32, 34, 34, 5, 5, 2, 2, 1, 1)
 );
+#endif
+
+/* the f32 depthwise kernels are portable */
+#if MKLDNN_JIT_TYPES > 0 || defined(FP32)
+INST_TEST_CASE(SimpleSmall_Depthwise,
+    PARAMS(nchw, goihw, FMT_BIAS, nchw,
+        2, 8, 8, 16, 16, 8, 16, 16, 3, 3, 1, 1, 1, 1),
+    PARAMS(nchw, goihw, FMT_BIAS, nchw,
+        2, 12, 12, 9, 9, 12, 5, 5, 3, 3, 1, 1, 2, 2),
+    PARAMS(nchw, goihw, FMT_BIAS, nchw,
+        1, 16, 16, 16, 32, 16, 16, 18, 3, 3, 1, 2, 1, 2),
+    PARAMS(nchw, Goihw16g, FMT_BIAS, nchw,
+        2, 20, 20, 9, 9, 20, 9, 9, 3, 3, 1, 1, 1, 1),
+    PARAMS(nhwc, hwigo, FMT_BIAS, nhwc,
+        2, 8, 8, 16, 16, 8, 16, 16, 3, 3, 1, 1, 1, 1),
+    PARAMS(nhwc, hwigo, FMT_BIAS, nhwc,
+        2, 20, 20, 9, 9, 20, 5, 5, 3, 3, 1, 1, 2, 2),
+    PARAMS(nhwc, goihw, FMT_BIAS, nhwc,
+        1, 24, 24, 32, 16, 24, 16, 14, 3, 3, 1, 0, 2, 1),
+    PARAMS(nhwc, Goihw8g, FMT_BIAS, nhwc,
+        2, 12, 12, 7, 7, 12, 7, 7, 3, 3, 1, 1, 1, 1),
+    PARAMS(FMT_DATA_BLOCKED, goihw, FMT_BIAS, FMT_DATA_BLOCKED,
+        2, 24, 24, 9, 9, 24, 5, 5, 3, 3, 1, 1, 2, 2),
+    PARAMS(FMT_DATA_BLOCKED16, hwigo, FMT_BIAS, FMT_DATA_BLOCKED16,
+        2, 32, 32, 9, 9, 32, 9, 9, 5, 5, 2, 2, 1, 1),
+    PARAMS(FMT_DATA_BLOCKED, Goihw8g, FMT_BIAS, FMT_DATA_BLOCKED,
+        2, 12, 12, 9, 9, 12, 9, 9, 3, 3, 1, 1, 1, 1),
+    PARAMS(FMT_DATA_BLOCKED16, Goihw16g, FMT_BIAS, FMT_DATA_BLOCKED16,
+        2, 12, 12, 9, 9, 12, 5, 5, 3, 3, 1, 1, 2, 2)
+);
 
 INST_TEST_CASE(SimpleSmall_Depthwise_Blocked,
     PARAMS(FMT_DATA_BLOCKED, Goihw8g, FMT_BIAS, FMT_DATA_BLOCKED,
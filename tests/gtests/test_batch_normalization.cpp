@@ -482,12 +482,10 @@ TEST_P(bnrm_test_float, TestsBnrm)
 #define PARAMS_NHWC(...) EXPAND_ARGS(PARAMS(nhwc, nhwc, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_NC(...) EXPAND_ARGS(PARAMS(nc, nc, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_EF(...) EXPAND_ARGS(PARAMS(nchw, nchw, __VA_ARGS__))
-#if MKLDNN_JIT_TYPES > 0
 #define PARAMS_B8_3D(...) EXPAND_ARGS(PARAMS_3D(nCdhw8c, nCdhw8c, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_B16_3D(...) EXPAND_ARGS(PARAMS_3D(nCdhw16c, nCdhw16c, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_B8(...) EXPAND_ARGS(PARAMS(nChw8c, nChw8c, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_B16(...) EXPAND_ARGS(PARAMS(nChw16c, nChw16c, __VA_ARGS__, false, mkldnn_success))
-#endif
 
 #define INST_TEST_CASE(str, ...) INSTANTIATE_TEST_CASE_P( \
         str, bnrm_test_float, ::testing::Values(__VA_ARGS__))
@@ -504,7 +502,6 @@ INST_TEST_CASE(SimpleExpectedFails,
     PARAMS_EF(4, 20, -12, 12, EPS, true, mkldnn_invalid_arguments)
 );
 
-#if MKLDNN_JIT_TYPES > 0
 INST_TEST_CASE(Simple_nChw16c_padded,
     PARAMS_B16(1, 27, 9, 10, EPS),
     PARAMS_B16(1, 12, 10, 9, EPS),
@@ -548,7 +545,6 @@ INST_TEST_CASE(Simple_nCdhw8c,
     PARAMS_B8_3D(2, 32, 10, 8, 4, EPS),
     PARAMS_B8_3D(2, 32, 10, 8, 4, EPS)
 );
-#endif
 
 INST_TEST_CASE(Simple_NC,
     PARAMS_NC(2, 8, 1, 1, EPS),
@@ -578,7 +574,6 @@ INST_TEST_CASE(Simple_NHWC,
     PARAMS_NHWC(2, 10, 4, 4, EPS)
 );
 
-#if MKLDNN_JIT_TYPES > 0
 INST_TEST_CASE(Simple_Blocked,
     PARAMS_B8(2, 8, 1, 1, EPS),
     PARAMS_B8(2, 8, 4, 4, EPS),
@@ -600,7 +595,6 @@ INST_TEST_CASE(Simple_Blocked,
     PARAMS_B16(2, 16, 10, 8, EPS),
     PARAMS_B16(2, 16, 10, 8, EPS)
 );
-#endif
 
 INST_TEST_CASE(GoogleNet_NCHW,
     PARAMS_N(2, 64, 112, 112, EPS),
@@ -641,7 +635,6 @@ INST_TEST_CASE(GoogleNet_NCHW,
     PARAMS_N(2, 384, 7, 7, EPS)
 );
 
-#if MKLDNN_JIT_TYPES > 0
 INST_TEST_CASE(GoogleNet_Blocked_8,
     PARAMS_B8(2, 64, 112, 112, EPS),
     PARAMS_B8(2, 64, 56, 56, EPS),
@@ -679,9 +672,7 @@ INST_TEST_CASE(GoogleNet_Blocked_8,
     PARAMS_B8(2, 48, 7, 7, EPS),
     PARAMS_B8(2, 384, 7, 7, EPS)
 );
-#endif
 
-#if MKLDNN_JIT_TYPES > 0
 INST_TEST_CASE(GoogleNet_Blocked_16,
     PARAMS_B16(2, 64, 112, 112, EPS),
     PARAMS_B16(2, 64, 56, 56, EPS),
@@ -719,6 +710,185 @@ INST_TEST_CASE(GoogleNet_Blocked_16,
     PARAMS_B16(2, 48, 7, 7, EPS),
     PARAMS_B16(2, 384, 7, 7, EPS)
 );
-#endif
+
+TEST(bnrm_fold, FoldIntoInnerProductWeights) {
+    const int C = 19, IC = 7;
+    const float eps = 1e-3f;
+    auto eng = engine(engine::kind::cpu, 0);
+
+    auto data_md = memory::desc({ 2, C }, memory::data_type::f32,
+            memory::format::nc);
+    auto bnrm_desc = batch_normalization_forward::desc(
+            prop_kind::forward_inference, data_md, eps,
+            use_global_stats | use_scale_shift);
+
+    auto mem = [&](memory::dims dims, memory::format fmt) {
+        return memory({ { dims, memory::data_type::f32, fmt }, eng });
+    };
+    auto weights = mem({ C, IC }, memory::format::oi);
+    auto bias = mem({ C }, memory::format::x);
+    auto mean = mem({ C }, memory::format::x);
+    auto variance = mem({ C }, memory::format::x);
+    auto scaleshift = mem({ 2, C }, memory::format::nc);
+
+    float *w = (float *)weights.get_data_handle();
+    float *b = (float *)bias.get_data_handle();
+    float *m = (float *)mean.get_data_handle();
+    float *v = (float *)variance.get_data_handle();
+    float *ss = (float *)scaleshift.get_data_handle();
+    for (int oc = 0; oc < C; ++oc) {
+        for (int ic = 0; ic < IC; ++ic)
+            w[oc * IC + ic] = 0.25f * ((oc * 3 + ic * 5) % 11) - 1.f;
+        b[oc] = 0.1f * (oc % 7) - 0.3f;
+        m[oc] = 0.2f * (oc % 5) - 0.4f;
+        v[oc] = 0.5f + 0.1f * (oc % 4);
+        ss[oc] = 1.f + 0.05f * (oc % 6);
+        ss[C + oc] = 0.02f * (oc % 9);
+    }
+    std::vector<float> x(IC), ref(C);
+    for (int ic = 0; ic < IC; ++ic)
+        x[ic] = 0.3f * ic - 1.f;
+    for (int oc = 0; oc < C; ++oc) {
+        float y = b[oc];
+        for (int ic = 0; ic < IC; ++ic)
+            y += w[oc * IC + ic] * x[ic];
+        ref[oc] = ss[oc] * (y - m[oc]) / std::sqrt(v[oc] + eps) + ss[C + oc];
+    }
+
+    batch_normalization_forward::fold(bnrm_desc, weights, bias, mean,
+            variance, scaleshift);
+
+    for (int oc = 0; oc < C; ++oc) {
+        float y = b[oc];
+        for (int ic = 0; ic < IC; ++ic)
+            y += w[oc * IC + ic] * x[ic];
+        EXPECT_NEAR(y, ref[oc], 1e-4f * (1.f + std::fabs(ref[oc])));
+    }
+
+    auto training_desc = batch_normalization_forward::desc(
+            prop_kind::forward_training, data_md, eps, use_global_stats);
+    EXPECT_THROW(batch_normalization_forward::fold(training_desc, weights,
+                bias, mean, variance), error);
+}
+
+
+struct bnrm_fold_params {
+    memory::format data_format;
+    memory::format weights_format;
+    memory::format plain_weights_format;
+    memory::dims data_dims;
+    memory::dims weights_dims;
+};
+
+/* folds into real convolution weights, blocked and grouped ones included:
+ * the folded weights are read back in the plain format, where the output
+ * channel is the outermost (or outermost two) dimension */
+class bnrm_fold_test : public ::testing::TestWithParam<bnrm_fold_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<bnrm_fold_params>::GetParam();
+        const int C = p.data_dims[1];
+        const float eps = 1e-3f;
+        auto eng = engine(engine::kind::cpu, 0);
+
+        auto bnrm_desc = batch_normalization_forward::desc(
+                prop_kind::forward_inference,
+                memory::desc(p.data_dims, memory::data_type::f32,
+                    p.data_format),
+                eps, use_global_stats | use_scale_shift);
+
+        auto mem = [&](memory::dims dims, memory::format fmt) {
+            return memory({ { dims, memory::data_type::f32, fmt }, eng });
+        };
+        auto plain_weights = mem(p.weights_dims, p.plain_weights_format);
+        auto weights = mem(p.weights_dims, p.weights_format);
+        auto bias = mem({ C }, memory::format::x);
+        auto mean = mem({ C }, memory::format::x);
+        auto variance = mem({ C }, memory::format::x);
+        auto scaleshift = mem({ 2, C }, memory::format::nc);
+
+        size_t nelems = 1;
+        for (auto d: p.weights_dims) nelems *= d;
+        const size_t oc_size = nelems / C;
+
+        float *w = (float *)plain_weights.get_data_handle();
+        float *b = (float *)bias.get_data_handle();
+        float *m = (float *)mean.get_data_handle();
+        float *v = (float *)variance.get_data_handle();
+        float *ss = (float *)scaleshift.get_data_handle();
+        for (size_t i = 0; i < nelems; ++i)
+            w[i] = 0.25f * ((i * 7) % 11) - 1.f;
+        std::vector<float> w_ref(nelems), b_ref(C);
+        for (int oc = 0; oc < C; ++oc) {
+            b[oc] = 0.1f * (oc % 7) - 0.3f;
+            m[oc] = 0.2f * (oc % 5) - 0.4f;
+            v[oc] = 0.5f + 0.1f * (oc % 4);
+            ss[oc] = 1.f + 0.05f * (oc % 6);
+            ss[C + oc] = 0.02f * (oc % 9);
+
+            const float s = ss[oc] / std::sqrt(v[oc] + eps);
+            for (size_t i = 0; i < oc_size; ++i)
+                w_ref[oc * oc_size + i] = w[oc * oc_size + i] * s;
+            b_ref[oc] = (b[oc] - m[oc]) * s + ss[C + oc];
+        }
+
+        stream(stream::kind::eager).submit(
+                { reorder(plain_weights, weights) }).wait();
+        batch_normalization_forward::fold(bnrm_desc, weights, bias, mean,
+                variance, scaleshift);
+        stream(stream::kind::eager).submit(
+                { reorder(weights, plain_weights) }).wait();
+
+        for (size_t i = 0; i < nelems; ++i)
+            ASSERT_NEAR(w[i], w_ref[i], 1e-5f * (1.f + std::fabs(w_ref[i])));
+        for (int oc = 0; oc < C; ++oc)
+            ASSERT_NEAR(b[oc], b_ref[oc], 1e-5f * (1.f + std::fabs(b_ref[oc])));
+    }
+};
+
+TEST_P(bnrm_fold_test, TestsFold) {}
+
+INSTANTIATE_TEST_CASE_P(TestBnrmFold, bnrm_fold_test, ::testing::Values(
+    bnrm_fold_params{ memory::format::nc, memory::format::oi,
+        memory::format::oi, { 2, 19 }, { 19, 7 } },
+    bnrm_fold_params{ memory::format::nchw, memory::format::oihw,
+        memory::format::oihw, { 2, 16, 5, 5 }, { 16, 3, 3, 3 } },
+    bnrm_fold_params{ memory::format::nChw8c, memory::format::OIhw8i8o,
+        memory::format::oihw, { 2, 19, 5, 5 }, { 19, 13, 3, 3 } },
+    bnrm_fold_params{ memory::format::nchw, memory::format::goihw,
+        memory::format::goihw, { 2, 12, 5, 5 }, { 3, 4, 2, 3, 3 } },
+    bnrm_fold_params{ memory::format::nChw8c, memory::format::gOIhw8i8o,
+        memory::format::goihw, { 2, 16, 5, 5 }, { 2, 8, 8, 3, 3 } }));
+
+/* only weights with one more dimension than the data are grouped: ungrouped
+ * weights whose first two dimensions multiply to the number of channels do
+ * not match */
+TEST(bnrm_fold, RejectsMismatchedWeights) {
+    const int C = 12;
+    auto eng = engine(engine::kind::cpu, 0);
+    auto mem = [&](memory::dims dims, memory::format fmt) {
+        return memory({ { dims, memory::data_type::f32, fmt }, eng });
+    };
+    auto bias = mem({ C }, memory::format::x);
+    auto mean = mem({ C }, memory::format::x);
+    auto variance = mem({ C }, memory::format::x);
+
+    auto fc_desc = batch_normalization_forward::desc(
+            prop_kind::forward_inference,
+            memory::desc({ 2, C }, memory::data_type::f32, memory::format::nc),
+            1e-3f, use_global_stats);
+    auto fc_weights = mem({ 3, 4 }, memory::format::oi);
+    EXPECT_THROW(batch_normalization_forward::fold(fc_desc, fc_weights,
+                bias, mean, variance), error);
+
+    auto conv_desc = batch_normalization_forward::desc(
+            prop_kind::forward_inference,
+            memory::desc({ 2, C, 3, 3 }, memory::data_type::f32,
+                memory::format::nchw),
+            1e-3f, use_global_stats);
+    auto conv_weights = mem({ 3, 4, 1, 1 }, memory::format::oihw);
+    EXPECT_THROW(batch_normalization_forward::fold(conv_desc, conv_weights,
+                bias, mean, variance), error);
+}
 
 }
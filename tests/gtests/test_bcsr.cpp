@@ -0,0 +1,226 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct bcsr_params {
+    int oc_block, k_block;
+};
+
+/* Block-CSR weights: a reorder from plain weights, and forward convolution
+ * and inner product on them, which must match the dense primitives on the
+ * same (pruned) weights. */
+class bcsr_test: public ::testing::TestWithParam<bcsr_params> {
+protected:
+    typedef std::vector<float> buf_t;
+
+    virtual void SetUp() {
+        p = ::testing::TestWithParam<bcsr_params>::GetParam();
+        eng.reset(new engine(engine::kind::cpu, 0));
+    }
+
+    static float *data(const memory &m) { return (float *)m.get_data_handle(); }
+
+    static void fill(const memory &m, int seed) {
+        const size_t n = m.get_primitive_desc().get_size() / sizeof(float);
+        for (size_t i = 0; i < n; ++i)
+            data(m)[i] = (float)((i * 13 + seed * 7) % 17) / 8.f - 1.f;
+    }
+
+    /* about 80% zeros, a mix of isolated and clustered nonzeros */
+    static void fill_pruned(const memory &m) {
+        const size_t n = m.get_primitive_desc().get_size() / sizeof(float);
+        for (size_t i = 0; i < n; ++i) {
+            const bool keep = (i * 7919) % 10 < 2 || (i / 24) % 11 == 0;
+            data(m)[i] = keep ? (float)((i * 37) % 23) / 11.f - 1.f : 0.f;
+        }
+    }
+
+    static void reorder_to(const memory &from, const memory &to) {
+        stream(stream::kind::eager).submit({reorder(from, to)}).wait();
+    }
+
+    static const char *impl_str(const_mkldnn_primitive_desc_t pd) {
+        const char *str = nullptr;
+        mkldnn_primitive_desc_query(pd, mkldnn_query_impl_info_str, 0, &str);
+        return str;
+    }
+
+    static void compare(const memory &res, const memory &ref) {
+        const size_t n = ref.get_primitive_desc().get_size() / sizeof(float);
+        for (size_t i = 0; i < n; ++i)
+            ASSERT_NEAR(data(res)[i], data(ref)[i],
+                    1e-5f * (1.f + std::fabs(data(ref)[i]))) << "at " << i;
+    }
+
+    void test_conv(memory::dims src_dims, memory::dims wei_dims,
+            memory::dims dst_dims, memory::dims strides,
+            memory::dims padding, bool with_relu) {
+        using fmt = memory::format;
+        const auto f32 = memory::data_type::f32;
+        const bool is_3d = src_dims.size() == 5;
+        const auto sfmt = is_3d ? fmt::ncdhw : fmt::nchw;
+        const auto wfmt = is_3d ? fmt::oidhw : fmt::oihw;
+        auto src_md = memory::desc(src_dims, f32, sfmt);
+        auto wei_md = memory::desc(wei_dims, f32, wfmt);
+        auto sp_md = memory::desc::bcsr(wei_dims, f32, p.oc_block, p.k_block);
+        auto bia_md = memory::desc({wei_dims[0]}, f32, fmt::x);
+        auto dst_md = memory::desc(dst_dims, f32, sfmt);
+
+        primitive_attr attr;
+        if (with_relu) {
+            post_ops ops;
+            ops.append_eltwise(1.f, algorithm::eltwise_relu, 0.f, 0.f);
+            attr.set_post_ops(ops);
+        }
+        auto make_pd = [&](const memory::desc &wmd) {
+            return convolution_forward::primitive_desc(
+                    convolution_forward::desc(prop_kind::forward_inference,
+                        algorithm::convolution_direct, src_md, wmd, bia_md,
+                        dst_md, strides, padding, padding,
+                        padding_kind::zero), attr, *eng);
+        };
+        auto ref_pd = make_pd(wei_md);
+        auto sp_pd = make_pd(sp_md);
+        ASSERT_STREQ(impl_str(sp_pd.get()), "gemm:bcsr");
+
+        memory src({src_md, *eng}), wei({wei_md, *eng}), sp({sp_md, *eng});
+        memory bia({bia_md, *eng});
+        memory ref({dst_md, *eng}), res({dst_md, *eng});
+        fill(src, 1);
+        fill(bia, 2);
+        fill_pruned(wei);
+        reorder_to(wei, sp);
+
+        auto s = stream(stream::kind::eager);
+        s.submit({convolution_forward(ref_pd, src, wei, bia, ref),
+                convolution_forward(sp_pd, src, sp, bia, res)}).wait();
+        compare(res, ref);
+    }
+
+    void test_ip(memory::dims src_dims, memory::dims wei_dims) {
+        using fmt = memory::format;
+        const auto f32 = memory::data_type::f32;
+        const int oc = wei_dims[0];
+        auto src_md = memory::desc(src_dims, f32,
+                src_dims.size() == 4 ? fmt::nchw : fmt::nc);
+        auto wei_md = memory::desc(wei_dims, f32,
+                wei_dims.size() == 4 ? fmt::oihw : fmt::oi);
+        auto sp_md = memory::desc::bcsr(wei_dims, f32, p.oc_block, p.k_block);
+        auto bia_md = memory::desc({oc}, f32, fmt::x);
+        auto dst_md = memory::desc({src_dims[0], oc}, f32, fmt::nc);
+
+        auto make_pd = [&](const memory::desc &wmd) {
+            return inner_product_forward::primitive_desc(
+                    inner_product_forward::desc(prop_kind::forward_inference,
+                        src_md, wmd, bia_md, dst_md), *eng);
+        };
+        auto ref_pd = make_pd(wei_md);
+        auto sp_pd = make_pd(sp_md);
+        ASSERT_STREQ(impl_str(sp_pd.get()), "gemm:bcsr");
+
+        memory src({src_md, *eng}), wei({wei_md, *eng}), sp({sp_md, *eng});
+        memory bia({bia_md, *eng});
+        memory ref({dst_md, *eng}), res({dst_md, *eng});
+        fill(src, 3);
+        fill(bia, 4);
+        fill_pruned(wei);
+        reorder_to(wei, sp);
+
+        auto s = stream(stream::kind::eager);
+        s.submit({inner_product_forward(ref_pd, src, wei, bia, ref),
+                inner_product_forward(sp_pd, src, sp, bia, res)}).wait();
+        compare(res, ref);
+    }
+
+    bcsr_params p;
+    std::shared_ptr<engine> eng;
+};
+
+TEST_P(bcsr_test, ReorderRoundTrip) {
+    const auto f32 = memory::data_type::f32;
+    memory::dims dims = {20, 6, 3, 3};
+    auto dense_md = memory::desc(dims, f32, memory::format::oihw);
+    auto sp_md = memory::desc::bcsr(dims, f32, p.oc_block, p.k_block);
+    memory dense({dense_md, *eng}), sp({sp_md, *eng}), back({dense_md, *eng});
+    fill_pruned(dense);
+    fill(back, 5);
+    reorder_to(dense, sp);
+    reorder_to(sp, back);
+    const size_t n = dense.get_primitive_desc().get_size();
+    ASSERT_EQ(std::memcmp(data(dense), data(back), n), 0);
+}
+
+TEST_P(bcsr_test, Convolution) {
+    test_conv({2, 6, 10, 10}, {20, 6, 3, 3}, {2, 20, 10, 10}, {1, 1},
+            {1, 1}, false);
+    test_conv({1, 16, 7, 7}, {12, 16, 1, 1}, {1, 12, 7, 7}, {1, 1},
+            {0, 0}, true);
+    test_conv({3, 5, 9, 8}, {7, 5, 3, 2}, {3, 7, 4, 4}, {2, 2},
+            {0, 0}, true);
+    test_conv({2, 3, 4, 6, 6}, {9, 3, 3, 3, 3}, {2, 9, 4, 6, 6},
+            {1, 1, 1}, {1, 1, 1}, false);
+}
+
+TEST_P(bcsr_test, InnerProduct) {
+    test_ip({1, 8, 3, 3}, {12, 8, 3, 3});
+    test_ip({5, 8, 3, 3}, {12, 8, 3, 3});
+    test_ip({7, 50}, {33, 50});
+}
+
+INSTANTIATE_TEST_CASE_P(TestBcsr, bcsr_test,
+        ::testing::Values(
+            bcsr_params{ 1, 1 },
+            bcsr_params{ 2, 3 },
+            bcsr_params{ 4, 1 },
+            bcsr_params{ 8, 4 },
+            bcsr_params{ 16, 8 }));
+
+/* block-CSR weights are for inference only */
+TEST(bcsr_desc_test, RejectsTraining) {
+    mkldnn_memory_desc_t src, wei, dst;
+    const int src_dims[] = {2, 4, 5, 5}, wei_dims[] = {8, 4, 3, 3};
+    const int dst_dims[] = {2, 8, 3, 3}, strides[] = {1, 1}, pad[] = {0, 0};
+    ASSERT_EQ(mkldnn_memory_desc_init(&src, 4, src_dims, mkldnn_f32,
+                mkldnn_nchw), mkldnn_success);
+    ASSERT_EQ(mkldnn_bcsr_memory_desc_init(&wei, 4, wei_dims, mkldnn_f32,
+                4, 2), mkldnn_success);
+    ASSERT_EQ(mkldnn_memory_desc_init(&dst, 4, dst_dims, mkldnn_f32,
+                mkldnn_nchw), mkldnn_success);
+
+    mkldnn_convolution_desc_t cd;
+    ASSERT_EQ(mkldnn_convolution_forward_desc_init(&cd,
+                mkldnn_forward_inference, mkldnn_convolution_direct, &src,
+                &wei, nullptr, &dst, strides, pad, pad, mkldnn_padding_zero),
+            mkldnn_success);
+    ASSERT_EQ(mkldnn_convolution_backward_data_desc_init(&cd,
+                mkldnn_convolution_direct, &src, &wei, &dst, strides, pad,
+                pad, mkldnn_padding_zero), mkldnn_invalid_arguments);
+    ASSERT_EQ(mkldnn_convolution_backward_weights_desc_init(&cd,
+                mkldnn_convolution_direct, &src, &wei, nullptr, &dst,
+                strides, pad, pad, mkldnn_padding_zero),
+            mkldnn_invalid_arguments);
+}
+
+}
@@ -0,0 +1,378 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+namespace {
+
+inline float bf16_to_f32(uint16_t b) {
+    uint32_t u = (uint32_t)b << 16;
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+void run(const primitive &p) {
+    std::vector<primitive> pipeline;
+    pipeline.push_back(p);
+    stream(stream::kind::eager).submit(pipeline).wait();
+}
+
+memory make_memory(const memory::dims &dims, memory::data_type dt,
+        memory::format fmt, const engine &eng) {
+    return memory({{{dims}, dt, fmt}, eng});
+}
+
+size_t nelems(const memory &m) {
+    const auto &d = m.get_primitive_desc().desc().data;
+    size_t n = 1;
+    for (int i = 0; i < d.ndims; ++i) n *= d.dims[i];
+    return n;
+}
+
+/* small values with at most 8 significant bits: exact in bf16, so that the
+ * f32 and the bf16 computations start from the same numbers */
+void fill_bf16_exact(memory &m) {
+    float *p = (float *)m.get_data_handle();
+    for (size_t i = 0; i < nelems(m); ++i)
+        p[i] = (float)((int)((i * 37 + 11) % 257) - 128) / 64.f;
+}
+
+/* the same values as the f32 memory m, in bf16 */
+memory to_bf16(memory &m, const engine &eng) {
+    auto d = m.get_primitive_desc().desc();
+    auto out = memory({{{d.data.dims, d.data.dims + d.data.ndims},
+            memory::data_type::bf16,
+            (memory::format)d.data.format}, eng});
+    run(reorder(m, out));
+    return out;
+}
+
+memory to_f32(memory &m, const engine &eng) {
+    auto d = m.get_primitive_desc().desc();
+    auto out = memory({{{d.data.dims, d.data.dims + d.data.ndims},
+            memory::data_type::f32,
+            (memory::format)d.data.format}, eng});
+    run(reorder(m, out));
+    return out;
+}
+
+/* the f32 accumulation only differs from the f32 path by the order of the
+ * sums; a bf16 output adds the rounding of an 8-bit mantissa */
+void compare(memory &ref, memory &res, bool bf16_res) {
+    const float *r = (const float *)ref.get_data_handle();
+    const float *o = (const float *)res.get_data_handle();
+    for (size_t i = 0; i < nelems(ref); ++i) {
+        const float tol = (bf16_res ? 1.f / 128 : 1e-5f)
+            * std::max(1.f, std::fabs(r[i]));
+        ASSERT_NEAR(r[i], o[i], tol) << "at " << i;
+    }
+}
+
+}
+
+class bf16_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {}
+    engine eng = engine(engine::kind::cpu, 0);
+};
+
+TEST_F(bf16_test, ReorderRoundTrip) {
+    const float vals[] = { 0.f, 1.f, -2.5f, 1.f / 3, 3.14159265f, 65504.f,
+        1e-20f, -7.1e10f, 1.00390625f /* tie, rounds to even */,
+        1.01171875f /* tie, rounds up */ };
+    const int n = sizeof(vals) / sizeof(vals[0]);
+
+    auto src = make_memory({n}, memory::data_type::f32, memory::format::x,
+            eng);
+    std::memcpy(src.get_data_handle(), vals, sizeof(vals));
+
+    auto bf = to_bf16(src, eng);
+    auto back = to_f32(bf, eng);
+    const uint16_t *b = (const uint16_t *)bf.get_data_handle();
+    const float *f = (const float *)back.get_data_handle();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(bf16_to_f32(b[i]), f[i]);
+        EXPECT_NEAR(vals[i], f[i], std::fabs(vals[i]) / 256) << vals[i];
+    }
+    EXPECT_EQ(f[8], 1.f);
+    EXPECT_EQ(f[9], 1.015625f);
+
+    /* values with 8 significant bits survive the round trip exactly, in
+     * a blocked layout as well */
+    auto blk = make_memory({2, 16, 3, 3}, memory::data_type::f32,
+            memory::format::nchw, eng);
+    fill_bf16_exact(blk);
+    auto blk_bf = memory({{{{2, 16, 3, 3}}, memory::data_type::bf16,
+            memory::format::nChw8c}, eng});
+    run(reorder(blk, blk_bf));
+    auto blk_back = make_memory({2, 16, 3, 3}, memory::data_type::f32,
+            memory::format::nchw, eng);
+    run(reorder(blk_bf, blk_back));
+    compare(blk, blk_back, false);
+}
+
+TEST_F(bf16_test, InnerProductForward) {
+    const int MB = 4, IC = 40, OC = 24;
+    for (auto dst_dt : { memory::data_type::f32, memory::data_type::bf16 }) {
+        auto src = make_memory({MB, IC}, memory::data_type::f32,
+                memory::format::nc, eng);
+        auto wei = make_memory({OC, IC}, memory::data_type::f32,
+                memory::format::oi, eng);
+        auto bias = make_memory({OC}, memory::data_type::f32,
+                memory::format::x, eng);
+        auto dst = make_memory({MB, OC}, memory::data_type::f32,
+                memory::format::nc, eng);
+        fill_bf16_exact(src);
+        fill_bf16_exact(wei);
+        fill_bf16_exact(bias);
+
+        auto ref_pd = inner_product_forward::primitive_desc(
+                inner_product_forward::desc(prop_kind::forward_inference,
+                    src.get_primitive_desc().desc(),
+                    wei.get_primitive_desc().desc(),
+                    bias.get_primitive_desc().desc(),
+                    dst.get_primitive_desc().desc()), eng);
+        run(inner_product_forward(ref_pd, src, wei, bias, dst));
+
+        auto src_bf = to_bf16(src, eng);
+        auto wei_bf = to_bf16(wei, eng);
+        auto res = make_memory({MB, OC}, dst_dt, memory::format::nc, eng);
+        auto pd = inner_product_forward::primitive_desc(
+                inner_product_forward::desc(prop_kind::forward_inference,
+                    src_bf.get_primitive_desc().desc(),
+                    wei_bf.get_primitive_desc().desc(),
+                    bias.get_primitive_desc().desc(),
+                    res.get_primitive_desc().desc()), eng);
+        run(inner_product_forward(pd, src_bf, wei_bf, bias, res));
+
+        const bool bf16_res = dst_dt == memory::data_type::bf16;
+        auto res_f32 = bf16_res ? to_f32(res, eng) : res;
+        compare(dst, res_f32, bf16_res);
+    }
+}
+
+TEST_F(bf16_test, InnerProductBackward) {
+    const int MB = 8, IC = 24, OC = 16;
+    auto src = make_memory({MB, IC}, memory::data_type::f32,
+            memory::format::nc, eng);
+    auto wei = make_memory({OC, IC}, memory::data_type::f32,
+            memory::format::oi, eng);
+    auto diff_dst = make_memory({MB, OC}, memory::data_type::f32,
+            memory::format::nc, eng);
+    fill_bf16_exact(src);
+    fill_bf16_exact(wei);
+    fill_bf16_exact(diff_dst);
+    auto src_bf = to_bf16(src, eng);
+    auto wei_bf = to_bf16(wei, eng);
+    auto diff_dst_bf = to_bf16(diff_dst, eng);
+
+    auto fwd_desc = [&](const memory &s, const memory &w, const memory &d) {
+        return inner_product_forward::desc(prop_kind::forward_training,
+                s.get_primitive_desc().desc(), w.get_primitive_desc().desc(),
+                d.get_primitive_desc().desc());
+    };
+
+    /* backward data */
+    auto diff_src = make_memory({MB, IC}, memory::data_type::f32,
+            memory::format::nc, eng);
+    auto diff_src_bf = make_memory({MB, IC}, memory::data_type::f32,
+            memory::format::nc, eng);
+    {
+        auto hint = inner_product_forward::primitive_desc(
+                fwd_desc(src, wei, diff_dst), eng);
+        auto pd = inner_product_backward_data::primitive_desc(
+                inner_product_backward_data::desc(
+                    diff_src.get_primitive_desc().desc(),
+                    wei.get_primitive_desc().desc(),
+                    diff_dst.get_primitive_desc().desc()), eng, hint);
+        run(inner_product_backward_data(pd, diff_dst, wei, diff_src));
+
+        auto hint_bf = inner_product_forward::primitive_desc(
+                fwd_desc(src_bf, wei_bf, diff_dst_bf), eng);
+        auto pd_bf = inner_product_backward_data::primitive_desc(
+                inner_product_backward_data::desc(
+                    diff_src_bf.get_primitive_desc().desc(),
+                    wei_bf.get_primitive_desc().desc(),
+                    diff_dst_bf.get_primitive_desc().desc()), eng, hint_bf);
+        run(inner_product_backward_data(pd_bf, diff_dst_bf, wei_bf,
+                    diff_src_bf));
+    }
+    compare(diff_src, diff_src_bf, false);
+
+    /* backward weights, bf16 diff_weights and f32 diff_bias */
+    auto diff_wei = make_memory({OC, IC}, memory::data_type::f32,
+            memory::format::oi, eng);
+    auto diff_bias = make_memory({OC}, memory::data_type::f32,
+            memory::format::x, eng);
+    auto diff_wei_bf = make_memory({OC, IC}, memory::data_type::bf16,
+            memory::format::oi, eng);
+    auto diff_bias_bf = make_memory({OC}, memory::data_type::f32,
+            memory::format::x, eng);
+    {
+        auto hint = inner_product_forward::primitive_desc(
+                fwd_desc(src, wei, diff_dst), eng);
+        auto pd = inner_product_backward_weights::primitive_desc(
+                inner_product_backward_weights::desc(
+                    src.get_primitive_desc().desc(),
+                    diff_wei.get_primitive_desc().desc(),
+                    diff_bias.get_primitive_desc().desc(),
+                    diff_dst.get_primitive_desc().desc()), eng, hint);
+        run(inner_product_backward_weights(pd, src, diff_dst, diff_wei,
+                    diff_bias));
+
+        auto hint_bf = inner_product_forward::primitive_desc(
+                fwd_desc(src_bf, wei_bf, diff_dst_bf), eng);
+        auto pd_bf = inner_product_backward_weights::primitive_desc(
+                inner_product_backward_weights::desc(
+                    src_bf.get_primitive_desc().desc(),
+                    diff_wei_bf.get_primitive_desc().desc(),
+                    diff_bias_bf.get_primitive_desc().desc(),
+                    diff_dst_bf.get_primitive_desc().desc()), eng, hint_bf);
+        run(inner_product_backward_weights(pd_bf, src_bf, diff_dst_bf,
+                    diff_wei_bf, diff_bias_bf));
+    }
+    auto diff_wei_bf_f32 = to_f32(diff_wei_bf, eng);
+    compare(diff_wei, diff_wei_bf_f32, true);
+    compare(diff_bias, diff_bias_bf, false);
+}
+
+TEST_F(bf16_test, ConvolutionForward) {
+    const int MB = 2, IC = 8, OC = 16, IH = 7, IW = 9;
+    /* 3x3 padded (im2col) and 1x1 (the gemm reads src directly) */
+    for (int k : { 3, 1 })
+    for (auto dst_dt : { memory::data_type::f32, memory::data_type::bf16 }) {
+        SCOPED_TRACE(k);
+        SCOPED_TRACE((int)dst_dt);
+        const int p = k / 2;
+        auto src = make_memory({MB, IC, IH, IW}, memory::data_type::f32,
+                memory::format::nchw, eng);
+        auto wei = make_memory({OC, IC, k, k}, memory::data_type::f32,
+                memory::format::oihw, eng);
+        auto bias = make_memory({OC}, memory::data_type::f32,
+                memory::format::x, eng);
+        auto dst = make_memory({MB, OC, IH, IW}, memory::data_type::f32,
+                memory::format::nchw, eng);
+        fill_bf16_exact(src);
+        fill_bf16_exact(wei);
+        fill_bf16_exact(bias);
+
+        auto conv_pd = [&](const memory &s, const memory &w,
+                const memory &d) {
+            return convolution_forward::primitive_desc(
+                    convolution_forward::desc(prop_kind::forward_inference,
+                        algorithm::convolution_direct,
+                        s.get_primitive_desc().desc(),
+                        w.get_primitive_desc().desc(),
+                        bias.get_primitive_desc().desc(),
+                        d.get_primitive_desc().desc(),
+                        {1, 1}, {p, p}, {p, p}, padding_kind::zero), eng);
+        };
+        run(convolution_forward(conv_pd(src, wei, dst), src, wei, bias,
+                    dst));
+
+        auto src_bf = to_bf16(src, eng);
+        auto wei_bf = to_bf16(wei, eng);
+        auto res = make_memory({MB, OC, IH, IW}, dst_dt,
+                memory::format::nchw, eng);
+        run(convolution_forward(conv_pd(src_bf, wei_bf, res), src_bf, wei_bf,
+                    bias, res));
+
+        const bool bf16_res = dst_dt == memory::data_type::bf16;
+        auto res_f32 = bf16_res ? to_f32(res, eng) : res;
+        compare(dst, res_f32, bf16_res);
+    }
+}
+
+TEST_F(bf16_test, EltwisePoolingBatchNormalization) {
+    const int MB = 2, C = 8, H = 6, W = 6;
+    auto src = make_memory({MB, C, H, W}, memory::data_type::f32,
+            memory::format::nchw, eng);
+    fill_bf16_exact(src);
+    auto src_bf = to_bf16(src, eng);
+    auto src_md = src.get_primitive_desc().desc();
+    auto src_bf_md = src_bf.get_primitive_desc().desc();
+
+    /* relu and max pooling of exact values are exact */
+    {
+        auto dst = make_memory({MB, C, H, W}, memory::data_type::f32,
+                memory::format::nchw, eng);
+        auto dst_bf = make_memory({MB, C, H, W}, memory::data_type::bf16,
+                memory::format::nchw, eng);
+        run(eltwise_forward(eltwise_forward::primitive_desc(
+                    eltwise_forward::desc(prop_kind::forward_inference,
+                        algorithm::eltwise_relu, src_md, 0.f), eng),
+                    src, dst));
+        run(eltwise_forward(eltwise_forward::primitive_desc(
+                    eltwise_forward::desc(prop_kind::forward_inference,
+                        algorithm::eltwise_relu, src_bf_md, 0.f), eng),
+                    src_bf, dst_bf));
+        auto res = to_f32(dst_bf, eng);
+        compare(dst, res, false);
+    }
+    {
+        auto pool_pd = [&](const memory::desc &s, memory::data_type dt) {
+            return pooling_forward::primitive_desc(
+                    pooling_forward::desc(prop_kind::forward_inference,
+                        algorithm::pooling_max, s,
+                        {{MB, C, H / 2, W / 2}, dt, memory::format::nchw},
+                        {2, 2}, {2, 2}, {0, 0}, {0, 0}, padding_kind::zero),
+                    eng);
+        };
+        auto pd = pool_pd(src_md, memory::data_type::f32);
+        auto pd_bf = pool_pd(src_bf_md, memory::data_type::bf16);
+        memory dst(pd.dst_primitive_desc()), dst_bf(pd_bf.dst_primitive_desc());
+        run(pooling_forward(pd, src, dst));
+        run(pooling_forward(pd_bf, src_bf, dst_bf));
+        auto res = to_f32(dst_bf, eng);
+        compare(dst, res, false);
+    }
+    /* batch normalization keeps its statistics in f32 */
+    {
+        const unsigned flags = 0;
+        auto pd = batch_normalization_forward::primitive_desc(
+                batch_normalization_forward::desc(
+                    prop_kind::forward_training, src_md, 1e-5f, flags), eng);
+        auto pd_bf = batch_normalization_forward::primitive_desc(
+                batch_normalization_forward::desc(
+                    prop_kind::forward_training, src_bf_md, 1e-5f, flags),
+                eng);
+        ASSERT_EQ(pd_bf.mean_primitive_desc().desc().data.data_type,
+                mkldnn_f32);
+        memory dst(pd.dst_primitive_desc()), dst_bf(pd_bf.dst_primitive_desc());
+        memory mean(pd.mean_primitive_desc()),
+               var(pd.variance_primitive_desc());
+        memory mean_bf(pd_bf.mean_primitive_desc()),
+               var_bf(pd_bf.variance_primitive_desc());
+        run(batch_normalization_forward(pd, src, dst, mean, var));
+        run(batch_normalization_forward(pd_bf, src_bf, dst_bf, mean_bf,
+                    var_bf));
+        compare(mean, mean_bf, false);
+        compare(var, var_bf, false);
+        auto res = to_f32(dst_bf, eng);
+        compare(dst, res, true);
+    }
+}
+
+}
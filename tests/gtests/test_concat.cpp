@@ -30,6 +30,7 @@ struct concat_test_params {
     memory::dims dst_cds;
     bool expect_to_fail;
     mkldnn_status_t expected_status;
+    bool in_place; // sources are written into the slots of dst
 };
 
 template <typename data_t>
@@ -138,9 +139,19 @@ protected:
             (data_t *)dst.get_data_handle());
         check_zero_tail<data_t>(1, dst);
 
+        std::vector<primitive> pipeline;
         std::vector<primitive::at> inputs;
+        std::vector<memory> images;
         for (size_t i = 0; i < p.srcs_cds.size(); i++) {
-            inputs.push_back(srcs[i]);
+            if (p.in_place) {
+                /* the reorder plays the producer writing into dst */
+                images.push_back(memory(concat_pd.src_image_primitive_desc(
+                            (int)i), dst.get_data_handle()));
+                pipeline.push_back(reorder(srcs[i], images.back()));
+                inputs.push_back(images.back());
+            } else {
+                inputs.push_back(srcs[i]);
+            }
         }
         auto c = concat(concat_pd, inputs, dst);
 
@@ -149,7 +160,6 @@ protected:
         ASSERT_EQ(concat_pd.dst_primitive_desc().desc().data.ndims,
                 dst_desc.data.ndims);
 
-        std::vector<primitive> pipeline;
         pipeline.push_back(c);
         auto s = stream(stream::kind::eager);
         s.submit(pipeline).wait();
@@ -261,7 +271,30 @@ INSTANTIATE_TEST_CASE_P(TestConcat, concat_test_float, ::testing::Values(
     {{2, 16, 1, 1}, {2, 16, 1, 1}}, {2, 32, 1, 1}},
     concat_test_params{engine::kind::cpu, 0,
     {memory::format::nchw, memory::format::nchw}, memory::format::nchw,
-    {{2, 8, 3, 4}, {2, 8, 3, 4}}, {4, 8, 3, 4}}
+    {{2, 8, 3, 4}, {2, 8, 3, 4}}, {4, 8, 3, 4}},
+    // producers write into dst, concat copies nothing
+    concat_test_params{engine::kind::cpu, 1,
+    {memory::format::nchw, memory::format::nchw}, memory::format::nchw,
+    {{2, 8, 3, 4}, {2, 5, 3, 4}}, {2, 13, 3, 4}, false, mkldnn_success, true},
+    concat_test_params{engine::kind::cpu, 1,
+    {memory::format::nChw8c, memory::format::nChw8c}, memory::format::nChw8c,
+    {{2, 16, 3, 4}, {2, 8, 3, 4}}, {2, 24, 3, 4}, false, mkldnn_success, true},
+    concat_test_params{engine::kind::cpu, 1,
+    {memory::format::nChw8c, memory::format::nChw8c}, memory::format::nChw8c,
+    {{2, 8, 3, 4}, {2, 3, 3, 4}}, {2, 11, 3, 4}, false, mkldnn_success, true},
+    // large enough to be split between threads
+    concat_test_params{engine::kind::cpu, 1,
+    {memory::format::nChw16c, memory::format::nChw16c, memory::format::nChw16c},
+    memory::format::nChw16c,
+    {{2, 16, 28, 28}, {2, 32, 28, 28}, {2, 16, 28, 28}}, {2, 64, 28, 28}},
+    concat_test_params{engine::kind::cpu, 1,
+    {memory::format::nhwc, memory::format::nhwc, memory::format::nhwc},
+    memory::format::nhwc,
+    {{2, 3, 28, 28}, {2, 40, 28, 28}, {2, 7, 28, 28}}, {2, 50, 28, 28}},
+    concat_test_params{engine::kind::cpu, 0,
+    {memory::format::nchw, memory::format::nchw, memory::format::nchw},
+    memory::format::nchw,
+    {{3, 16, 28, 28}, {1, 16, 28, 28}, {2, 16, 28, 28}}, {6, 16, 28, 28}}
 ));
 
 #if MKLDNN_JIT_TYPES > 0
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+/* Stress test of the concurrent execution of a single primitive: each thread
+ * runs the same primitive (through primitive::execute() on its own buffers)
+ * many times and must get the result of a sequential run on the same data.
+ * The cases use a scratchpad (gemm convolution, batch normalization), which
+ * is where a primitive used to keep execution state. */
+class concurrent_execute_test: public ::testing::Test {
+protected:
+    enum { nthr = 8, niter = 25 };
+
+    typedef std::vector<float> buf_t;
+
+    virtual void SetUp() { eng.reset(new engine(engine::kind::cpu, 0)); }
+
+    static buf_t make_buf(const memory &m, int seed) {
+        buf_t buf(m.get_primitive_desc().get_size() / sizeof(float));
+        for (size_t i = 0; i < buf.size(); ++i)
+            buf[i] = (float)((i * 13 + seed * 7) % 17) / 8.f - 1.f;
+        return buf;
+    }
+
+    static std::vector<primitive::arg> bind(const std::vector<memory> &mems,
+            std::vector<buf_t> &bufs) {
+        std::vector<primitive::arg> args;
+        for (size_t i = 0; i < mems.size(); ++i)
+            args.push_back(primitive::arg(mems[i], &bufs[i][0]));
+        return args;
+    }
+
+    void stress(const primitive &p, const std::vector<memory> &ins,
+            const memory &out) {
+        std::vector<std::vector<buf_t>> in_bufs(nthr);
+        std::vector<buf_t> ref(nthr), res(nthr);
+        for (int t = 0; t < nthr; ++t) {
+            for (size_t i = 0; i < ins.size(); ++i)
+                in_bufs[t].push_back(make_buf(ins[i], t + (int)i));
+            std::vector<buf_t> out_buf(1, buf_t(make_buf(out, 0).size()));
+            auto args = bind(ins, in_bufs[t]);
+            args.push_back(primitive::arg(out, &out_buf[0][0]));
+            p.execute(args);
+            ref[t] = out_buf[0];
+            res[t].assign(ref[t].size(), 0.f);
+        }
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nthr; ++t)
+            threads.emplace_back([&, t]() {
+                auto args = bind(ins, in_bufs[t]);
+                args.push_back(primitive::arg(out, &res[t][0]));
+                for (int it = 0; it < niter; ++it)
+                    p.execute(args);
+            });
+        for (auto &th: threads) th.join();
+
+        for (int t = 0; t < nthr; ++t)
+            for (size_t i = 0; i < ref[t].size(); ++i)
+                ASSERT_NEAR(res[t][i], ref[t][i],
+                        1e-5f * (1.f + std::fabs(ref[t][i])))
+                    << "thread " << t << " at " << i;
+    }
+
+    std::shared_ptr<engine> eng;
+};
+
+TEST_F(concurrent_execute_test, GemmConvolution) {
+    using fmt = memory::format;
+    const auto f32 = memory::data_type::f32;
+    auto src_md = memory::desc({2, 3, 9, 9}, f32, fmt::nchw);
+    auto wei_md = memory::desc({8, 3, 3, 3}, f32, fmt::oihw);
+    auto bia_md = memory::desc({8}, f32, fmt::x);
+    auto dst_md = memory::desc({2, 8, 9, 9}, f32, fmt::nchw);
+    auto conv_pd = convolution_forward::primitive_desc(
+            convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md, wei_md, bia_md, dst_md,
+                {1, 1}, {1, 1}, {1, 1}, padding_kind::zero), *eng);
+
+    memory src({src_md, *eng}), wei({wei_md, *eng}), bia({bia_md, *eng});
+    memory dst({dst_md, *eng});
+    convolution_forward conv(conv_pd, src, wei, bia, dst);
+    stress(conv, {src, wei, bia}, dst);
+}
+
+TEST_F(concurrent_execute_test, BatchNormalization) {
+    for (auto f: {memory::format::nchw, memory::format::nhwc,
+                memory::format::nChw16c}) {
+        auto md = memory::desc({4, 16, 5, 5}, memory::data_type::f32, f);
+        auto bn_pd = batch_normalization_forward::primitive_desc(
+                batch_normalization_forward::desc(
+                    prop_kind::forward_inference, md, 1e-5f, 0u), *eng);
+
+        memory src({md, *eng}), dst({md, *eng});
+        batch_normalization_forward bn(bn_pd, src, dst);
+        stress(bn, {src}, dst);
+    }
+}
+
+}
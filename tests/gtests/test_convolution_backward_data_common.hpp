@@ -39,6 +39,10 @@ void compute_ref_conv_bwd_data(const test_convolution_sizes_t &c,
 
     size_t padded_ic = diff_src_d.data.layout_desc.blocking.padding_dims[1];
     size_t padded_oc = diff_dst_d.data.layout_desc.blocking.padding_dims[1];
+    /* the channels of the groups follow each other in the data, while the
+     * weights are padded per group (e.g. Goihw8g pads the groups) */
+    const int *w_pdims = weights_d.data.layout_desc.blocking.padding_dims;
+    size_t w_oc = w_pdims[(c.ng > 1) + 0], w_ic = w_pdims[(c.ng > 1) + 1];
 
     OMP(parallel for collapse(5) schedule(static))//;
     for (int mb = 0; mb < c.mb; ++mb) {
@@ -47,8 +51,8 @@ void compute_ref_conv_bwd_data(const test_convolution_sizes_t &c,
                 for (int ih = 0; ih < c.ih; ++ih) {
                     for (int iw = 0; iw < c.iw; ++iw) {
                         size_t sidx = mb * padded_ic * c.ih * c.iw
-                                + g * padded_ic / c.ng * c.ih * c.iw
-                                + ic * c.ih * c.iw + ih * c.iw + iw;
+                                + (g * c.ic / c.ng + ic) * c.ih * c.iw
+                                + ih * c.iw + iw;
                         data_t_acc a = data_t_acc(0);
                         for (int oc = 0; oc < c.oc / c.ng; oc++) {
                             for (int kh = 0; kh < c.kh; kh++) {
@@ -64,13 +68,11 @@ void compute_ref_conv_bwd_data(const test_convolution_sizes_t &c,
                                     oh /= c.strh;
                                     if (oh < c.oh && ow < c.ow) {
                                         size_t didx = mb * padded_oc * c.oh * c.ow
-                                            + g * padded_oc / c.ng * c.oh * c.ow
-                                            + oc * c.oh * c.ow + oh * c.ow + ow;
+                                            + (g * c.oc / c.ng + oc) * c.oh * c.ow
+                                            + oh * c.ow + ow;
                                         size_t widx =
-                                            g * padded_oc / c.ng * padded_ic
-                                            / c.ng * c.kh * c.kw
-                                            + oc * padded_ic / c.ng * c.kh * c.kw
-                                            + ic * c.kh * c.kw + kh * c.kw + kw;
+                                            ((g * w_oc + oc) * w_ic + ic)
+                                            * c.kh * c.kw + kh * c.kw + kw;
 
                                         a += (data_t_acc)(
                                             diff_dst_data[map_index(diff_dst_d, didx)]
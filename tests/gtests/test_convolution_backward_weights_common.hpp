@@ -41,14 +41,14 @@ void compute_ref_conv_bwd_bias(const test_convolution_sizes_t &c,
     OMP(parallel for collapse(2) schedule(static))//;
     for (int g = 0; g < c.ng; ++g) {
         for (int oc = 0; oc < c.oc / c.ng; ++oc) {
-            size_t bidx = g * padded_oc / c.ng + oc;
+            size_t bidx = g * c.oc / c.ng + oc;
             diff_bias_data[map_index(bias_d, bidx)] = 0.0;
             for (int mb = 0; mb < c.mb; ++mb) {
                 for (int oh = 0; oh < c.oh; ++oh) {
                     for (int ow = 0; ow < c.ow; ++ow) {
                         size_t oidx = mb * padded_oc * c.oh * c.ow
-                                + g * padded_oc / c.ng * c.oh * c.ow
-                                + oc * c.oh * c.ow + oh * c.ow + ow;
+                                + (g * c.oc / c.ng + oc) * c.oh * c.ow
+                                + oh * c.ow + ow;
                         diff_bias_data[map_index(bias_d, bidx)]
                             += diff_dst_data[map_index(dst_d, oidx)];
                     }
@@ -75,6 +75,10 @@ void compute_ref_conv_bwd_weights(const test_convolution_sizes_t &c,
 
     size_t padded_ic = src_d.data.layout_desc.blocking.padding_dims[1];
     size_t padded_oc = dst_d.data.layout_desc.blocking.padding_dims[1];
+    /* the channels of the groups follow each other in the data, while the
+     * weights are padded per group (e.g. Goihw8g pads the groups) */
+    const int *w_pdims = weights_d.data.layout_desc.blocking.padding_dims;
+    size_t w_oc = w_pdims[(c.ng > 1) + 0], w_ic = w_pdims[(c.ng > 1) + 1];
 
     OMP(parallel for collapse(5) schedule(static))//;
     for (int g = 0; g < c.ng; ++g) {
@@ -82,10 +86,8 @@ void compute_ref_conv_bwd_weights(const test_convolution_sizes_t &c,
             for (int ic = 0; ic < c.ic / c.ng; ++ic) {
                 for (int kh = 0; kh < c.kh; kh++) {
                     for (int kw = 0; kw < c.kw; kw++) {
-                        size_t widx = g * padded_oc / c.ng * padded_ic / c.ng *
-                                c.kh * c.kw
-                                + oc * padded_ic / c.ng * c.kh * c.kw
-                                + ic * c.kh * c.kw + kh * c.kw + kw;
+                        size_t widx = ((g * w_oc + oc) * w_ic + ic)
+                                * c.kh * c.kw + kh * c.kw + kw;
                         diff_weights_data[map_index(weights_d, widx)] = 0.0;
                         for (int mb = 0; mb < c.mb; ++mb) {
                             for (int oh = 0; oh < c.oh; ++oh) {
@@ -105,11 +107,11 @@ void compute_ref_conv_bwd_weights(const test_convolution_sizes_t &c,
                                     int iw = ow * c.strw - c.padw + kw
                                             * (1 + c.dilw);
                                     size_t sidx = mb * padded_ic * c.ih * c.iw
-                                        + g * padded_ic / c.ng * c.ih * c.iw
-                                        + ic * c.ih * c.iw + ih * c.iw + iw;
+                                        + (g * c.ic / c.ng + ic) * c.ih * c.iw
+                                        + ih * c.iw + iw;
                                     size_t didx = mb * padded_oc * c.oh * c.ow
-                                        + g * padded_oc / c.ng * c.oh * c.ow
-                                        + oc * c.oh * c.ow + oh * c.ow + ow;
+                                        + (g * c.oc / c.ng + oc) * c.oh * c.ow
+                                        + oh * c.ow + ow;
 
                                     diff_weights_data[map_index(weights_d, widx)]
                                         += src_data[map_index(src_d, sidx)]
@@ -49,6 +49,10 @@ void compute_ref_conv_fwd(const test_convolution_sizes_t &c,
 
     size_t padded_ic = src_d.data.layout_desc.blocking.padding_dims[1];
     size_t padded_oc = dst_d.data.layout_desc.blocking.padding_dims[1];
+    /* the channels of the groups follow each other in the data, while the
+     * weights are padded per group (e.g. Goihw8g pads the groups) */
+    const int *w_pdims = weights_d.data.layout_desc.blocking.padding_dims;
+    size_t w_oc = w_pdims[(c.ng > 1) + 0], w_ic = w_pdims[(c.ng > 1) + 1];
 
     OMP(parallel for collapse(5) schedule(static))//;
     for (int n = 0; n < c.mb; n++) {
@@ -67,12 +71,10 @@ void compute_ref_conv_fwd(const test_convolution_sizes_t &c,
                                     if (iw < 0 || iw >= c.iw) continue;
                                     if (ih < 0 || ih >= c.ih) continue;
                                     size_t iidx = n * padded_ic * c.ih * c.iw
-                                        + g * padded_ic / c.ng * c.ih * c.iw
-                                        + ic * c.ih * c.iw + ih * c.iw + iw;
-                                    size_t widx = g * padded_oc / c.ng * padded_ic
-                                        / c.ng * c.kh * c.kw
-                                        + oc * padded_ic / c.ng * c.kh * c.kw
-                                        + ic * c.kh * c.kw + kh * c.kw + kw;
+                                        + (g * c.ic / c.ng + ic) * c.ih * c.iw
+                                        + ih * c.iw + iw;
+                                    size_t widx = ((g * w_oc + oc) * w_ic + ic)
+                                        * c.kh * c.kw + kh * c.kw + kw;
                                     a += ((data_t_acc)
                                         src_data[map_index(src_d, iidx)])
                                         *  weights_data[map_index(
@@ -107,8 +109,8 @@ void compute_ref_conv_fwd(const test_convolution_sizes_t &c,
                         }
 
                         size_t oidx = n * padded_oc * c.oh * c.ow
-                                 + g * padded_oc / c.ng * c.oh * c.ow
-                                 + oc * c.oh * c.ow + oh * c.ow + ow;
+                                 + (g * c.oc / c.ng + oc) * c.oh * c.ow
+                                 + oh * c.ow + ow;
                         dst_data[map_index(dst_d, oidx)] = (data_t_dst)a_fp;
                     }
                 }
@@ -442,6 +442,19 @@ INST_TEST_CASE(SimpleSmall_NCHW,
 
 );
 
+INST_TEST_CASE(SimpleSmall_Strided,
+    PARAMS(nchw, oihw, x, nchw,
+        2, 1, 6, 4, 4, 4, 7, 7, 3, 3, 1, 1, 2, 2),
+    PARAMS(nchw, oihw, x, nchw,
+        2, 1, 6, 4, 5, 4, 8, 11, 2, 3, 0, 0, 2, 2),
+    PARAMS(nchw, goihw, x, nchw,
+        2, 2, 6, 4, 4, 4, 8, 8, 2, 2, 0, 0, 2, 2),
+    PARAMS(nchw, oihw, x, nchw,
+        2, 1, 6, 6, 5, 4, 17, 14, 2, 2, 0, 0, 3, 3),
+    PARAMS(nhwc, hwio, x, nhwc,
+        2, 1, 6, 4, 4, 4, 7, 7, 3, 3, 1, 1, 2, 2)
+);
+
 #if MKLDNN_JIT_TYPES > 0
 #define FMT_BIAS x
 #define FMT_DATA_BLOCKED nChw8c
@@ -0,0 +1,76 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "idiv.hpp"
+
+namespace mkldnn {
+
+struct window_taps_params {
+    int O, I, K, S, P, DD;
+};
+
+/* every view of window_taps_t must enumerate exactly the (o, k) pairs that
+ * the bounds checked loops of the reference kernels accept */
+class window_taps_test
+    : public ::testing::TestWithParam<window_taps_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<window_taps_params>::GetParam();
+        const impl::window_taps_t taps(p.O, p.I, p.K, p.S, p.P, p.DD);
+        auto valid = [&](int o, int k) {
+            const int i = o * p.S - p.P + k * p.DD;
+            return i >= 0 && i < p.I;
+        };
+
+        for (int o = 0; o < p.O; ++o)
+        for (int k = 0; k < p.K; ++k)
+            ASSERT_EQ(valid(o, k), k >= taps.k_beg(o) && k < taps.k_end(o));
+
+        for (int k = 0; k < p.K; ++k)
+        for (int o = 0; o < p.O; ++o)
+            ASSERT_EQ(valid(o, k), o >= taps.o_beg(k) && o < taps.o_end(k));
+
+        for (int i = 0; i < p.I; ++i) {
+            int n = 0;
+            for (int k = 0; k < p.K; ++k) {
+                const int o = i + p.P - k * p.DD;
+                if (o < 0 || o % p.S != 0 || o / p.S >= p.O) continue;
+                ASSERT_LT(n, taps.bn(i));
+                ASSERT_EQ(k, taps.bk_beg(i) + n * taps.bk_step());
+                ASSERT_EQ(o / p.S, taps.bo_beg(i) - n * taps.bo_step());
+                ++n;
+            }
+            ASSERT_EQ(n, taps.bn(i));
+        }
+    }
+};
+
+TEST_P(window_taps_test, TestsWindowTaps) {}
+
+INSTANTIATE_TEST_CASE_P(TestWindowTaps, window_taps_test,
+        ::testing::Values(
+            window_taps_params{ 7, 7, 3, 1, 1, 1 },
+            window_taps_params{ 4, 8, 3, 2, 1, 1 },
+            window_taps_params{ 5, 13, 3, 3, 0, 1 },
+            window_taps_params{ 6, 12, 5, 2, 2, 2 },
+            window_taps_params{ 9, 9, 3, 1, 4, 3 },
+            window_taps_params{ 3, 11, 4, 4, 3, 6 },
+            window_taps_params{ 2, 3, 7, 1, 5, 1 },
+            window_taps_params{ 1, 1, 1, 1, 0, 1 }));
+
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+class profiling_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        size_t count = 0;
+        mkldnn_profiling_get_records(nullptr, &count);
+        std::vector<mkldnn_profiling_record_t> drop(count + 1);
+        mkldnn_profiling_get_records(&drop[0], &count);
+    }
+    virtual void TearDown() {
+        mkldnn_profiling_enable(0, 0);
+        mkldnn_profiling_set_callback(nullptr, nullptr);
+    }
+
+    void run_relu() {
+        auto eng = engine(engine::kind::cpu, 0);
+        memory::desc md({2, 16, 4, 4}, memory::data_type::f32,
+                memory::format::nchw);
+        memory src({md, eng}), dst({md, eng});
+        auto relu_d = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, md, 0.f);
+        auto relu_pd = eltwise_forward::primitive_desc(relu_d, eng);
+        std::vector<primitive> pipeline;
+        pipeline.push_back(eltwise_forward(relu_pd, src, dst));
+        stream(stream::kind::eager).submit(pipeline).wait();
+    }
+};
+
+static void count_exec(const mkldnn_profiling_record_t *r, void *user_data) {
+    if (r->event_kind == mkldnn_profiling_exec) ++*(int *)user_data;
+}
+
+TEST_F(profiling_test, DisabledByDefault) {
+    run_relu();
+    size_t count = 0;
+    mkldnn_profiling_get_records(nullptr, &count);
+    EXPECT_EQ(count, 0U);
+}
+
+TEST_F(profiling_test, RecordsCreateAndExec) {
+    int n_exec = 0;
+    mkldnn_profiling_set_callback(count_exec, &n_exec);
+    mkldnn_profiling_enable(1, 16);
+    run_relu();
+    mkldnn_profiling_enable(0, 0);
+    run_relu();
+    EXPECT_EQ(n_exec, 1);
+
+    mkldnn_profiling_record_t records[16];
+    size_t count = 16;
+    ASSERT_EQ(mkldnn_profiling_get_records(records, &count), mkldnn_success);
+    ASSERT_EQ(count, 2U);
+
+    EXPECT_EQ(records[0].event_kind, mkldnn_profiling_create);
+    EXPECT_EQ(records[1].event_kind, mkldnn_profiling_exec);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(records[i].primitive_kind, mkldnn_eltwise);
+        EXPECT_EQ(strncmp(records[i].info, "eltwise,", 8), 0);
+        EXPECT_NE(strstr(records[i].info, records[i].impl_name), nullptr);
+        EXPECT_EQ(records[i].bytes, 2. * 2 * 16 * 4 * 4 * sizeof(float));
+        EXPECT_EQ(records[i].flops, 2. * 16 * 4 * 4);
+        EXPECT_GE(records[i].duration_ms, 0.);
+        EXPECT_GE(records[i].nthr, 1);
+    }
+
+    count = 16;
+    mkldnn_profiling_get_records(records, &count);
+    EXPECT_EQ(count, 0U);
+}
+
+TEST_F(profiling_test, RingBufferKeepsMostRecent) {
+    mkldnn_profiling_enable(1, 3);
+    run_relu();
+    run_relu();
+    mkldnn_profiling_enable(0, 0);
+
+    mkldnn_profiling_record_t records[4];
+    size_t count = 4;
+    mkldnn_profiling_get_records(records, &count);
+    ASSERT_EQ(count, 3U);
+    EXPECT_EQ(records[0].event_kind, mkldnn_profiling_exec);
+    EXPECT_EQ(records[1].event_kind, mkldnn_profiling_create);
+    EXPECT_EQ(records[2].event_kind, mkldnn_profiling_exec);
+}
+
+TEST_F(profiling_test, ChromeTrace) {
+    mkldnn_profiling_enable(1, 16);
+    run_relu();
+    mkldnn_profiling_enable(0, 0);
+
+    const char *path = "test_iface_profiling.json";
+    ASSERT_EQ(mkldnn_profiling_dump_chrome_trace(path), mkldnn_success);
+    FILE *f = fopen(path, "r");
+    ASSERT_NE(f, nullptr);
+    char buf[4096] = {0};
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    remove(path);
+
+    EXPECT_GT(len, 0U);
+    EXPECT_EQ(strncmp(buf, "{\"traceEvents\":[", 16), 0);
+    EXPECT_NE(strstr(buf, "\"cat\":\"exec\""), nullptr);
+    EXPECT_NE(strstr(buf, "\"cat\":\"create\""), nullptr);
+}
+
+}
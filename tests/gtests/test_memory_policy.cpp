@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct memory_policy_params {
+    mkldnn_hugepages_policy_t hugepages;
+    mkldnn_numa_policy_t numa;
+};
+
+/* every policy must give aligned, usable buffers: the placement itself is
+ * only advice and is not observable here */
+class memory_policy_test
+    : public ::testing::TestWithParam<memory_policy_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<memory_policy_params>::GetParam();
+        ASSERT_EQ(mkldnn_memory_policy_set(p.hugepages, p.numa, 0),
+                mkldnn_success);
+
+        const size_t sizes[] = { 64, 3 * 1024 * 1024 + 5, 8 * 1024 * 1024 };
+        const size_t aligns[] = { 64, 4096, 2 * 1024 * 1024 };
+        for (size_t size: sizes)
+        for (size_t align: aligns) {
+            char *ptr = (char *)mkldnn_malloc(size, align);
+            ASSERT_NE(ptr, nullptr);
+            ASSERT_EQ((uintptr_t)ptr % align, 0u);
+            memset(ptr, 0x5a, size);
+            ASSERT_EQ(ptr[size - 1], 0x5a);
+            mkldnn_free(ptr);
+        }
+
+        auto eng = engine(engine::kind::cpu, 0);
+        auto mem = memory({{{{ 4, 64, 56, 56 }}, memory::data_type::f32,
+                memory::format::nchw}, eng});
+        float *data = (float *)mem.get_data_handle();
+        const size_t nelems = 4 * 64 * 56 * 56;
+        for (size_t i = 0; i < nelems; ++i) data[i] = (float)i;
+        ASSERT_EQ(data[nelems - 1], (float)(nelems - 1));
+
+        ASSERT_EQ(mkldnn_memory_policy_set(mkldnn_hugepages_none,
+                    mkldnn_numa_default, 0), mkldnn_success);
+    }
+};
+
+TEST(memory_policy_args_test, TestsInvalidArguments) {
+    EXPECT_EQ(mkldnn_memory_policy_set(mkldnn_hugepages_none,
+                mkldnn_numa_bind, -1), mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_memory_policy_set((mkldnn_hugepages_policy_t)7,
+                mkldnn_numa_default, 0), mkldnn_invalid_arguments);
+    EXPECT_EQ(mkldnn_memory_policy_set(mkldnn_hugepages_none,
+                (mkldnn_numa_policy_t)7, 0), mkldnn_invalid_arguments);
+    mkldnn_free(nullptr);
+}
+
+TEST_P(memory_policy_test, TestsAllocations) {}
+
+INSTANTIATE_TEST_CASE_P(TestMemoryPolicy, memory_policy_test,
+        ::testing::Values(
+            memory_policy_params{ mkldnn_hugepages_none, mkldnn_numa_default },
+            memory_policy_params{ mkldnn_hugepages_thp, mkldnn_numa_default },
+            memory_policy_params{ mkldnn_hugepages_hugetlb,
+                mkldnn_numa_default },
+            memory_policy_params{ mkldnn_hugepages_none,
+                mkldnn_numa_interleave },
+            memory_policy_params{ mkldnn_hugepages_thp, mkldnn_numa_bind }));
+
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.h"
+#include "offset_calc.hpp"
+
+namespace mkldnn {
+
+struct offset_calc_params {
+    mkldnn_memory_format_t fmt;
+    std::vector<int> dims;
+};
+
+/* offset_calc_t::off() must agree with memory_desc_wrapper::off_v() on every
+ * point, the double-blocked weights formats and the padded tails included */
+class offset_calc_test
+    : public ::testing::TestWithParam<offset_calc_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<offset_calc_params>::GetParam();
+        mkldnn_memory_desc_t md;
+        ASSERT_EQ(mkldnn_memory_desc_init(&md, (int)p.dims.size(),
+                    &p.dims[0], mkldnn_f32, p.fmt), mkldnn_success);
+
+        const impl::memory_desc_wrapper mdw(md);
+        const impl::offset_calc_t calc(mdw);
+        const int nd = (int)p.dims.size();
+
+        std::vector<int> pos(nd, 0);
+        impl::dims_t p_v, zero = { 0 };
+        for (;;) {
+            for (int d = 0; d < nd; ++d) p_v[d] = pos[d];
+            size_t off;
+            switch (nd) {
+            case 2: off = calc.off(pos[0], pos[1]); break;
+            case 4: off = calc.off(pos[0], pos[1], pos[2], pos[3]); break;
+            case 5: off = calc.off(pos[0], pos[1], pos[2], pos[3], pos[4]);
+                    break;
+            default: off = calc.off(pos[0], pos[1], pos[2], pos[3], pos[4],
+                             pos[5]);
+            }
+            ASSERT_EQ(mdw.off_v(p_v), off);
+
+            ptrdiff_t sum = 0;
+            for (int d = 0; d < nd; ++d) sum += calc.dim_off(d, pos[d]);
+            ASSERT_EQ((ptrdiff_t)off - (ptrdiff_t)mdw.off_v(zero), sum);
+
+            int d = nd - 1;
+            while (d >= 0 && ++pos[d] == p.dims[d]) pos[d--] = 0;
+            if (d < 0) break;
+        }
+    }
+};
+
+TEST_P(offset_calc_test, TestsOffsets) {}
+
+INSTANTIATE_TEST_CASE_P(TestOffsetCalc, offset_calc_test,
+        ::testing::Values(
+            offset_calc_params{ mkldnn_nc, {3, 5} },
+            offset_calc_params{ mkldnn_nchw, {2, 5, 3, 4} },
+            offset_calc_params{ mkldnn_nhwc, {2, 5, 3, 4} },
+            offset_calc_params{ mkldnn_nChw8c, {2, 13, 3, 4} },
+            offset_calc_params{ mkldnn_nChw16c, {2, 20, 3, 2} },
+            offset_calc_params{ mkldnn_nCdhw16c, {2, 20, 2, 3, 2} },
+            offset_calc_params{ mkldnn_oihw, {5, 3, 3, 3} },
+            offset_calc_params{ mkldnn_OIhw8i8o, {10, 12, 2, 3} },
+            offset_calc_params{ mkldnn_OIhw16i16o, {20, 18, 1, 3} },
+            offset_calc_params{ mkldnn_Ohwi16o, {20, 3, 2, 3} },
+            offset_calc_params{ mkldnn_OIhw4i16o4i, {20, 18, 2, 1} },
+            offset_calc_params{ mkldnn_OIhw8i16o2i, {17, 18, 1, 2} },
+            offset_calc_params{ mkldnn_OIhw8o16i2o, {18, 17, 1, 2} },
+            offset_calc_params{ mkldnn_gOIhw8i16o2i, {2, 16, 18, 1, 2} },
+            offset_calc_params{ mkldnn_OIdhw8i16o2i, {16, 18, 2, 1, 2} },
+            offset_calc_params{ mkldnn_goihw, {2, 3, 5, 2, 2} }));
+
+}
@@ -0,0 +1,161 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+#include "engine.hpp"
+#include "pd_cache.hpp"
+
+namespace mkldnn {
+
+/* only the virtual and inline members of the engine and of the cache are
+ * used: the library does not export the others */
+typedef mkldnn_engine::primitive_desc_create_f pd_create_f;
+
+static impl::pd_cache_t *pd_cache_of(const engine &eng) {
+    return eng.get()->pd_cache();
+}
+
+static memory::desc conv_md(memory::dims dims, memory::format f) {
+    return memory::desc(dims, memory::data_type::f32, f);
+}
+
+static convolution_forward::desc conv_desc(int mb) {
+    return convolution_forward::desc(prop_kind::forward_inference,
+            convolution_direct, conv_md({ mb, 8, 13, 13 }, memory::format::nchw),
+            conv_md({ 16, 8, 3, 3 }, memory::format::oihw),
+            conv_md({ 16 }, memory::format::x),
+            conv_md({ mb, 16, 11, 11 }, memory::format::nchw),
+            { 1, 1 }, { 0, 0 }, { 0, 0 }, padding_kind::zero);
+}
+
+/* creating a primitive descriptor for the same operation descriptor a second
+ * time is a cache hit and yields the same implementation */
+TEST(pd_cache_test, TestsRepeatedCreationHits) {
+    auto eng = engine(engine::kind::cpu, 0);
+    impl::pd_cache_t *cache = pd_cache_of(eng);
+    ASSERT_TRUE(cache != nullptr);
+    if (!cache->enabled()) return; /* MKLDNN_PD_CACHE_CAPACITY=0 */
+
+    const size_t hits0 = cache->hits(), misses0 = cache->misses();
+    auto pd1 = convolution_forward::primitive_desc(conv_desc(3), eng);
+    EXPECT_EQ(hits0, cache->hits());
+    EXPECT_EQ(misses0 + 1, cache->misses());
+
+    auto pd2 = convolution_forward::primitive_desc(conv_desc(3), eng);
+    EXPECT_EQ(hits0 + 1, cache->hits());
+    EXPECT_EQ(misses0 + 1, cache->misses());
+    EXPECT_NE(pd1.get(), pd2.get());
+    EXPECT_EQ(std::string(query_impl_info(pd1.get())),
+            std::string(query_impl_info(pd2.get())));
+
+    /* a different descriptor misses */
+    auto pd3 = convolution_forward::primitive_desc(conv_desc(4), eng);
+    EXPECT_EQ(hits0 + 1, cache->hits());
+    EXPECT_EQ(misses0 + 2, cache->misses());
+
+    /* the cached pd is a working one */
+    auto src = memory(pd2.src_primitive_desc());
+    auto wei = memory(pd2.weights_primitive_desc());
+    auto bia = memory(pd2.bias_primitive_desc());
+    auto dst = memory(pd2.dst_primitive_desc());
+    fill_data<float>(src.get_primitive_desc().get_size() / sizeof(float),
+            (float *)src.get_data_handle());
+    fill_data<float>(wei.get_primitive_desc().get_size() / sizeof(float),
+            (float *)wei.get_data_handle());
+    fill_data<float>(bia.get_primitive_desc().get_size() / sizeof(float),
+            (float *)bia.get_data_handle());
+    auto conv = convolution_forward(pd2, src, wei, bia, dst);
+    stream(stream::kind::eager).submit({ conv }).wait();
+}
+
+/* returns the first implementation of @p list that accepts @p op_desc */
+static pd_create_f first_impl(const pd_create_f *list, const void *op_desc,
+        const_mkldnn_primitive_attr_t attr, engine &eng,
+        std::string &impl_name) {
+    for (; *list; ++list) {
+        impl::primitive_desc_t *pd = nullptr;
+        if ((*list)(&pd, (const impl::op_desc_t *)op_desc, attr, eng.get(),
+                    nullptr) != impl::status::success)
+            continue;
+        impl_name = query_impl_info(pd);
+        mkldnn_primitive_desc_destroy(pd);
+        return *list;
+    }
+    return nullptr;
+}
+
+/* the kind-indexed list is the subsequence of the full list of one primitive
+ * kind: both select the same implementation */
+TEST(pd_cache_test, TestsKindListSelectsSameImplementation) {
+    auto eng = engine(engine::kind::cpu, 0);
+    mkldnn_primitive_attr_t attr;
+    ASSERT_EQ(mkldnn_primitive_attr_create(&attr), mkldnn_success);
+
+    auto data = conv_md({ 2, 16, 8, 8 }, memory::format::nchw);
+    auto conv = conv_desc(2);
+    auto relu = eltwise_forward::desc(prop_kind::forward_training,
+            algorithm::eltwise_relu, data, 0.f);
+    auto pool = pooling_forward::desc(prop_kind::forward_training,
+            algorithm::pooling_max, data,
+            conv_md({ 2, 16, 4, 4 }, memory::format::nchw), { 2, 2 },
+            { 2, 2 }, { 0, 0 }, { 0, 0 }, padding_kind::zero);
+    auto bnrm = batch_normalization_forward::desc(prop_kind::forward_training,
+            data, 1e-5f, 0u);
+    auto ip = inner_product_forward::desc(prop_kind::forward_training,
+            conv_md({ 2, 32 }, memory::format::nc),
+            conv_md({ 10, 32 }, memory::format::oi),
+            conv_md({ 2, 10 }, memory::format::nc));
+
+    const struct { mkldnn_primitive_kind_t kind; const void *op_desc; }
+    cases[] = {
+        { mkldnn_convolution, &conv.data },
+        { mkldnn_eltwise, &relu.data },
+        { mkldnn_pooling, &pool.data },
+        { mkldnn_batch_normalization, &bnrm.data },
+        { mkldnn_inner_product, &ip.data },
+    };
+
+    const pd_create_f *full = eng.get()->get_implementation_list();
+    for (const auto &c : cases) {
+        const pd_create_f *by_kind = eng.get()->get_kind_implementation_list(
+                (impl::primitive_kind_t)c.kind);
+
+        std::string name_full, name_kind;
+        pd_create_f f_full = first_impl(full, c.op_desc, attr, eng, name_full);
+        pd_create_f f_kind = first_impl(by_kind, c.op_desc, attr, eng,
+                name_kind);
+        ASSERT_TRUE(f_full != nullptr) << "kind " << c.kind;
+        EXPECT_EQ(f_full, f_kind) << "kind " << c.kind;
+        EXPECT_EQ(name_full, name_kind) << "kind " << c.kind;
+
+        /* every entry of the kind list appears in the full list, in order */
+        const pd_create_f *p = full;
+        for (const pd_create_f *k = by_kind; *k; ++k) {
+            while (*p && *p != *k) ++p;
+            ASSERT_TRUE(*p != nullptr) << "kind " << c.kind;
+            ++p;
+        }
+    }
+
+    mkldnn_primitive_attr_destroy(attr);
+}
+
+}
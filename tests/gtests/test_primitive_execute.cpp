@@ -0,0 +1,118 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+/* primitive::execute() runs a primitive on per-call data handles: the memory
+ * primitives keep their own buffers, and the same primitive can run from
+ * several threads at once on different buffers */
+class primitive_execute_test: public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        eng.reset(new engine(engine::kind::cpu, 0));
+        dims = {2, 13, 3, 4};
+        auto md = memory::desc(dims, memory::data_type::f32,
+                memory::format::nChw16c);
+        mpd.reset(new memory::primitive_desc(md, *eng));
+        n = mpd->get_size() / sizeof(float);
+
+        src.reset(new memory(*mpd));
+        dst.reset(new memory(*mpd));
+        auto relu_desc = eltwise_forward::desc(prop_kind::forward_inference,
+                algorithm::eltwise_relu, md, 0.f);
+        relu.reset(new eltwise_forward(
+                eltwise_forward::primitive_desc(relu_desc, *eng),
+                *src, *dst));
+    }
+
+    /* a zero-padded nChw16c buffer (C < 16: a single channel block) with
+     * values of both signs */
+    std::vector<float> make_src(int seed) const {
+        std::vector<float> buf(n, 0.f);
+        for (int i = 0; i < (int)n; ++i)
+            if (i % 16 < dims[1])
+                buf[i] = (float)((i * 7 + seed) % 11) - 5.f;
+        return buf;
+    }
+
+    void check_relu(const std::vector<float> &s, const std::vector<float> &d) {
+        for (size_t i = 0; i < n; ++i)
+            ASSERT_EQ(d[i], s[i] > 0.f ? s[i] : 0.f) << i;
+    }
+
+    std::shared_ptr<engine> eng;
+    memory::dims dims;
+    std::shared_ptr<memory::primitive_desc> mpd;
+    size_t n;
+    std::shared_ptr<memory> src, dst;
+    std::shared_ptr<eltwise_forward> relu;
+};
+
+TEST_F(primitive_execute_test, BindsHandles) {
+    void *own_src = src->get_data_handle(), *own_dst = dst->get_data_handle();
+    std::fill((float *)own_dst, (float *)own_dst + n, 42.f);
+
+    auto s = make_src(0);
+    std::vector<float> d(n, 0.f);
+    relu->execute({ {*src, &s[0]}, {*dst, &d[0]} });
+    check_relu(s, d);
+
+    EXPECT_EQ(src->get_data_handle(), own_src);
+    EXPECT_EQ(dst->get_data_handle(), own_dst);
+    for (size_t i = 0; i < n; ++i)
+        ASSERT_EQ(((float *)own_dst)[i], 42.f) << i;
+}
+
+TEST_F(primitive_execute_test, ConcurrentExecution) {
+    const int nthr = 4, niter = 20;
+    std::vector<std::vector<float>> s(nthr), d(nthr);
+    for (int t = 0; t < nthr; ++t) {
+        s[t] = make_src(t);
+        d[t].assign(n, 0.f);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthr; ++t)
+        threads.emplace_back([&, t]() {
+            for (int it = 0; it < niter; ++it)
+                relu->execute({ {*src, &s[t][0]}, {*dst, &d[t][0]} });
+        });
+    for (auto &th: threads) th.join();
+
+    for (int t = 0; t < nthr; ++t)
+        check_relu(s[t], d[t]);
+}
+
+TEST_F(primitive_execute_test, RejectsNonMemoryArgs) {
+    std::vector<float> d(n, 0.f);
+    bool thrown = false;
+    try {
+        relu->execute({ {*relu, &d[0]} });
+    } catch (const error &e) {
+        thrown = true;
+        EXPECT_EQ(e.status, mkldnn_invalid_arguments);
+    }
+    EXPECT_TRUE(thrown);
+}
+
+}
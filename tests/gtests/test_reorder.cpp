@@ -115,6 +115,7 @@ using reorder_padded_test_weights_f32_f32 = reorder_simple_test<f32_f32>;
 using reorder_3d_test_data_f32_f32 = reorder_simple_test<f32_f32>;
 using reorder_3d_test_weights_f32_f32 = reorder_simple_test<f32_f32>;
 using reorder_simple_test_data_f32_f32 = reorder_simple_test<f32_f32>;
+using reorder_transpose_test_f32_f32 = reorder_simple_test<f32_f32>;
 using reorder_simple_test_weights_f32_f32_0 = reorder_simple_test<f32_f32>;
 using reorder_simple_test_weights_f32_f32_1 = reorder_simple_test<f32_f32>;
 using reorder_simple_test_weights_f32_f32_IOhw16o16i = reorder_simple_test<f32_f32>;
@@ -277,6 +278,37 @@ INSTANTIATE_TEST_CASE_P(TestReorder, reorder_simple_test_data_f32_f32,
             )
         );
 
+/* odd sizes leave partial tiles on both sides of the transposed loops */
+TEST_P(reorder_transpose_test_f32_f32, TestsReorder) { }
+INSTANTIATE_TEST_CASE_P(TestReorder, reorder_transpose_test_f32_f32,
+        ::testing::Values(
+            cfg_f32{eng::cpu, fmt::nchw, fmt::nhwc, {3, 7, 5, 11}},
+            cfg_f32{eng::cpu, fmt::nhwc, fmt::nchw, {3, 7, 5, 11}},
+            cfg_f32{eng::cpu, fmt::nchw, fmt::nhwc, {2, 37, 17, 19}},
+            cfg_f32{eng::cpu, fmt::nhwc, fmt::nchw, {2, 37, 17, 19}},
+            cfg_f32{eng::cpu, fmt::nchw, fmt::nhwc, {1, 1, 9, 3}},
+            cfg_f32{eng::cpu, fmt::oihw, fmt::hwio, {33, 17, 3, 5}},
+            cfg_f32{eng::cpu, fmt::hwio, fmt::oihw, {33, 17, 3, 5}}
+            )
+        );
+
+#if defined(TARGET_VANILLA)
+/* without jit, a transposing reorder must go through the portable tiled
+ * implementation rather than the per element reference one */
+TEST(reorder_transpose, UsesTiledImplementation) {
+    auto eng = engine(engine::kind::cpu, 0);
+    for (auto f : { std::make_pair(fmt::nchw, fmt::nhwc),
+            std::make_pair(fmt::nhwc, fmt::nchw) }) {
+        auto mpd_i = memory::primitive_desc({ { 2, 37, 17, 19 },
+                memory::data_type::f32, f.first }, eng);
+        auto mpd_o = memory::primitive_desc({ { 2, 37, 17, 19 },
+                memory::data_type::f32, f.second }, eng);
+        auto r_pd = reorder::primitive_desc(mpd_i, mpd_o);
+        EXPECT_STREQ("simple:tr", query_impl_info(r_pd.get()));
+    }
+}
+#endif
+
 TEST_P(reorder_simple_test_weights_f32_f32_0, TestsReorder) { }
 INSTANTIATE_TEST_CASE_P(TestReorder, reorder_simple_test_weights_f32_f32_0,
         ::testing::Values(
@@ -398,4 +430,37 @@ INSTANTIATE_TEST_CASE_P(TestReorder, reorder_simple_test_s8_s8,
             )
         );
 #endif
+
+/* reorders with the same memory descriptors but different attributes must
+ * not share a cached primitive descriptor */
+TEST(reorder_pd_cache, AttrIsPartOfTheKey) {
+    auto eng = engine(engine::kind::cpu, 0);
+    memory::desc md_i({ 2, 16, 3, 3 }, memory::data_type::f32,
+            memory::format::nchw);
+    memory::desc md_o({ 2, 16, 3, 3 }, memory::data_type::f32,
+            memory::format::nhwc);
+    memory src({ md_i, eng }), dst({ md_o, eng });
+
+    const size_t nelems = 2 * 16 * 3 * 3;
+    float *s = (float *)src.get_data_handle();
+    float *d = (float *)dst.get_data_handle();
+    for (size_t i = 0; i < nelems; ++i)
+        s[i] = (float)(i % 13);
+
+    for (float scale : { 1.f, 2.f, 1.f, 3.f, 3.f }) {
+        primitive_attr attr;
+        attr.set_output_scales(0, { scale });
+        auto r_pd = reorder::primitive_desc(src.get_primitive_desc(),
+                dst.get_primitive_desc(), attr);
+        auto r = reorder(r_pd, src, dst);
+        stream(stream::kind::eager).submit({ r }).wait();
+
+        for (size_t i = 0; i < nelems; ++i) {
+            const float ref = scale * s[map_index(md_i, i, false)];
+            ASSERT_EQ(ref, d[map_index(md_o, i, false)])
+                << "scale " << scale << ", position " << i;
+        }
+    }
+}
+
 }
@@ -29,6 +29,7 @@ struct sum_test_params {
     std::vector<float> scale;
     bool expect_to_fail;
     mkldnn_status_t expected_status;
+    bool in_place; // dst is the first source
 };
 
 
@@ -154,34 +155,44 @@ protected:
 #endif
         auto dst_desc = memory::desc(p.dims, data_type, p.dst_format);
         auto sum_pd = sum::primitive_desc(dst_desc, p.scale, srcs_pd);
-        dst.reset(new memory(sum_pd.dst_primitive_desc()));
 
         ASSERT_EQ(sum_pd.dst_primitive_desc().desc().data.format,
                 dst_desc.data.format);
         ASSERT_EQ(sum_pd.dst_primitive_desc().desc().data.ndims,
                 dst_desc.data.ndims);
 
-        data_t *dst_data = (data_t *)dst->get_data_handle();
-        const size_t sz =
-            dst->get_primitive_desc().get_size() / sizeof(data_t);
-        // overwriting dst to prevent false positives for test cases.
-        OMP(parallel for)//;
-        for (ptrdiff_t i = 0; i < (ptrdiff_t)sz; i++) {
-            dst_data[i] = -32;
-        }
-
         std::vector<primitive::at> inputs;
         for (size_t i = 0; i < num_srcs; i++) {
             inputs.push_back(srcs[i]);
         }
 
+        std::vector<memory> ref_srcs = srcs;
+        if (p.in_place) {
+            /* keep a copy of the first source to check the result */
+            auto src0_copy = memory(srcs_pd[0]);
+            memcpy(src0_copy.get_data_handle(), srcs[0].get_data_handle(),
+                    srcs_pd[0].get_size());
+            ref_srcs[0] = src0_copy;
+            dst.reset(new memory(srcs[0]));
+        } else {
+            dst.reset(new memory(sum_pd.dst_primitive_desc()));
+            data_t *dst_data = (data_t *)dst->get_data_handle();
+            const size_t sz =
+                dst->get_primitive_desc().get_size() / sizeof(data_t);
+            // overwriting dst to prevent false positives for test cases.
+            OMP(parallel for)//;
+            for (ptrdiff_t i = 0; i < (ptrdiff_t)sz; i++) {
+                dst_data[i] = -32;
+            }
+        }
+
         auto c = sum(sum_pd, inputs, *dst);
         std::vector<primitive> pipeline;
         pipeline.push_back(c);
         auto s = stream(stream::kind::eager);
         s.submit(pipeline).wait();
 
-        check_data(srcs, p.scale, *dst);
+        check_data(ref_srcs, p.scale, *dst);
     }
 };
 
@@ -199,7 +210,14 @@ INSTANTIATE_TEST_CASE_P(TestSum, test, ::testing::Values( \
     {2, 8, 2, 2}, {1.0f, 1.0f}}, \
     sum_test_params{engine::kind::cpu, \
     {memory::format::nchw, memory::format::nchw}, memory::format::nchw, \
-    {2, 8, 2, 2}, {2.0f, 3.0f}} \
+    {2, 8, 2, 2}, {2.0f, 3.0f}}, \
+    sum_test_params{engine::kind::cpu, \
+    {memory::format::nchw, memory::format::nchw, memory::format::nchw}, \
+    memory::format::nchw, \
+    {2, 8, 2, 2}, {1.0f, 2.0f, 3.0f}}, \
+    sum_test_params{engine::kind::cpu, \
+    {memory::format::nchw, memory::format::nchw}, memory::format::nchw, \
+    {2, 8, 2, 2}, {1.0f, 3.0f}, false, mkldnn_success, true} \
 ));
 
 #define INST_TEST_CASE_JIT1(test) \
@@ -253,12 +271,20 @@ INSTANTIATE_TEST_CASE_P(TestSumJit2, test, ::testing::Values( \
     sum_test_params{engine::kind::cpu, \
     {memory::format::nChw16c, memory::format::nChw8c}, \
     memory::format::nChw16c, \
-    {2, 16, 3, 3}, {2.0f, 3.0f}} \
+    {2, 16, 3, 3}, {2.0f, 3.0f}}, \
+    sum_test_params{engine::kind::cpu, \
+    {memory::format::nChw8c, memory::format::nhwc, memory::format::nchw}, \
+    memory::format::nChw8c, \
+    {2, 16, 3, 5}, {2.0f, 3.0f, 1.0f}}, \
+    sum_test_params{engine::kind::cpu, \
+    {memory::format::nChw8c, memory::format::nchw}, memory::format::nChw8c, \
+    {2, 16, 3, 4}, {1.0f, 3.0f}, false, mkldnn_success, true} \
 ));
 
 using sum_test_float = sum_test<float,float>;
 using sum_test_u8 = sum_test<uint8_t,float>;
 using sum_test_s32 = sum_test<int32_t,float>;
+using sum_test_s8 = sum_test<int8_t,float>;
 
 //#if MKLDNN_JIT_TYPES > 0
 using sum_cc_f32 = sum_test<float,float>;
@@ -274,16 +300,17 @@ INSTANTIATE_TEST_CASE_P(TestSumCornerCases, sum_cc_f32, ::testing::Values(
 INST_TEST_CASE_NCHW(sum_test_float)
 INST_TEST_CASE_NCHW(sum_test_u8)
 INST_TEST_CASE_NCHW(sum_test_s32)
+INST_TEST_CASE_NCHW(sum_test_s8)
 
-#if MKLDNN_JIT_TYPES > 0
 INST_TEST_CASE_JIT1(sum_test_float)
 INST_TEST_CASE_JIT1(sum_test_u8)
 INST_TEST_CASE_JIT1(sum_test_s32)
+INST_TEST_CASE_JIT1(sum_test_s8)
 
 INST_TEST_CASE_JIT2(sum_test_float)
 INST_TEST_CASE_JIT2(sum_test_u8)
 INST_TEST_CASE_JIT2(sum_test_s32)
-#endif
+INST_TEST_CASE_JIT2(sum_test_s8)
 
 #undef INST_TEST_CASE_NCHW
 #undef INST_TEST_CASE_JIT1
@@ -0,0 +1,142 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+#include "primitive_desc.hpp"
+
+namespace mkldnn {
+
+/* tuning is read from the environment once per process: it is switched on
+ * before main() for the whole binary */
+static const char *tuning_db_path = "test_tuning_db.txt";
+
+static bool set_tuning_env() {
+    remove(tuning_db_path);
+#ifdef _WIN32
+    return _putenv_s("MKLDNN_TUNING", "1") == 0
+        && _putenv_s("MKLDNN_TUNING_DB", tuning_db_path) == 0;
+#else
+    return setenv("MKLDNN_TUNING", "1", 1) == 0
+        && setenv("MKLDNN_TUNING_DB", tuning_db_path, 1) == 0;
+#endif
+}
+static const bool tuning_env_set = set_tuning_env();
+
+static convolution_forward::desc conv_desc(int ic) {
+    auto md = [](memory::dims dims, memory::format f) {
+        return memory::desc(dims, memory::data_type::f32, f);
+    };
+    return convolution_forward::desc(prop_kind::forward_inference,
+            convolution_direct, md({ 2, ic, 9, 9 }, memory::format::nchw),
+            md({ 8, ic, 3, 3 }, memory::format::oihw),
+            md({ 2, 8, 7, 7 }, memory::format::nchw),
+            { 1, 1 }, { 0, 0 }, { 0, 0 }, padding_kind::zero);
+}
+
+/* the database key of a problem: the verbose info() of its first candidate
+ * without the implementation name. The iterator does not tune, so it
+ * enumerates the candidates without touching the database */
+static std::string candidates(const convolution_forward::desc &d,
+        const engine &eng, std::vector<std::string> &names) {
+    mkldnn_primitive_desc_iterator_t it;
+    EXPECT_EQ(mkldnn_primitive_desc_iterator_create(&it, &d.data, eng.get(),
+                nullptr), mkldnn_success);
+    std::string key;
+    do {
+        mkldnn_primitive_desc_t pd = mkldnn_primitive_desc_iterator_fetch(it);
+        const std::string info
+            = ((const impl::primitive_desc_t *)pd)->info();
+        names.push_back(query_impl_info(pd));
+        if (key.empty()) {
+            const size_t b = info.find(','), e = info.find(',', b + 1);
+            key = info.substr(0, b) + info.substr(e);
+        }
+        mkldnn_primitive_desc_destroy(pd);
+    } while (mkldnn_primitive_desc_iterator_next(it) == mkldnn_success);
+    mkldnn_primitive_desc_iterator_destroy(it);
+    return key;
+}
+
+static std::string created_impl(const convolution_forward::desc &d) {
+    auto eng = engine(engine::kind::cpu, 0); /* an engine with a cold pd cache */
+    auto pd = convolution_forward::primitive_desc(d, eng);
+    return query_impl_info(pd.get());
+}
+
+/* a decision found in the database selects its implementation, and a new
+ * decision is appended to the database in the same format */
+TEST(tuning_test, TestsDatabaseRoundTrip) {
+    ASSERT_TRUE(tuning_env_set);
+    auto eng = engine(engine::kind::cpu, 0);
+
+    /* read: the database is loaded on the first tuned creation, the
+     * malformed line is skipped and the last candidate, which plain creation
+     * would never choose, wins */
+    std::vector<std::string> names_seed;
+    const std::string key_seed = candidates(conv_desc(3), eng, names_seed);
+    if (names_seed.size() < 2) return; /* nothing to choose from */
+    {
+        std::ofstream db(tuning_db_path);
+        db << "no tab on this line\n";
+        db << key_seed << "\t" << names_seed.front() << "\n";
+        db << key_seed << "\t" << names_seed.back() << "\n";
+    }
+    EXPECT_EQ(names_seed.back(), created_impl(conv_desc(3)));
+
+    /* write: a problem without a decision is timed and recorded */
+    std::vector<std::string> names_new;
+    const std::string key_new = candidates(conv_desc(5), eng, names_new);
+    const std::string impl_new = created_impl(conv_desc(5));
+    EXPECT_NE(names_new.end(),
+            std::find(names_new.begin(), names_new.end(), impl_new));
+
+    std::ifstream db(tuning_db_path);
+    std::string line, recorded;
+    int n_recorded = 0;
+    while (std::getline(db, line)) {
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.substr(0, tab) != key_new)
+            continue;
+        recorded = line.substr(tab + 1);
+        ++n_recorded;
+    }
+    EXPECT_EQ(1, n_recorded);
+    EXPECT_EQ(impl_new, recorded);
+
+    /* the recorded decision is reused rather than timed again */
+    db.close();
+    EXPECT_EQ(impl_new, created_impl(conv_desc(5)));
+    db.open(tuning_db_path);
+    int n_lines = 0;
+    while (std::getline(db, line)) ++n_lines;
+    EXPECT_EQ(4, n_lines);
+    db.close();
+
+    remove(tuning_db_path);
+}
+
+}
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <dlfcn.h>
+#endif
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+
+#if defined(__linux__)
+/* counts the aligned allocations of the library (impl::malloc). The tests
+ * are built with hidden visibility: the interposer has to be exported */
+static std::atomic<int> n_posix_memalign(0);
+
+extern "C" __attribute__((visibility("default")))
+int posix_memalign(void **ptr, size_t alignment, size_t size) {
+    typedef int (*posix_memalign_t)(void **, size_t, size_t);
+    static posix_memalign_t real_posix_memalign
+        = (posix_memalign_t)dlsym(RTLD_NEXT, "posix_memalign");
+    ++n_posix_memalign;
+    return real_posix_memalign(ptr, alignment, size);
+}
+#endif
+
+namespace mkldnn {
+
+/* once warm, repeated executions take their gemm k-splitting and copy
+ * workspaces from the pool and do not allocate at all. The bf16 inner
+ * product always goes through ref_gemm, whatever BLAS sgemm uses */
+TEST(ws_pool_test, TestsGemmSteadyStateAllocations) {
+#if defined(__linux__)
+    const int MB = 64, IC = 512, OC = 384;
+    auto eng = engine(engine::kind::cpu, 0);
+    auto f32 = memory::data_type::f32, bf16 = memory::data_type::bf16;
+
+    auto src = memory({{{{MB, IC}}, f32, memory::format::nc}, eng});
+    auto wei = memory({{{{OC, IC}}, f32, memory::format::oi}, eng});
+    auto dst = memory({{{{MB, OC}}, f32, memory::format::nc}, eng});
+    auto src_bf = memory({{{{MB, IC}}, bf16, memory::format::nc}, eng});
+    auto wei_bf = memory({{{{OC, IC}}, bf16, memory::format::oi}, eng});
+    float *s = (float *)src.get_data_handle();
+    float *w = (float *)wei.get_data_handle();
+    for (int i = 0; i < MB * IC; ++i) s[i] = 1.f;
+    for (int i = 0; i < OC * IC; ++i) w[i] = i % 2 ? 0.5f : -0.25f;
+    stream(stream::kind::eager).submit({reorder(src, src_bf),
+            reorder(wei, wei_bf)}).wait();
+
+    auto pd = inner_product_forward::primitive_desc(
+            inner_product_forward::desc(prop_kind::forward_inference,
+                src_bf.get_primitive_desc().desc(),
+                wei_bf.get_primitive_desc().desc(),
+                dst.get_primitive_desc().desc()), eng);
+    auto ip = inner_product_forward(pd, src_bf, wei_bf, dst);
+    stream strm(stream::kind::eager);
+
+    n_posix_memalign = 0;
+    strm.submit({ip}).wait();
+    EXPECT_GT(n_posix_memalign, 0);
+
+    n_posix_memalign = 0;
+    for (int i = 0; i < 10; ++i) strm.rerun().wait();
+    EXPECT_EQ(n_posix_memalign, 0);
+
+    const float *d = (const float *)dst.get_data_handle();
+    for (int i = 0; i < MB * OC; ++i) ASSERT_EQ(d[i], IC * 0.125f);
+#endif
+}
+
+}
@@ -0,0 +1,58 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "utils.hpp"
+#include "ws_pool.hpp"
+
+namespace mkldnn {
+
+using impl::ws_pool_t;
+
+/* a buffer given back that does not come from get() must not be accounted
+ * as idle, or the eviction would later free it twice */
+TEST(ws_pool_unit_test, TestsUnknownBufferAndEviction) {
+    const size_t page = ws_pool_t::alignment;
+    ws_pool_t pool(2 * page);
+
+    void *a = pool.get(page), *b = pool.get(page), *c = pool.get(page);
+    ASSERT_TRUE(a != nullptr && b != nullptr && c != nullptr);
+    EXPECT_EQ(pool.misses(), 3u);
+
+    pool.put(impl::malloc(page, page));
+    EXPECT_EQ(pool.idle_bytes(), 0u);
+
+    pool.put(a);
+    pool.put(b);
+    EXPECT_EQ(pool.idle_bytes(), 2 * page);
+    pool.put(c); /* over capacity: freed */
+    EXPECT_EQ(pool.idle_bytes(), 2 * page);
+
+    void *d = pool.get(page);
+    EXPECT_TRUE(d == a || d == b);
+    EXPECT_EQ(pool.hits(), 1u);
+    EXPECT_EQ(pool.idle_bytes(), page);
+
+    pool.put(impl::malloc(2 * page, page));
+    pool.put(d);
+    EXPECT_EQ(pool.idle_bytes(), 2 * page);
+
+    pool.trim();
+    EXPECT_EQ(pool.idle_bytes(), 0u);
+}
+
+}
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright 2018 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "mkldnn_test_common.hpp"
+
+#include "mkldnn.hpp"
+#include "memory_desc_wrapper.hpp"
+
+namespace mkldnn {
+
+struct zero_pad_params {
+    memory::format fmt; /* blocked: see outer_blocked_md() */
+    memory::format plain_fmt;
+    memory::dims dims;
+};
+
+/* Oihw8o like layout that only the generic kernel handles: the outer
+ * dimension is blocked by 8, the others are plain */
+static mkldnn_memory_desc_t outer_blocked_md(const memory::dims &dims) {
+    const int nd = (int)dims.size(), blk = 8;
+    mkldnn_memory_desc_t md;
+    memset(&md, 0, sizeof(md));
+    md.primitive_kind = mkldnn_memory;
+    md.ndims = nd;
+    md.data_type = mkldnn_f32;
+    md.format = mkldnn_blocked;
+    auto &b = md.layout_desc.blocking;
+    ptrdiff_t stride = blk;
+    for (int d = nd - 1; d >= 0; --d) {
+        md.dims[d] = dims[d];
+        b.block_dims[d] = d == 0 ? blk : 1;
+        b.padding_dims[d] = d == 0 ? (dims[d] + blk - 1) / blk * blk : dims[d];
+        b.strides[1][d] = 1;
+        b.strides[0][d] = stride;
+        stride *= b.padding_dims[d] / b.block_dims[d];
+    }
+    return md;
+}
+
+/* asserts that @p mem has some padding and that all of it is zero */
+static void check_zero_padding(const memory &mem) {
+    const auto md = mem.get_primitive_desc().desc().data;
+    const impl::memory_desc_wrapper mdw(md);
+    const float *buf = (const float *)mem.get_data_handle();
+    const int nd = md.ndims;
+    const auto &pdims = mdw.blocking_desc().padding_dims;
+    std::vector<int> pos(nd, 0);
+    impl::dims_t p_v;
+    int n_padded = 0;
+    for (;;) {
+        bool padded = false;
+        for (int d = 0; d < nd; ++d) {
+            p_v[d] = pos[d];
+            padded = padded || pos[d] >= md.dims[d];
+        }
+        if (padded) {
+            ASSERT_EQ(buf[mdw.off_v(p_v)], 0.f);
+            ++n_padded;
+        }
+
+        int d = nd - 1;
+        while (d >= 0 && ++pos[d] == pdims[d]) pos[d--] = 0;
+        if (d < 0) break;
+    }
+    ASSERT_GT(n_padded, 0);
+}
+
+/* the padding of a garbage filled buffer is zeroed before the first primitive
+ * that uses the memory, by the specialized kernels (nChw16c, OIhw16i16o) and
+ * by the generic one alike */
+class zero_pad_test: public ::testing::TestWithParam<zero_pad_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<zero_pad_params>::GetParam();
+        auto eng = engine(engine::kind::cpu, 0);
+        auto mpd = p.fmt == memory::format::blocked
+            ? memory::primitive_desc(memory::desc(outer_blocked_md(p.dims)),
+                    eng)
+            : memory::primitive_desc({p.dims, memory::data_type::f32, p.fmt},
+                    eng);
+        auto plain_mpd = memory::primitive_desc({p.dims,
+                memory::data_type::f32, p.plain_fmt}, eng);
+
+        const size_t size = mpd.get_size();
+        std::vector<float> buf(size / sizeof(float));
+        memset(&buf[0], 0xff, size);
+
+        auto mem = memory(mpd, &buf[0]);
+        auto plain = memory(plain_mpd);
+        stream(stream::kind::eager).submit({reorder(mem, plain)}).wait();
+
+        check_zero_padding(mem);
+    }
+};
+
+TEST_P(zero_pad_test, TestsZeroPadding) {}
+
+INSTANTIATE_TEST_CASE_P(TestZeroPad, zero_pad_test,
+        ::testing::Values(
+            zero_pad_params{ memory::format::nChw16c, memory::format::nchw,
+                {2, 13, 3, 4} },
+            zero_pad_params{ memory::format::OIhw16i16o, memory::format::oihw,
+                {20, 18, 1, 3} },
+            zero_pad_params{ memory::format::blocked, memory::format::oihw,
+                {13, 3, 2, 2} },
+            zero_pad_params{ memory::format::blocked, memory::format::nc,
+                {21, 5} }));
+
+/* the gemm inner product computes the padded input channels too: a NaN in
+ * diff_dst makes its backward passes write NaNs into the padding of diff_src
+ * and diff_weights, which must be zero again when the next primitive reads
+ * them */
+TEST(zero_pad_dirty_test, TestsInnerProductBackward) {
+    auto eng = engine(engine::kind::cpu, 0);
+    const auto f32 = memory::data_type::f32;
+    const memory::dims src_dims = {2, 12, 3, 3}, wei_dims = {10, 12, 3, 3};
+    auto src_md = memory::desc(src_dims, f32, memory::format::nChw8c);
+    auto wei_md = memory::desc(wei_dims, f32, memory::format::oIhw8i);
+    auto dst_md = memory::desc({2, 10}, f32, memory::format::nc);
+
+    auto fwd_pd = inner_product_forward::primitive_desc(
+            {prop_kind::forward_training, src_md, wei_md, dst_md}, eng);
+    auto bwd_d_pd = inner_product_backward_data::primitive_desc(
+            {src_md, wei_md, dst_md}, eng, fwd_pd);
+    auto bwd_w_pd = inner_product_backward_weights::primitive_desc(
+            {src_md, wei_md, dst_md}, eng, fwd_pd);
+
+    auto src = memory({src_md, eng}), wei = memory({wei_md, eng});
+    auto diff_dst = memory({dst_md, eng});
+    auto diff_src = memory({src_md, eng}), diff_wei = memory({wei_md, eng});
+    fill_data<float>(src.get_primitive_desc().get_size() / sizeof(float),
+            (float *)src.get_data_handle());
+    fill_data<float>(wei.get_primitive_desc().get_size() / sizeof(float),
+            (float *)wei.get_data_handle());
+    fill_data<float>(diff_dst.get_primitive_desc().get_size() / sizeof(float),
+            (float *)diff_dst.get_data_handle());
+    ((float *)diff_dst.get_data_handle())[0] = NAN;
+
+    auto plain_src = memory({{src_dims, f32, memory::format::nchw}, eng});
+    auto plain_wei = memory({{wei_dims, f32, memory::format::oihw}, eng});
+    stream(stream::kind::eager).submit({
+            inner_product_backward_data(bwd_d_pd, diff_dst, wei, diff_src),
+            inner_product_backward_weights(bwd_w_pd, src, diff_dst, diff_wei),
+            reorder(diff_src, plain_src), reorder(diff_wei, plain_wei)})
+        .wait();
+    check_zero_padding(diff_src);
+    check_zero_padding(diff_wei);
+}
+
+}